@@ -6,6 +6,7 @@ layout (location = 2) in vec2 aTexCoords;
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
+out float ViewDepth; // Positive distance along the view axis, selects the light cluster slice
 
 uniform mat4 model;
 uniform mat4 view;
@@ -17,5 +18,7 @@ void main()
    Normal = normalize(mat3(transpose(inverse(model))) * aNormal);
    TexCoords = aTexCoords;
 
-   gl_Position = projection * view * vec4(FragPos, 1.0); // is read right to left
+   vec4 ViewPos = view * vec4(FragPos, 1.0);
+   ViewDepth = -ViewPos.z;
+   gl_Position = projection * ViewPos; // is read right to left
 }
\ No newline at end of file
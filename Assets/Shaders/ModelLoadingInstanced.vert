@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 7) in mat4 aInstanceModel; // occupies locations 7-10
+
+out vec2 TexCoords;
+
+layout (std140) uniform CameraData
+{
+    mat4 u_Projection;
+    mat4 u_View;
+};
+
+void main()
+{
+    TexCoords = aTexCoords;
+    gl_Position = u_Projection * u_View * aInstanceModel * vec4(aPos, 1.0);
+}
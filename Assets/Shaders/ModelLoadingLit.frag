@@ -0,0 +1,138 @@
+#version 330 core
+// OIT_OUTPUT: weighted-blended OIT variant (McGuire & Bavoil 2013), single blend function for GL 3.3,
+// blended with glBlendFuncSeparate(ONE, ONE, ZERO, ONE_MINUS_SRC_ALPHA). Same lighting either way
+#ifdef OIT_OUTPUT
+layout (location = 0) out vec4 Accumulation; // rgb = sum(color * alpha * w), a = product(1 - alpha)
+layout (location = 1) out float Weight;      // sum(alpha * w)
+#else
+out vec4 FragColor;
+#endif
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoords;
+in float ViewDepth;
+
+uniform sampler2D texture_diffuse1;
+uniform sampler2D texture_specular1;
+uniform float u_Shininess = 32.0;
+
+struct S_DirectionalLight
+{
+   vec3 Direction;
+   vec3 Ambient;
+   vec3 Diffuse;
+   vec3 Specular;
+};
+
+uniform vec3 ViewPos;
+uniform S_DirectionalLight DirLight;
+
+// Clustered lights, built by JClusteredLighting
+uniform samplerBuffer u_LightData;     // 4 texels per light: pos/range, color/type, direction/inner cos, outer cos
+uniform usamplerBuffer u_ClusterGrid;  // (offset, count) into u_LightIndices per cluster
+uniform usamplerBuffer u_LightIndices;
+uniform vec3 u_GridSize;
+uniform vec2 u_TileSize;
+uniform float u_ClusterScale;
+uniform float u_ClusterBias;
+
+// Directional cascaded shadows, rendered by JCascadedShadows
+uniform sampler2DArrayShadow u_ShadowMap;
+uniform mat4 u_CascadeMatrices[4];
+uniform vec4 u_CascadeSplits; // far view depth of each cascade
+uniform int u_ShadowsEnabled;
+
+float CalcShadow(vec3 N, vec3 L)
+{
+   if (u_ShadowsEnabled == 0 || ViewDepth > u_CascadeSplits.w) return 1.0;
+
+   int Cascade = 0;
+   while (Cascade < 3 && ViewDepth > u_CascadeSplits[Cascade]) Cascade++;
+
+   // Normal offset grows at grazing angles and with the cascade's texel size
+   float NdotL = clamp(dot(N, L), 0.0, 1.0);
+   vec3 OffsetPos = FragPos + N * (0.02 * float(Cascade + 1) * (1.0 - NdotL));
+   vec4 LightSpace = u_CascadeMatrices[Cascade] * vec4(OffsetPos, 1.0);
+   vec3 Coords = LightSpace.xyz / LightSpace.w * 0.5 + 0.5;
+   if (Coords.z > 1.0) return 1.0;
+
+   // 3x3 PCF on top of the hardware 2x2 comparison
+   vec2 Texel = 1.0 / vec2(textureSize(u_ShadowMap, 0).xy);
+   float Lit = 0.0;
+   for (int x = -1; x <= 1; x++)
+      for (int y = -1; y <= 1; y++)
+         Lit += texture(u_ShadowMap, vec4(Coords.xy + vec2(x, y) * Texel, float(Cascade), Coords.z - 0.0005));
+   return Lit / 9.0;
+}
+
+vec3 CalcDirLight(vec3 N, vec3 V, vec3 Albedo, vec3 SpecularColor)
+{
+   vec3 L = normalize(-DirLight.Direction);
+   vec3 H = normalize(L + V);
+   float fDiffuse = max(dot(N, L), 0.0);
+   float fSpecular = pow(max(dot(N, H), 0.0), u_Shininess);
+   float Shadow = CalcShadow(N, L);
+   return DirLight.Ambient * Albedo + Shadow * (DirLight.Diffuse * fDiffuse * Albedo + DirLight.Specular * fSpecular * SpecularColor);
+}
+
+vec3 CalcClusteredLight(int Index, vec3 N, vec3 V, vec3 Albedo, vec3 SpecularColor)
+{
+   vec4 PositionRange = texelFetch(u_LightData, Index * 4);
+   vec4 ColorType = texelFetch(u_LightData, Index * 4 + 1);
+
+   vec3 L = PositionRange.xyz - FragPos;
+   float Distance = length(L);
+   if (Distance >= PositionRange.w) return vec3(0.0);
+   L /= Distance;
+
+   // Inverse square falloff, windowed to reach exactly zero at the light's range
+   float Ratio = Distance / PositionRange.w;
+   float Window = clamp(1.0 - Ratio * Ratio * Ratio * Ratio, 0.0, 1.0);
+   float Attenuation = Window * Window / (1.0 + Distance * Distance);
+
+   if (ColorType.w > 0.5)
+   {
+      vec4 DirectionInner = texelFetch(u_LightData, Index * 4 + 2);
+      float OuterCutOff = texelFetch(u_LightData, Index * 4 + 3).x;
+      float Theta = dot(-L, DirectionInner.xyz);
+      Attenuation *= clamp((Theta - OuterCutOff) / max(DirectionInner.w - OuterCutOff, 1e-4), 0.0, 1.0);
+   }
+
+   vec3 H = normalize(L + V);
+   float fDiffuse = max(dot(N, L), 0.0);
+   float fSpecular = pow(max(dot(N, H), 0.0), u_Shininess);
+   return ColorType.rgb * Attenuation * (fDiffuse * Albedo + fSpecular * SpecularColor);
+}
+
+void main()
+{
+   vec4 Albedo = texture(texture_diffuse1, TexCoords);
+   vec3 SpecularColor = texture(texture_specular1, TexCoords).rgb;
+   vec3 N = normalize(Normal);
+   vec3 V = normalize(ViewPos - FragPos);
+
+   vec3 Result = CalcDirLight(N, V, Albedo.rgb, SpecularColor);
+
+   // Only the lights assigned to this fragment's cluster
+   ivec3 Grid = ivec3(u_GridSize);
+   ivec2 Tile = min(ivec2(gl_FragCoord.xy / u_TileSize), Grid.xy - 1);
+   int Slice = clamp(int(log(max(ViewDepth, 1e-4)) * u_ClusterScale + u_ClusterBias), 0, Grid.z - 1);
+   int Cluster = Tile.x + Tile.y * Grid.x + Slice * Grid.x * Grid.y;
+
+   uvec2 OffsetCount = texelFetch(u_ClusterGrid, Cluster).xy;
+   for (uint i = 0u; i < OffsetCount.y; i++)
+   {
+      int LightIndex = int(texelFetch(u_LightIndices, int(OffsetCount.x + i)).r);
+      Result += CalcClusteredLight(LightIndex, N, V, Albedo.rgb, SpecularColor);
+   }
+
+#ifdef OIT_OUTPUT
+   // Favor surfaces close to the camera so they dominate the average
+   float w = clamp(Albedo.a * max(1e-2, 3e3 * pow(1.0 - gl_FragCoord.z, 3.0)), 1e-2, 3e3);
+   Accumulation = vec4(Result * Albedo.a * w, Albedo.a);
+   Weight = Albedo.a * w;
+#else
+   FragColor = vec4(Result, Albedo.a);
+#endif
+}
@@ -0,0 +1,29 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+out float ViewDepth; // Positive distance along the view axis, selects the light cluster slice
+
+layout (std140) uniform CameraData
+{
+    mat4 u_Projection;
+    mat4 u_View;
+};
+uniform mat4 u_Model;
+
+void main()
+{
+    vec4 worldPos = u_Model * vec4(aPos, 1.0);
+    vec4 viewPos = u_View * worldPos;
+
+    FragPos = worldPos.xyz;
+    Normal = mat3(transpose(inverse(u_Model))) * aNormal;
+    TexCoords = aTexCoords;
+    ViewDepth = -viewPos.z;
+
+    gl_Position = u_Projection * viewPos;
+}
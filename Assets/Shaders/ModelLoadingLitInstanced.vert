@@ -0,0 +1,29 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 7) in mat4 aInstanceModel; // occupies locations 7-10
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+out float ViewDepth; // Positive distance along the view axis, selects the light cluster slice
+
+layout (std140) uniform CameraData
+{
+    mat4 u_Projection;
+    mat4 u_View;
+};
+
+void main()
+{
+    vec4 worldPos = aInstanceModel * vec4(aPos, 1.0);
+    vec4 viewPos = u_View * worldPos;
+
+    FragPos = worldPos.xyz;
+    Normal = mat3(transpose(inverse(aInstanceModel))) * aNormal;
+    TexCoords = aTexCoords;
+    ViewDepth = -viewPos.z;
+
+    gl_Position = u_Projection * viewPos;
+}
@@ -0,0 +1,22 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture; // Accumulation: rgb = weighted premultiplied color, a = revealage
+uniform sampler2D weightTexture; // Sum of weights
+
+void main()
+{
+    vec4 accumulation = texture(screenTexture, TexCoords);
+    float revealage = accumulation.a;
+
+    // Nothing transparent covers this pixel
+    if (revealage >= 1.0) discard;
+
+    float weight = texture(weightTexture, TexCoords).r;
+    vec3 average = accumulation.rgb / clamp(weight, 1e-4, 5e4);
+
+    // Blended over the opaque scene with SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+    FragColor = vec4(average, 1.0 - revealage);
+}
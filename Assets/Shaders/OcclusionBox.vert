@@ -0,0 +1,16 @@
+#version 330 core
+layout (location = 0) in vec3 aPos; // unit cube corner, [-0.5, 0.5]
+
+layout (std140) uniform CameraData
+{
+    mat4 u_Projection;
+    mat4 u_View;
+};
+
+uniform vec3 u_BoxCenter;
+uniform vec3 u_BoxSize;
+
+void main()
+{
+    gl_Position = u_Projection * u_View * vec4(u_BoxCenter + aPos * u_BoxSize, 1.0);
+}
@@ -0,0 +1,32 @@
+#version 330 core
+out vec2 Seed;
+
+uniform sampler2D screenTexture; // Nearest seed of every texel from the previous pass, -1 if none
+uniform int u_Step;
+
+void main()
+{
+    ivec2 size = textureSize(screenTexture, 0);
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+
+    vec2 best = vec2(-1.0);
+    float bestDistance = 1e20;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            ivec2 neighbor = clamp(texel + ivec2(x, y) * u_Step, ivec2(0), size - 1);
+            vec2 seed = texelFetch(screenTexture, neighbor, 0).xy;
+            if (seed.x < 0.0) continue;
+
+            vec2 delta = seed - gl_FragCoord.xy;
+            float distanceSq = dot(delta, delta);
+            if (distanceSq < bestDistance)
+            {
+                bestDistance = distanceSq;
+                best = seed;
+            }
+        }
+    }
+    Seed = best;
+}
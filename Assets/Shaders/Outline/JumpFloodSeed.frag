@@ -0,0 +1,13 @@
+#version 330 core
+out vec2 Seed;
+
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture; // Full-resolution outline mask
+
+void main()
+{
+    // Linear filtering covers the 2x2 full-resolution texels under this reduced-resolution texel
+    float coverage = texture(screenTexture, TexCoords).r;
+    Seed = coverage > 0.0 ? gl_FragCoord.xy : vec2(-1.0);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture; // Full-resolution outline mask
+uniform sampler2D seedTexture;   // Jump-flood result at reduced resolution
+uniform float u_Scale;           // Reduced / full resolution
+uniform float u_Width;           // Outline width in full-resolution pixels
+uniform vec3 u_Color;
+
+void main()
+{
+    // The outline surrounds the silhouette, the actor itself stays untouched
+    if (texture(screenTexture, TexCoords).r > 0.0) discard;
+
+    vec2 position = gl_FragCoord.xy * u_Scale;
+    vec2 seed = texelFetch(seedTexture, ivec2(position), 0).xy;
+    if (seed.x < 0.0) discard;
+
+    float distance = length(seed - position) / u_Scale;
+    float alpha = clamp(u_Width - distance + 0.5, 0.0, 1.0);
+    if (alpha <= 0.0) discard;
+
+    FragColor = vec4(u_Color, alpha);
+}
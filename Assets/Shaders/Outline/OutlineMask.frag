@@ -0,0 +1,8 @@
+#version 330 core
+out float Mask;
+
+void main()
+{
+    // Only reached where the stencil test passed, i.e. on outlined actors
+    Mask = 1.0;
+}
@@ -4,6 +4,7 @@ out vec4 FragColor;
 in vec3 Normal;
 in vec3 FragPos;
 in vec2 TexCoords;
+in float ViewDepth;
 
 struct S_Material
 {
@@ -21,41 +22,21 @@ struct S_DirectionalLight
    vec3 Specular;
 };
 
-struct S_PointLight
-{
-   vec3 Position;
-   vec3 Ambient;
-   vec3 Diffuse;
-   vec3 Specular;
-   float Constant;
-   float Linear;
-   float Quadratic;
-};
-
-struct S_SpotLight
-{
-   vec3 Position;
-   vec3 Direction;
-   float InnerCutOff;
-   float OuterCutOff;
-   float Constant;
-   float Linear;
-   float Quadratic;
-   vec3 Ambient;
-   vec3 Diffuse;
-   vec3 Specular;
-};
-
 vec3 CalcDirLight(S_DirectionalLight Light, vec3 Normal, vec3 ViewDir);
-vec3 CalcPointLight(S_PointLight Light, vec3 Normal, vec3 FragPos, vec3 ViewDir);
-vec3 CalcSpotLight(S_SpotLight Light, vec3 Normal, vec3 FragPos, vec3 ViewDir);
+vec3 CalcClusteredLight(int Index, vec3 Normal, vec3 FragPos, vec3 ViewDir);
 
 uniform vec3 ViewPos;
 uniform S_Material Material;
 uniform S_DirectionalLight DirLight;
-#define NR_POINT_LIGHTS 4
-uniform S_PointLight PointLights[NR_POINT_LIGHTS];
-uniform S_SpotLight SpotLight;
+
+// Clustered point and spot lights, built by JClusteredLighting
+uniform samplerBuffer u_LightData;     // 4 texels per light: pos/range, color/type, direction/inner cos, outer cos
+uniform usamplerBuffer u_ClusterGrid;  // (offset, count) into u_LightIndices per cluster
+uniform usamplerBuffer u_LightIndices;
+uniform vec3 u_GridSize;
+uniform vec2 u_TileSize;
+uniform float u_ClusterScale;
+uniform float u_ClusterBias;
 
 void main()
 {
@@ -65,10 +46,15 @@ void main()
 
    vec3 Result = CalcDirLight(DirLight, Normal, ViewDir);
 
-   for(int i = 0; i < NR_POINT_LIGHTS; i++)
-      Result += CalcPointLight(PointLights[i], Normal, FragPos, ViewDir);
+   // Only the lights assigned to this fragment's cluster
+   ivec3 Grid = ivec3(u_GridSize);
+   ivec2 Tile = min(ivec2(gl_FragCoord.xy / u_TileSize), Grid.xy - 1);
+   int Slice = clamp(int(log(max(ViewDepth, 1e-4)) * u_ClusterScale + u_ClusterBias), 0, Grid.z - 1);
+   int Cluster = Tile.x + Tile.y * Grid.x + Slice * Grid.x * Grid.y;
 
-   Result += CalcSpotLight(SpotLight, Normal, FragPos, ViewDir);
+   uvec2 OffsetCount = texelFetch(u_ClusterGrid, Cluster).xy;
+   for (uint i = 0u; i < OffsetCount.y; i++)
+      Result += CalcClusteredLight(int(texelFetch(u_LightIndices, int(OffsetCount.x + i)).r), Normal, FragPos, ViewDir);
 
    FragColor = vec4(Result + Emission, 1.f);
 }
@@ -86,42 +72,35 @@ vec3 CalcDirLight(S_DirectionalLight Light, vec3 Normal, vec3 ViewDir)
    return (ambient + diffuse + specular);
 }
 
-vec3 CalcPointLight(S_PointLight Light, vec3 Normal, vec3 FragPos, vec3 ViewDir)
+vec3 CalcClusteredLight(int Index, vec3 Normal, vec3 FragPos, vec3 ViewDir)
 {
-   vec3 LightDir = normalize(Light.Position - FragPos);
-   vec3 ReflectDir = reflect(-LightDir, Normal);
-   float fDiffuse = max(dot(LightDir, Normal), 0.f);
-   float fSpecular = pow(max(dot(ViewDir, ReflectDir), 0.f), Material.Shininess);
-   float Distance = length(Light.Position - FragPos);
-   float Attenuation = 1.0 / (Light.Constant + Light.Linear * Distance + Light.Quadratic * (Distance * Distance));
-
-   vec3 ambient = Light.Ambient * vec3(texture(Material.Diffuse, TexCoords));
-   vec3 diffuse = Light.Diffuse * fDiffuse * vec3(texture(Material.Diffuse, TexCoords));
-   vec3 specular = Light.Specular * fSpecular * vec3(texture(Material.Specular, TexCoords));
-   ambient *= Attenuation;
-   diffuse *= Attenuation;
-   specular *= Attenuation;
-   return (ambient + diffuse + specular);
-}
+   vec4 PositionRange = texelFetch(u_LightData, Index * 4);
+   vec4 ColorType = texelFetch(u_LightData, Index * 4 + 1);
+
+   vec3 LightDir = PositionRange.xyz - FragPos;
+   float Distance = length(LightDir);
+   if (Distance >= PositionRange.w) return vec3(0.f);
+   LightDir /= Distance;
+
+   // Inverse square falloff, windowed to reach exactly zero at the light's range
+   float Ratio = Distance / PositionRange.w;
+   float Window = clamp(1.f - Ratio * Ratio * Ratio * Ratio, 0.f, 1.f);
+   float Attenuation = Window * Window / (1.f + Distance * Distance);
+
+   float Intensity = 1.f;
+   if (ColorType.w > 0.5)
+   {
+      vec4 DirectionInner = texelFetch(u_LightData, Index * 4 + 2);
+      float OuterCutOff = texelFetch(u_LightData, Index * 4 + 3).x;
+      float Phi = dot(LightDir, -DirectionInner.xyz);
+      Intensity = clamp((Phi - OuterCutOff) / max(DirectionInner.w - OuterCutOff, 1e-4), 0.f, 1.f);
+   }
 
-vec3 CalcSpotLight(S_SpotLight Light, vec3 Normal, vec3 FragPos, vec3 ViewDir)
-{
-   vec3 LightDir = normalize(Light.Position - FragPos);
    vec3 ReflectDir = reflect(-LightDir, Normal);
    float fDiffuse = max(dot(LightDir, Normal), 0.f);
    float fSpecular = pow(max(dot(ViewDir, ReflectDir), 0.f), Material.Shininess);
-   float Distance = length(Light.Position - FragPos);
-   float Attenuation = 1.0 / (Light.Constant + Light.Linear * Distance + Light.Quadratic * (Distance * Distance));
 
-   float ThetaValue = dot(LightDir, normalize(-Light.Direction));
-   float Phi = dot(LightDir, normalize(-Light.Direction));
-   float Epsilone = Light.InnerCutOff - Light.OuterCutOff;
-   float Intensity = clamp((Phi - Light.OuterCutOff) / Epsilone, 0.f, 1.f);
-   vec3 ambient = Light.Ambient * vec3(texture(Material.Diffuse, TexCoords));
-   vec3 diffuse = Light.Diffuse * fDiffuse * vec3(texture(Material.Diffuse, TexCoords));
-   vec3 specular = Light.Specular * fSpecular * vec3(texture(Material.Specular, TexCoords));
-   ambient *= Attenuation;
-   diffuse *= Attenuation * Intensity;
-   specular *= Attenuation * Intensity;
-   return (ambient + diffuse + specular);
-}
\ No newline at end of file
+   vec3 diffuse = ColorType.rgb * fDiffuse * vec3(texture(Material.Diffuse, TexCoords));
+   vec3 specular = ColorType.rgb * fSpecular * vec3(texture(Material.Specular, TexCoords));
+   return (diffuse + specular) * Attenuation * Intensity;
+}
@@ -0,0 +1,39 @@
+#version 330 core
+// Joint bilateral upsample of a reduced-resolution effect (see PostProcessManager). Each of
+// the four nearest low-resolution texels gets its bilinear weight, scaled down when the
+// effect's input there differs from the full-resolution input at this pixel, so results
+// don't bleed across edges of the scene.
+
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture; // Effect output, reduced resolution
+uniform sampler2D u_GuideLow;    // Effect input, reduced resolution
+uniform sampler2D u_GuideFull;   // Effect input, full resolution
+
+uniform float u_Sharpness = 32.0; // Falloff of the weights with the squared color difference
+
+void main()
+{
+    ivec2 lowSize = textureSize(screenTexture, 0);
+    vec2 position = TexCoords * vec2(lowSize) - 0.5;
+    vec2 base = floor(position);
+    vec2 fraction = position - base;
+    vec3 guide = texture(u_GuideFull, TexCoords).rgb;
+
+    vec3 color = vec3(0.0);
+    float total = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 corner = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(ivec2(base) + corner, ivec2(0), lowSize - 1);
+        vec2 bilinear = mix(1.0 - fraction, fraction, vec2(corner));
+
+        vec3 difference = texelFetch(u_GuideLow, texel, 0).rgb - guide;
+        // The small floor falls back to bilinear where no neighbour matches (e.g. distortions)
+        float weight = bilinear.x * bilinear.y * (exp(-u_Sharpness * dot(difference, difference)) + 1e-3);
+        color += texelFetch(screenTexture, texel, 0).rgb * weight;
+        total += weight;
+    }
+    FragColor = vec4(color / max(total, 1e-6), 1.0);
+}
@@ -4,20 +4,21 @@ in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
 
-const float offset = 1.0 / 300.0;
-
 void main()
 {
+    // One texel, the kernel covers the 3x3 neighbourhood at any resolution
+    vec2 offset = 1.0 / vec2(textureSize(screenTexture, 0));
+
     vec2 offsets[9] = vec2[](
-    vec2(-offset,  offset), // top-left
-    vec2( 0.0f,    offset), // top-center
-    vec2( offset,  offset), // top-right
-    vec2(-offset,  0.0f),   // center-left
-    vec2( 0.0f,    0.0f),   // center
-    vec2( offset,  0.0f),   // center-right
-    vec2(-offset, -offset), // bottom-left
-    vec2( 0.0f,   -offset), // bottom-center
-    vec2( offset, -offset)  // bottom-right
+    vec2(-offset.x, offset.y),  // top-left
+    vec2(0.0, offset.y),        // top-center
+    vec2(offset.x, offset.y),   // top-right
+    vec2(-offset.x, 0.0),       // center-left
+    vec2(0.0, 0.0),             // center
+    vec2(offset.x, 0.0),        // center-right
+    vec2(-offset.x, -offset.y), // bottom-left
+    vec2(0.0, -offset.y),       // bottom-center
+    vec2(offset.x, -offset.y)   // bottom-right
     );
 
     float kernel[9] = float[](
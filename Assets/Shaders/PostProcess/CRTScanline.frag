@@ -1,14 +1,24 @@
 #version 330 core
+// Point-wise, fusable (see EPostEffectKind)
+
+#ifndef PP_FUSED
 out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
+#endif
+
 uniform float intensity = 0.1;
 uniform float frequency = 800.0;
 
+vec3 CRTScanline(vec3 color, vec2 uv)
+{
+    float scan = sin(uv.y * frequency) * intensity;
+    return color * (1.0 - scan);
+}
+
+#ifndef PP_FUSED
 void main() {
-    vec3 color = texture(screenTexture, TexCoords).rgb;
-    float scan = sin(TexCoords.y * frequency) * intensity;
-    color *= (1.0 - scan);
-    FragColor = vec4(color, 1.0);
+    FragColor = vec4(CRTScanline(texture(screenTexture, TexCoords).rgb, TexCoords), 1.0);
 }
+#endif
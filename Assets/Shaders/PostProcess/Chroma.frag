@@ -1,15 +1,32 @@
 #version 330 core
+// Sampling, fusable (see EPostEffectKind): reads its input through PP_Input()
+
+#ifndef PP_FUSED
 out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
+
+vec3 PP_Input(vec2 uv)
+{
+    return texture(screenTexture, uv).rgb;
+}
+#endif
+
 uniform float offset = 0.005;
 
-void main()
+vec3 Chroma(vec2 uv)
 {
     vec3 col;
-    col.r = texture(screenTexture, TexCoords + vec2(offset, 0.0)).r;
-    col.g = texture(screenTexture, TexCoords).g;
-    col.b = texture(screenTexture, TexCoords - vec2(offset, 0.0)).b;
-    FragColor = vec4(col, 1.0);
+    col.r = PP_Input(uv + vec2(offset, 0.0)).r;
+    col.g = PP_Input(uv).g;
+    col.b = PP_Input(uv - vec2(offset, 0.0)).b;
+    return col;
+}
+
+#ifndef PP_FUSED
+void main()
+{
+    FragColor = vec4(Chroma(TexCoords), 1.0);
 }
+#endif
@@ -1,13 +1,22 @@
 #version 330 core
+// Point-wise, fusable (see EPostEffectKind)
 
+#ifndef PP_FUSED
 out vec4 FragColor;
 
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture; // The color texture from framebuffer
+#endif
 
+vec3 ColorInverter(vec3 color, vec2 uv)
+{
+    return vec3(1.0 - color);
+}
+
+#ifndef PP_FUSED
 void main()
 {
-    vec3 col = texture(screenTexture, TexCoords).rgb;
-    FragColor = vec4(vec3(1.0 - col), 1.0);
+    FragColor = vec4(ColorInverter(texture(screenTexture, TexCoords).rgb, TexCoords), 1.0);
 }
+#endif
@@ -0,0 +1,26 @@
+#version 330 core
+// Point-wise, fusable (see EPostEffectKind). Applies a chain of color effects baked by JColorLUT.
+
+#ifndef PP_FUSED
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+#endif
+
+uniform sampler3D u_ColorLUT;
+uniform float u_ColorLUTSize = 32.0;
+
+vec3 ColorLUT(vec3 color, vec2 uv)
+{
+    // 0 and 1 map to the centers of the first and last texels
+    vec3 coords = clamp(color, 0.0, 1.0) * ((u_ColorLUTSize - 1.0) / u_ColorLUTSize) + 0.5 / u_ColorLUTSize;
+    return texture(u_ColorLUT, coords).rgb;
+}
+
+#ifndef PP_FUSED
+void main()
+{
+    FragColor = vec4(ColorLUT(texture(screenTexture, TexCoords).rgb, TexCoords), 1.0);
+}
+#endif
@@ -0,0 +1,20 @@
+#version 330 core
+// Box downsample into a reduced-resolution segment (see PostProcessManager). Four bilinear
+// taps, each the average of a 2x2 quad, cover the whole block of input texels behind the
+// output pixel, so a quarter-resolution target sees all 16 texels instead of the middle 4.
+
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+
+uniform vec2 u_TapOffset; // Quarter of the block size, in UV of the input
+
+void main()
+{
+    vec3 color = texture(screenTexture, TexCoords - u_TapOffset).rgb;
+    color += texture(screenTexture, TexCoords + u_TapOffset).rgb;
+    color += texture(screenTexture, TexCoords + vec2(u_TapOffset.x, -u_TapOffset.y)).rgb;
+    color += texture(screenTexture, TexCoords - vec2(u_TapOffset.x, -u_TapOffset.y)).rgb;
+    FragColor = vec4(color * 0.25, 1.0);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+// Dual filter (Kawase) downsample: center plus four diagonal bilinear taps into a half-size target
+
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+
+uniform vec2 u_HalfPixel;    // Half a texel of the target, in UV
+uniform float u_Offset = 1.0;
+
+void main()
+{
+    vec2 offset = u_HalfPixel * u_Offset;
+    vec3 color = texture(screenTexture, TexCoords).rgb * 4.0;
+    color += texture(screenTexture, TexCoords - offset).rgb;
+    color += texture(screenTexture, TexCoords + offset).rgb;
+    color += texture(screenTexture, TexCoords + vec2(offset.x, -offset.y)).rgb;
+    color += texture(screenTexture, TexCoords - vec2(offset.x, -offset.y)).rgb;
+    FragColor = vec4(color / 8.0, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 330 core
+// Dual filter (Kawase) upsample: tent of eight bilinear taps into a double-size target
+
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+
+uniform vec2 u_HalfPixel;    // Half a texel of the target, in UV
+uniform float u_Offset = 1.0;
+
+void main()
+{
+    vec2 offset = u_HalfPixel * u_Offset;
+    vec3 color = texture(screenTexture, TexCoords + vec2(-offset.x * 2.0, 0.0)).rgb;
+    color += texture(screenTexture, TexCoords + vec2(-offset.x, offset.y)).rgb * 2.0;
+    color += texture(screenTexture, TexCoords + vec2(0.0, offset.y * 2.0)).rgb;
+    color += texture(screenTexture, TexCoords + vec2(offset.x, offset.y)).rgb * 2.0;
+    color += texture(screenTexture, TexCoords + vec2(offset.x * 2.0, 0.0)).rgb;
+    color += texture(screenTexture, TexCoords + vec2(offset.x, -offset.y)).rgb * 2.0;
+    color += texture(screenTexture, TexCoords + vec2(0.0, -offset.y * 2.0)).rgb;
+    color += texture(screenTexture, TexCoords + vec2(-offset.x, -offset.y)).rgb * 2.0;
+    FragColor = vec4(color / 12.0, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 330 core
+// One axis of a separable Gaussian (see JBlurProcessor). Each tap is a bilinear fetch placed
+// between two texels so that it returns their weighted sum.
+
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+
+const int MAX_TAPS = 16;
+
+uniform vec2 u_Direction;               // One texel along the blur axis, in UV
+uniform int u_TapCount = 0;             // Taps on each side of the center
+uniform float u_Weights[MAX_TAPS + 1];  // [0] is the center texel
+uniform float u_Offsets[MAX_TAPS + 1];  // In texels
+
+void main()
+{
+    vec3 color = texture(screenTexture, TexCoords).rgb * u_Weights[0];
+    for (int i = 1; i <= u_TapCount; ++i)
+    {
+        vec2 offset = u_Direction * u_Offsets[i];
+        color += texture(screenTexture, TexCoords + offset).rgb * u_Weights[i];
+        color += texture(screenTexture, TexCoords - offset).rgb * u_Weights[i];
+    }
+    FragColor = vec4(color, 1.0);
+}
@@ -1,17 +1,27 @@
 #version 330 core
+// Point-wise, fusable (see EPostEffectKind)
+
+#ifndef PP_FUSED
 out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
+#endif
+
 uniform float iTime = 1;
 
-float rand(vec2 co){
+float GrainNoise_Rand(vec2 co){
     return fract(sin(dot(co.xy ,vec2(12.9898,78.233))) * 43758.5453);
 }
 
+vec3 GrainNoise(vec3 color, vec2 uv)
+{
+    float n = GrainNoise_Rand(uv * iTime);
+    return color + n * 0.1;
+}
+
+#ifndef PP_FUSED
 void main() {
-    vec3 color = texture(screenTexture, TexCoords).rgb;
-    float n = rand(TexCoords * iTime);
-    color += n * 0.1;
-    FragColor = vec4(color, 1.0);
+    FragColor = vec4(GrainNoise(texture(screenTexture, TexCoords).rgb, TexCoords), 1.0);
 }
+#endif
@@ -1,13 +1,22 @@
 #version 330 core
+// Point-wise, fusable (see EPostEffectKind)
 
+#ifndef PP_FUSED
 out vec4 FragColor;
 
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture; // The color texture from framebuffer
+#endif
 
+vec3 Grayscale(vec3 color, vec2 uv)
+{
+    float average = (color.r + color.g + color.b) / 3.0;
+    return vec3(average);
+}
+
+#ifndef PP_FUSED
 void main() {
-    FragColor = texture(screenTexture, TexCoords);
-    float average = (FragColor.r + FragColor.g + FragColor.b) / 3.0;
-    FragColor = vec4(average, average, average, 1.0);
-}
\ No newline at end of file
+    FragColor = vec4(Grayscale(texture(screenTexture, TexCoords).rgb, TexCoords), 1.0);
+}
+#endif
@@ -1,12 +1,22 @@
 #version 330 core
+// Point-wise, fusable (see EPostEffectKind)
+
+#ifndef PP_FUSED
 out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D screenTexture;
+#endif
+
 uniform int levels = 5; // e.g., 5
 
+vec3 Posterize(vec3 color, vec2 uv)
+{
+    return floor(color * float(levels)) / float(levels);
+}
+
+#ifndef PP_FUSED
 void main() {
-    vec3 color = texture(screenTexture, TexCoords).rgb;
-    color = floor(color * float(levels)) / float(levels);
-    FragColor = vec4(color, 1.0);
+    FragColor = vec4(Posterize(texture(screenTexture, TexCoords).rgb, TexCoords), 1.0);
 }
+#endif
@@ -0,0 +1,42 @@
+#version 330 core
+// Catmull-Rom upscale of a chain rendered below the screen size (see PostProcessManager).
+// The 4x4 bicubic footprint is folded into 9 bilinear fetches: the two middle taps of
+// each axis have positive weights and are merged into one fetch between them.
+
+out vec4 FragColor;
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+
+void main()
+{
+    vec2 size = vec2(textureSize(screenTexture, 0));
+    vec2 position = TexCoords * size;
+    vec2 center1 = floor(position - 0.5) + 0.5;
+    vec2 f = position - center1;
+
+    // Catmull-Rom weights of the four texels along each axis
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 uv0 = (center1 - 1.0) / size;
+    vec2 uv12 = (center1 + w2 / w12) / size;
+    vec2 uv3 = (center1 + 2.0) / size;
+
+    vec3 color = vec3(0.0);
+    color += texture(screenTexture, vec2(uv0.x, uv0.y)).rgb * w0.x * w0.y;
+    color += texture(screenTexture, vec2(uv12.x, uv0.y)).rgb * w12.x * w0.y;
+    color += texture(screenTexture, vec2(uv3.x, uv0.y)).rgb * w3.x * w0.y;
+    color += texture(screenTexture, vec2(uv0.x, uv12.y)).rgb * w0.x * w12.y;
+    color += texture(screenTexture, vec2(uv12.x, uv12.y)).rgb * w12.x * w12.y;
+    color += texture(screenTexture, vec2(uv3.x, uv12.y)).rgb * w3.x * w12.y;
+    color += texture(screenTexture, vec2(uv0.x, uv3.y)).rgb * w0.x * w3.y;
+    color += texture(screenTexture, vec2(uv12.x, uv3.y)).rgb * w12.x * w3.y;
+    color += texture(screenTexture, vec2(uv3.x, uv3.y)).rgb * w3.x * w3.y;
+
+    // Negative lobes ring around hard edges, keep the result in range
+    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;           // position-only stream of the geometry pool
+layout (location = 7) in mat4 aInstanceModel; // occupies locations 7-10
+
+uniform mat4 u_LightViewProjection;
+
+void main()
+{
+    gl_Position = u_LightViewProjection * aInstanceModel * vec4(aPos, 1.0);
+}
@@ -4,11 +4,16 @@
 
 #include <Rendering/Rendering.h>
 #include <Scene/Scene.h>
+#include <Scene/JLightActor.h>
 #include <EditorApp.h>
 #include <Core/JEngine.h>
+#include <Core/CoreMinimal.h>
+#include <Core/JCpuProfiler.h>
+#include <Core/JJobSystem.h>
 #include <glad/gl.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
 #include <iostream>
 #include <GLFW/glfw3.h>
 #include <imgui.h>
@@ -82,6 +87,10 @@ int main() {
   // Get EngineState
   EngineState& State = JEngine::Get().GetState();
 
+  // Culling, occlusion and light binning split their work over the engine's job system,
+  // reached through GetJobSystem()
+  JEngine::Get().GetOrCreateService<JJobSystem>();
+
   glEnable(GL_DEPTH_TEST);
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -89,17 +98,33 @@ int main() {
   // ----------------- Rendering & PostProcessor -----------------
   // Initialize scene renderer
   GRenderer = new JRenderer(Setting->GetScreenWidth(), Setting->GetScreenHeight(), 4);
+  // Outlined selections are drawn once and outlined in screen space instead of three geometry passes
+  GRenderer->SetOutlineMode(EOutlineMode::JumpFlood);
+  GRenderer->GetDynamicResolution().SetEnabled(true);
   // Initialize post-processing manager
-  GPostProcessManager = new PostProcessManager(Setting->GetScreenWidth(), Setting->GetScreenHeight());
+  GPostProcessManager = new PostProcessManager(Setting->GetScreenWidth(), Setting->GetScreenHeight(),
+                                               &GRenderer->GetTargetPool());
+  // Post-process passes are timed next to the scene passes
+  GPostProcessManager->SetGpuProfiler(&GRenderer->GetGpuProfiler());
 
-  // Add effects
+  // Add effects, passthroughs are dropped and fusable neighbours share one pass
   GPostProcessManager->AddProcessor(std::make_unique<JPostProcessor>("PostProcess", "PostProcessNoEffect"));
   GPostProcessManager->AddProcessor(std::make_unique<JPostProcessor>("PostProcess", "PostProcess/Chroma"));
   GPostProcessManager->AddProcessor(std::make_unique<JPostProcessor>("PostProcess", "PostProcess/CRTScanline"));
+  // Blur radius is in pixels, below half a pixel the chain drops it: the UI toggle switches it to 0
+  bool bBlur = false;
+  float BlurRadius = 8.f;
+  auto blur = std::make_unique<JBlurProcessor>(EBlurMethod::DualFilter, bBlur ? BlurRadius : 0.f);
+  JBlurProcessor* Blur = blur.get();
+  GPostProcessManager->AddProcessor(std::move(blur));
 
   // ----------------- Shaders -----------------
-  JShader ShaderProgram("ModelLoading", "ModelLoading");
+  JShader ShaderProgram("ModelLoadingLit", "ModelLoadingLit");
   JShader BlackColorShader("OutlineShader", "BlackColor");
+  JShader InstancedShader("ModelLoadingLitInstanced", "ModelLoadingLit");
+  // Weighted-blended transparency writes the same lit surfaces as the sorted path
+  JShader TransparentShader("ModelLoadingLit", "ModelLoadingLit", nullptr, "#define OIT_OUTPUT\n");
+  JShader TransparentInstancedShader("ModelLoadingLitInstanced", "ModelLoadingLit", nullptr, "#define OIT_OUTPUT\n");
 
   // --- UBO ---
   GLuint uboCamera;
@@ -111,6 +136,120 @@ int main() {
   // link shaders to this block
   ShaderProgram.LinkUniformBlock("CameraData", 0);
   BlackColorShader.LinkUniformBlock("CameraData", 0);
+  InstancedShader.LinkUniformBlock("CameraData", 0);
+  TransparentShader.LinkUniformBlock("CameraData", 0);
+  TransparentInstancedShader.LinkUniformBlock("CameraData", 0);
+
+  // Lit shaders share one directional light, point and spot lights come from the light clusters
+  const glm::vec3 SunDirection(-0.3f, -1.0f, -0.2f);
+  for (JShader* shader : { &ShaderProgram, &InstancedShader, &TransparentShader, &TransparentInstancedShader })
+  {
+    shader->Use();
+    shader->SetVec3("DirLight.Direction", SunDirection);
+    shader->SetVec3("DirLight.Ambient", glm::vec3(0.35f));
+    shader->SetVec3("DirLight.Diffuse", glm::vec3(0.6f));
+    shader->SetVec3("DirLight.Specular", glm::vec3(0.2f));
+  }
+
+  // Actors sharing a model are drawn with one instanced draw per mesh
+  JInstanceBatcher InstanceBatcher;
+
+  // Actors and meshes outside the camera frustum are skipped before batching
+  JFrustumCuller FrustumCuller;
+  std::vector<const JActor*> CullActors;
+
+  // Flagged occluders are rasterized on the CPU and hide what is behind them
+  JSoftwareOcclusion SoftwareOcclusion;
+  bool bOcclusionCulling = true;
+
+  // Candidates for the GPU occlusion queries issued after the opaque pass
+  std::vector<const JActor*> QueryActors;
+
+  // Back-to-front transparent draw list, kept sorted across frames
+  JTransparentSorter TransparentSorter;
+
+  // Transparent actors batched in any order for weighted-blended OIT
+  JInstanceBatcher TransparentBatcher;
+  TransparentBatcher.SetPass(EBatchPass::Transparent);
+
+  // Dynamic lights, assigned to view-space clusters on the CPU every frame
+  JClusteredLighting ClusteredLighting;
+  std::vector<JLightActor> Lights;
+  std::vector<const JLightActor*> ActiveLights;
+  int ActiveLightCount = 128;
+  for (int i = 0; i < 512; ++i)
+  {
+    const glm::vec3 position(-50.f + (i % 32) * 2.5f, 2.f, -30.f + (i / 32) * 4.f);
+    const glm::vec3 color(0.5f + 0.5f * std::sin(i * 0.7f), 0.5f + 0.5f * std::sin(i * 1.3f + 2.f),
+                          0.5f + 0.5f * std::sin(i * 2.1f + 4.f));
+    Lights.emplace_back("Light " + std::to_string(i), position, color, 6.f);
+    Lights.back().Intensity = 8.f;
+  }
+
+  // Sun shadows, far cascades keep static casters cached between frames
+  JCascadedShadows Shadows;
+
+  // Screenshots and recordings of the final image, read back a few frames late
+  JFrameCapture FrameCapture;
+  int CaptureCount = 0;
+
+  // Outlined actors are drawn once and tagged for the screen-space outline pass,
+  // or with the inflated geometry passes in EOutlineMode::Geometry
+  auto DrawActor = [&](const JActor& act)
+  {
+    const bool bMark = act.Config.bDrawOutline && GRenderer->GetOutlineMode() == EOutlineMode::JumpFlood;
+    if (bMark) GRenderer->GetOutlineRenderer().BeginMark();
+    act.DrawConfig(ShaderProgram, BlackColorShader, !bMark);
+    if (bMark) GRenderer->GetOutlineRenderer().EndMark();
+  };
+
+  // With OIT, transparent actors only reach the accumulation targets, so the outline of an outlined
+  // one is seeded in the scene target first: its stencil tag, plus the inflated shell in Geometry mode
+  auto SeedTransparentOutline = [&](const JActor& act, int meshIndex)
+  {
+    auto drawItem = [&](JShader& shader)
+    {
+      if (meshIndex < 0)
+        act.Draw(shader);
+      else
+        act.DrawMesh(shader, static_cast<size_t>(meshIndex));
+    };
+
+    const bool bJumpFlood = GRenderer->GetOutlineMode() == EOutlineMode::JumpFlood;
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    if (bJumpFlood)
+    {
+      GRenderer->GetOutlineRenderer().BeginMark();
+      drawItem(ShaderProgram);
+      GRenderer->GetOutlineRenderer().EndMark();
+    }
+    else
+    {
+      glEnable(GL_STENCIL_TEST);
+      glStencilFunc(GL_ALWAYS, 1, 0xFF);
+      glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+      glStencilMask(0xFF);
+      drawItem(ShaderProgram);
+    }
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    if (bJumpFlood) return;
+
+    // Back faces of the inflated mesh, only around the tagged pixels
+    glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
+    glStencilMask(0x00);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+    BlackColorShader.Use();
+    BlackColorShader.SetFloat("outlineThickness", act.Config.OutlineThickness);
+    drawItem(BlackColorShader);
+    glDisable(GL_CULL_FACE);
+    glStencilMask(0xFF);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glDisable(GL_STENCIL_TEST);
+  };
 
   // ----------------- Load Models -----------------
   JModel DioBrando("Dio Brando/DioMansion.obj");
@@ -125,11 +264,15 @@ int main() {
   State.GetSceneActors().back().Scale = glm::vec3(1.0f);
   State.GetSceneActors().back().Config.bDrawOutline = true;
   State.GetSceneActors().back().Config.bBackCulling = false;
+  State.GetSceneActors().back().Config.bIsOccluder = true;
+  State.GetSceneActors().back().Config.bIsStatic = true;
 
   // Example of a second object
   State.GetSceneActors().emplace_back(&DioBrando, "DioBrando");
   State.GetSceneActors().back().Position = glm::vec3(-25.f, 0.0f, 0.f);
   State.GetSceneActors().back().Config.bBackCulling = false;
+  State.GetSceneActors().back().Config.bIsOccluder = true;
+  State.GetSceneActors().back().Config.bIsStatic = true;
 
   // Transparent windows
   State.GetSceneActors().emplace_back(&MedievalWindow, "Window 1");
@@ -142,10 +285,17 @@ int main() {
 
   // ----------------- GUI Init -----------------
   EditorApp Editor(Window);
+  Editor.SetGpuProfiler(&GRenderer->GetGpuProfiler());
 
   // ----------------- Render Loop -----------------
+  JCpuProfiler::Get().SetThreadName("Main");
   while (!glfwWindowShouldClose(Window))
   {
+    // Zones of the previous frame go to the profiler's timeline, its GL counters to the render stats
+    JCpuProfiler::Get().BeginFrame();
+    JRenderStats::Get().BeginFrame();
+    J_PROFILE_SCOPE("Frame");
+
     // DeltaTime
     float currentFrame = static_cast<float>(glfwGetTime());
     State.SetDeltaTime(currentFrame - LastFrame);
@@ -164,10 +314,11 @@ int main() {
     // ----------------- Camera & Projection -----------------
     int fbWidth, fbHeight;
     glfwGetFramebufferSize(Window, &fbWidth, &fbHeight);
+    const float NearPlane = 0.1f, FarPlane = 100.0f;
     glm::mat4 projection = glm::perspective(
         glm::radians(Camera->Zoom),
         (float)fbWidth / fbHeight,
-        0.1f, 100.0f
+        NearPlane, FarPlane
     );
     glm::mat4 view = Camera->GetViewMatrix();
 
@@ -187,38 +338,209 @@ int main() {
       ImGui::Text("Camera Position: (%.1f, %.1f, %.1f)",
                   Camera->Position.x, Camera->Position.y, Camera->Position.z);
 
+      const FCullingStats& cullStats = FrustumCuller.GetStats();
+      ImGui::Text("Visible Actors: %d / %d", cullStats.VisibleActors, cullStats.TestedActors);
+      ImGui::Text("Visible Meshes: %d / %d", cullStats.VisibleMeshes, cullStats.TestedMeshes);
+      bool bCulling = FrustumCuller.IsEnabled();
+      if (ImGui::Checkbox("Frustum Culling", &bCulling))
+        FrustumCuller.SetEnabled(bCulling);
+      ImGui::Checkbox("Occlusion Culling", &bOcclusionCulling);
+      ImGui::Text("Occluders: %d (%d triangles)", SoftwareOcclusion.GetStats().Occluders,
+                  SoftwareOcclusion.GetStats().RasterizedTriangles);
+      ImGui::Text("Occluded Meshes: %d (%.0f%%)", cullStats.OccludedMeshes,
+                  cullStats.GetOcclusionRejectionRate() * 100.f);
+
+      JOcclusionQueries& gpuOcclusion = GRenderer->GetOcclusionQueries();
+      const FOcclusionQueryStats& queryStats = gpuOcclusion.GetStats();
+      bool bGpuOcclusion = gpuOcclusion.IsEnabled();
+      if (ImGui::Checkbox("GPU Occlusion Queries", &bGpuOcclusion))
+        gpuOcclusion.SetEnabled(bGpuOcclusion);
+      ImGui::Text("Queries: %d issued, %d resolved, %d pending", queryStats.IssuedQueries,
+                  queryStats.ResolvedQueries, queryStats.PendingQueries);
+      ImGui::Text("Rejected Draws: %d (+%d conditional)", queryStats.RejectedDraws, queryStats.ConditionalDraws);
+      bool bWeightedBlended = GRenderer->GetTransparencyMode() == ETransparencyMode::WeightedBlended;
+      if (ImGui::Checkbox("Weighted Blended OIT", &bWeightedBlended))
+        GRenderer->SetTransparencyMode(bWeightedBlended ? ETransparencyMode::WeightedBlended : ETransparencyMode::Sorted);
+      bool bScreenOutlines = GRenderer->GetOutlineMode() == EOutlineMode::JumpFlood;
+      if (ImGui::Checkbox("Screen-Space Outlines", &bScreenOutlines))
+        GRenderer->SetOutlineMode(bScreenOutlines ? EOutlineMode::JumpFlood : EOutlineMode::Geometry);
+      JOutlineRenderer& outlines = GRenderer->GetOutlineRenderer();
+      float outlineWidth = outlines.GetWidth();
+      if (ImGui::SliderFloat("Outline Width", &outlineWidth, 1.f, 16.f))
+        outlines.SetWidth(outlineWidth);
+      ImGui::SliderInt("Lights", &ActiveLightCount, 0, static_cast<int>(Lights.size()));
+      const FClusterStats& clusterStats = ClusteredLighting.GetStats();
+      ImGui::Text("Visible Lights: %d / %d, %d clusters lit, max %d per cluster", clusterStats.VisibleLights,
+                  clusterStats.Lights, clusterStats.ActiveClusters, clusterStats.MaxLightsPerCluster);
+      bool bShadows = Shadows.IsEnabled();
+      if (ImGui::Checkbox("Shadows", &bShadows))
+        Shadows.SetEnabled(bShadows);
+      const FShadowStats& shadowStats = Shadows.GetStats();
+      ImGui::Text("Shadow Draws: %d (%d / %d / %d%s / %d%s), %d static rebuilds", shadowStats.GetTotalDraws(),
+                  shadowStats.Draws[0], shadowStats.Draws[1], shadowStats.Draws[2], shadowStats.Cached[2] ? " cached" : "",
+                  shadowStats.Draws[3], shadowStats.Cached[3] ? " cached" : "", shadowStats.StaticRebuilds);
+      JDynamicResolution& dynamicResolution = GRenderer->GetDynamicResolution();
+      bool bDynamicResolution = dynamicResolution.IsEnabled();
+      if (ImGui::Checkbox("Dynamic Resolution", &bDynamicResolution))
+        dynamicResolution.SetEnabled(bDynamicResolution);
+      FDynamicResolutionSettings resolutionSettings = dynamicResolution.GetSettings();
+      if (ImGui::SliderFloat("Scene GPU Budget (ms)", &resolutionSettings.TargetGpuMs, 1.f, 33.f))
+        dynamicResolution.SetSettings(resolutionSettings);
+      const FDynamicResolutionState& resolutionState = dynamicResolution.GetState();
+      ImGui::Text("Render Scale: %.2f (%dx%d), scene GPU %.2f ms, %d adjustments", resolutionState.Scale,
+                  resolutionState.RenderWidth, resolutionState.RenderHeight, resolutionState.LastGpuMs,
+                  resolutionState.Adjustments);
+      ImGui::Text("Post-Process Passes: %d for %d effects", GPostProcessManager->GetPassCount(),
+                  GPostProcessManager->GetEffectCount());
+      if (ImGui::Checkbox("Blur", &bBlur))
+        Blur->SetRadius(bBlur ? BlurRadius : 0.f);
+      if (bBlur) {
+        if (ImGui::SliderFloat("Blur Radius", &BlurRadius, 1.f, 256.f))
+          Blur->SetRadius(BlurRadius);
+        bool bGaussianBlur = Blur->GetMethod() == EBlurMethod::Gaussian;
+        if (ImGui::Checkbox("Gaussian Blur", &bGaussianBlur))
+          Blur->SetMethod(bGaussianBlur ? EBlurMethod::Gaussian : EBlurMethod::DualFilter);
+        ImGui::Text("Blur Passes: %d", Blur->GetPassCount());
+      }
+      const FRenderGraphStats& graphStats = GPostProcessManager->GetGraphStats();
+      ImGui::Text("Post-Process Targets: %d transient on %d pooled, %.1f MB (%.1f MB unaliased), %d resolves",
+                  graphStats.TransientTextures, graphStats.PhysicalTargets, graphStats.PooledBytes / 1048576.0,
+                  graphStats.TransientBytes / 1048576.0, graphStats.Resolves);
+      ImGui::Text("Transparent Draws: %zu (%s, %zu shifts)", TransparentSorter.GetCount(),
+                  TransparentSorter.UsedRadixSort() ? "radix" : "insertion", TransparentSorter.GetLastShiftCount());
+      if (ImGui::Button("Screenshot"))
+        FrameCapture.RequestScreenshot("Captures/Screenshot" + std::to_string(CaptureCount++) + ".png");
+      ImGui::SameLine();
+      bool bRecording = FrameCapture.IsRecording();
+      if (ImGui::Checkbox("Record Video", &bRecording))
+      {
+        if (bRecording)
+          FrameCapture.StartRecording("Captures/Recording" + std::to_string(CaptureCount++) + ".y4m", 60);
+        else
+          FrameCapture.StopRecording();
+      }
+      const FFrameCaptureStats captureStats = FrameCapture.GetStats();
+      ImGui::Text("Capture: %llu read, %llu written (%.1f MB), %llu dropped, %d pending, %d queued",
+                  static_cast<unsigned long long>(captureStats.FramesRead),
+                  static_cast<unsigned long long>(captureStats.FramesWritten), captureStats.BytesWritten / 1048576.0,
+                  static_cast<unsigned long long>(captureStats.FramesDropped), captureStats.PendingReadbacks,
+                  captureStats.QueuedWrites);
+
       ImGui::End();
 
       Editor.RenderPanels();
     }
 
     // ----------------- Draw Scene -----------------
+    auto& sceneActors = State.GetSceneActors();
+    CullActors.clear();
+    for (auto& act : sceneActors)
+      CullActors.push_back(&act);
+
+    // Shadow cascades render into their own targets before the scene target is bound
+    if (Setting->GetbWireFrame()) glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    {
+      J_PROFILE_SCOPE("Shadows");
+      Shadows.Update(*Camera, (float)fbWidth / fbHeight, NearPlane, SunDirection);
+      Shadows.Render(CullActors);
+    }
+    if (Setting->GetbWireFrame()) glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
     // Begin scene rendering
     GRenderer->BeginScene();
 
-    std::vector<std::pair<float, JActor>> sortedTransparent;
-    for (auto& act : State.GetSceneActors())
+    // Frustum culling
+    FrustumCuller.Cull(projection * view, CullActors, GetJobSystem());
+
+    // Occlusion culling against the visible occluders
+    if (bOcclusionCulling)
     {
-      if (act.Config.bIsTransparent)
+      SoftwareOcclusion.BeginFrame(projection * view);
+      for (size_t i = 0; i < sceneActors.size(); ++i)
       {
-        float distance = glm::length(Camera->Position - act.Position);
-        sortedTransparent.emplace_back(distance, act);
+        const JActor& act = sceneActors[i];
+        const JModel* occluder = act.OccluderModel ? act.OccluderModel : act.Model;
+        if (act.Config.bIsOccluder && occluder && FrustumCuller.IsActorVisible(i))
+          SoftwareOcclusion.AddOccluder(*occluder, act.GetModelMatrix());
       }
-      else
+      SoftwareOcclusion.Rasterize(GetJobSystem());
+      FrustumCuller.CullOccluded(SoftwareOcclusion, GetJobSystem());
+    }
+
+    // Animate the lights and assign them to clusters
+    const float time = static_cast<float>(glfwGetTime());
+    ActiveLights.clear();
+    for (int i = 0; i < ActiveLightCount; ++i)
+    {
+      Lights[i].Position.y = 2.f + 1.5f * std::sin(time + i * 0.37f);
+      ActiveLights.push_back(&Lights[i]);
+    }
+    ClusteredLighting.Build(view, projection, NearPlane, FarPlane, ActiveLights, GetJobSystem());
+    for (JShader* shader : { &ShaderProgram, &InstancedShader, &TransparentShader, &TransparentInstancedShader })
+    {
+      ClusteredLighting.Bind(*shader, GRenderer->GetRenderWidth(), GRenderer->GetRenderHeight());
+      Shadows.Bind(*shader);
+      shader->SetVec3("ViewPos", Camera->Position);
+    }
+
+    InstanceBatcher.Begin();
+
+    JOcclusionQueries& OcclusionQueries = GRenderer->GetOcclusionQueries();
+    QueryActors.clear();
+
+    const bool bOrderIndependent = GRenderer->GetTransparencyMode() == ETransparencyMode::WeightedBlended;
+    TransparentBatcher.Begin();
+    TransparentSorter.Begin(Camera->Position);
+    {
+      J_PROFILE_SCOPE("Actor Submission");
+      for (size_t i = 0; i < sceneActors.size(); ++i)
       {
-        // Draw opaque immediately
-        act.DrawConfig(ShaderProgram, BlackColorShader);
+        if (!FrustumCuller.IsActorVisible(i)) continue;
+
+        auto& act = sceneActors[i];
+
+        // Hidden actors keep being queried so they come back as soon as they are revealed
+        QueryActors.push_back(&act);
+        if (!OcclusionQueries.ShouldSubmit(act)) continue;
+
+        if (act.Config.bIsTransparent)
+        {
+          // With OIT only actors the batcher rejects (e.g. outlined) go through the draw list
+          if (!bOrderIndependent || !TransparentBatcher.Submit(act, FrustumCuller.GetMeshVisibility(i)))
+            TransparentSorter.Add(static_cast<uint32_t>(i), act, FrustumCuller.GetMeshVisibility(i));
+        }
+        else if (!InstanceBatcher.Submit(act, FrustumCuller.GetMeshVisibility(i)))
+        {
+          // Opaque actors that can't be instanced (e.g. outlined) are drawn immediately,
+          // left to the GPU to skip if their last query saw nothing
+          const bool bConditional = OcclusionQueries.BeginConditionalDraw(act);
+          DrawActor(act);
+          if (bConditional) OcclusionQueries.EndConditionalDraw();
+        }
       }
     }
 
+    // Draw all batched opaque actors, one instanced draw per mesh per model
+    InstanceBatcher.Flush(InstancedShader);
+
+    // Query actor bounds against the opaque depth, results are read next frame
+    OcclusionQueries.IssueQueries(QueryActors, Camera->Position);
+
     // Sort transparent ones farthest to nearest
-    std::sort(sortedTransparent.begin(), sortedTransparent.end(),
-    [](const auto& a, const auto& b) { return a.first > b.first;});
+    TransparentSorter.Sort();
 
-    // Draw transparent ones in back-to-front order
-    for (auto& [distance, act] : sortedTransparent)
+    if (!bOrderIndependent)
     {
-      act.DrawConfig(ShaderProgram, BlackColorShader);
+      // Draw transparent ones in back-to-front order, whole actors or single meshes of large models
+      for (size_t i = 0; i < TransparentSorter.GetCount(); ++i)
+      {
+        const FTransparentItem& item = TransparentSorter.GetSorted(i);
+        const JActor& act = sceneActors[item.ActorIndex];
+        if (item.MeshIndex < 0)
+          DrawActor(act);
+        else
+          act.DrawMesh(ShaderProgram, static_cast<size_t>(item.MeshIndex));
+      }
     }
 
     // Reset wireframe so post-process quad is normal
@@ -227,23 +549,67 @@ int main() {
     // --- Draw skybox ---
     SeaSkybox.Draw(view, projection);
 
+    // Order-independent transparency is accumulated over opaque geometry and sky, then composited
+    if (bOrderIndependent)
+    {
+      for (size_t i = 0; i < TransparentSorter.GetCount(); ++i)
+      {
+        const FTransparentItem& item = TransparentSorter.GetSorted(i);
+        const JActor& act = sceneActors[item.ActorIndex];
+        if (act.Config.bDrawOutline) SeedTransparentOutline(act, item.MeshIndex);
+      }
+
+      GRenderer->BeginTransparency();
+      TransparentBatcher.Flush(TransparentInstancedShader);
+      for (size_t i = 0; i < TransparentSorter.GetCount(); ++i)
+      {
+        const FTransparentItem& item = TransparentSorter.GetSorted(i);
+        const JActor& act = sceneActors[item.ActorIndex];
+        if (item.MeshIndex < 0)
+          act.Draw(TransparentShader);
+        else
+          act.DrawMesh(TransparentShader, static_cast<size_t>(item.MeshIndex));
+      }
+      GRenderer->EndTransparency();
+    }
+
     // Finish scene rendering
     GRenderer->EndScene();
 
     // Apply post-processing
+    // The multi-sampled scene is resolved by the post-process graph into pooled memory
     GPostProcessManager->ApplyChain(
-      GRenderer->GetSceneTargetTexture(), fbWidth, fbHeight);
+      GRenderer->GetSceneTarget(), fbWidth, fbHeight, GetJobSystem());
+
+    // Read back the final image before the editor draws over it
+    FrameCapture.EndFrame(fbWidth, fbHeight);
 
     // --- Render Editor ---
     Editor.EndFrame();
 
     // Check and call events (Swap and buffers)
-    glfwSwapBuffers(Window);
+    {
+      J_PROFILE_SCOPE("Present");
+      glfwSwapBuffers(Window);
+    }
     glfwPollEvents();
   }
 
   // De-allocated all resources
   Editor.Shutdown();
+
+  // GL objects must go while the context is current, locals and singletons outlive glfwTerminate()
+  FrameCapture.Shutdown();
+  Shadows.Shutdown();
+  ClusteredLighting.Shutdown();
+  TransparentBatcher.Shutdown();
+  InstanceBatcher.Shutdown();
+  delete GPostProcessManager;
+  GPostProcessManager = nullptr;
+  delete GRenderer;
+  GRenderer = nullptr;
+  JGeometryPool::ShutdownAll();
+
   glfwDestroyWindow(Window);
   glfwTerminate();
 
@@ -273,6 +639,8 @@ inline void FramebufferSizeCallback(GLFWwindow *Window, int Width, int Height)
   glViewport(0, 0, Width, Height);
   if (GRenderer)
     GRenderer->Resize(Width, Height);
+  if (GPostProcessManager)
+    GPostProcessManager->Resize(Width, Height);
 }
 
 void MouseCallback(GLFWwindow *Window, double xPosIn, double yPosIn)
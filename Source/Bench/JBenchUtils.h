@@ -0,0 +1,128 @@
+// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+// Command line and statistics helpers shared by the benchmark executables.
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// A command line option of a benchmark.
+struct FBenchOption
+{
+    const char* Name;  ///< e.g. "--frames"
+    const char* Value; ///< Placeholder of the value in the usage, nullptr for a flag
+    const char* Help;  ///< Description, ending with the default in parentheses
+    std::function<bool(const char* value)> Apply; ///< Receives nullptr for a flag, false rejects the value
+};
+
+/// Flag setting target to value.
+inline FBenchOption MakeFlagOption(const char* name, const char* help, bool& target, bool value)
+{
+    return { name, nullptr, help, [&target, value](const char*) { target = value; return true; } };
+}
+
+/// Integer option, clamped to minValue.
+inline FBenchOption MakeIntOption(const char* name, const char* value, const char* help, int& target, int minValue)
+{
+    return { name, value, help, [&target, minValue](const char* text)
+    {
+        target = std::max(std::atoi(text), minValue);
+        return true;
+    } };
+}
+
+inline FBenchOption MakeStringOption(const char* name, const char* value, const char* help, std::string& target)
+{
+    return { name, value, help, [&target](const char* text) { target = text; return true; } };
+}
+
+inline void PrintBenchUsage(const char* bench, const std::vector<FBenchOption>& options)
+{
+    size_t width = 0;
+    for (const FBenchOption& option : options)
+        width = std::max(width, std::strlen(option.Name) + (option.Value ? std::strlen(option.Value) + 1 : 0));
+
+    std::cout << "Usage: " << bench << " [options]\n";
+    for (const FBenchOption& option : options)
+    {
+        std::string left = option.Name;
+        if (option.Value) left += std::string(" ") + option.Value;
+        left.resize(width + 2, ' ');
+        std::cout << "  " << left << option.Help << "\n";
+    }
+}
+
+/**
+ * @brief Apply the options found on the command line.
+ * @return false on --help, a missing or rejected value or an unknown option, the caller then
+ *         prints the usage.
+ */
+inline bool ParseBenchArgs(const char* bench, int argc, char** argv, const std::vector<FBenchOption>& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+
+        const auto option = std::find_if(options.begin(), options.end(),
+            [&arg](const FBenchOption& candidate) { return arg == candidate.Name; });
+        if (option == options.end())
+        {
+            std::cerr << "[" << bench << "] Unknown option " << arg << std::endl;
+            return false;
+        }
+        if (option->Value && i + 1 >= argc)
+        {
+            std::cerr << "[" << bench << "] Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        const char* value = option->Value ? argv[++i] : nullptr;
+        if (!option->Apply(value))
+        {
+            std::cerr << "[" << bench << "] Invalid value " << value << " for " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Nearest-rank percentile of sorted samples, p in [0, 100].
+inline double Percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+}
+
+/// Mean, sample standard deviation, extremes and percentiles of samples, in their unit.
+inline nlohmann::ordered_json SummarizeSamples(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double sample : samples) sum += sample;
+    const double mean = samples.empty() ? 0.0 : sum / samples.size();
+
+    double variance = 0.0;
+    for (double sample : samples) variance += (sample - mean) * (sample - mean);
+    variance = samples.size() > 1 ? variance / (samples.size() - 1) : 0.0;
+
+    nlohmann::ordered_json summary;
+    summary["mean"] = mean;
+    summary["stddev"] = std::sqrt(variance);
+    summary["min"] = samples.empty() ? 0.0 : samples.front();
+    summary["p50"] = Percentile(samples, 50.0);
+    summary["p90"] = Percentile(samples, 90.0);
+    summary["p95"] = Percentile(samples, 95.0);
+    summary["p99"] = Percentile(samples, 99.0);
+    summary["max"] = samples.empty() ? 0.0 : samples.back();
+    return summary;
+}
@@ -0,0 +1,588 @@
+// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+// Renders procedural stress scenes along a fixed camera path in a hidden window and reports
+// CPU frame times, GPU pass times and render counters as JSON, to compare builds and see how
+// the engine scales with scene size. Run with --help for the parameters.
+
+#define GLFW_INCLUDE_NONE
+
+#include <Rendering/Rendering.h>
+#include <Rendering/JRenderer.h>
+#include <Framework/PostProcessManager.h>
+#include <Scene/JActor.h>
+#include <Scene/JCamera.h>
+#include <Scene/JLightActor.h>
+#include <Core/JCpuProfiler.h>
+#include "JBenchUtils.h"
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using json = nlohmann::ordered_json;
+
+namespace
+{
+    constexpr float kPi = 3.14159265358979f;
+    constexpr float kNearPlane = 0.1f;
+
+    /// Scene and run parameters, see GetOptions().
+    struct FBenchConfig
+    {
+        int Actors = 256;
+        int Transparent = 16;
+        int Outlined = 4;
+        int Effects = 2;
+        int Lights = 64;
+        int Frames = 600;
+        int WarmupFrames = 60;
+        int Width = 1280;
+        int Height = 720;
+        std::string Model = "cube";
+        std::string Output;
+        bool bShadows = true;
+        bool bDynamicResolution = true;
+    };
+
+    /// Post effects cycled through to build a chain of any length, fusable ones included.
+    constexpr const char* kEffects[] = {
+        "PostProcess/Chroma",
+        "PostProcess/Grayscale",
+        "PostProcess/EdgeDetection",
+        "PostProcess/CRTScanline",
+        nullptr, // Blur
+        "PostProcess/Posterize",
+        "PostProcess/SharpenKernel",
+        "PostProcess/GrainNoise",
+    };
+
+    /// Counters of a pass summed over the frames it ran in.
+    struct FPassTotals
+    {
+        int Depth = 0;
+        uint64_t Frames = 0;
+        FRenderCounters Sum;
+    };
+
+    std::vector<FBenchOption> GetOptions(FBenchConfig& config)
+    {
+        return {
+            MakeIntOption("--actors", "N", "Opaque actors (256)", config.Actors, 0),
+            MakeIntOption("--transparent", "M", "Transparent window actors (16)", config.Transparent, 0),
+            MakeIntOption("--outlined", "K", "Opaque actors drawn with an outline (4)", config.Outlined, 0),
+            MakeIntOption("--effects", "P", "Post effects in the chain (2)", config.Effects, 0),
+            MakeIntOption("--lights", "L", "Clustered point lights (64)", config.Lights, 0),
+            MakeStringOption("--model", "NAME", "Opaque model: cube, dio, window or mix (cube)", config.Model),
+            MakeIntOption("--frames", "F", "Measured frames (600)", config.Frames, 1),
+            MakeIntOption("--warmup", "W", "Frames rendered before measuring (60)", config.WarmupFrames, 0),
+            { "--size", "WxH", "Framebuffer size (1280x720)", [&config](const char* value)
+            {
+                const std::string size = value;
+                const size_t x = size.find('x');
+                if (x == std::string::npos) return false;
+                config.Width = std::max(std::atoi(size.substr(0, x).c_str()), 16);
+                config.Height = std::max(std::atoi(size.substr(x + 1).c_str()), 16);
+                return true;
+            } },
+            MakeFlagOption("--no-shadows", "Skip the shadow cascades", config.bShadows, false),
+            MakeFlagOption("--fixed-resolution", "Render at the framebuffer size, for comparable runs",
+                           config.bDynamicResolution, false),
+            MakeStringOption("--output", "PATH", "JSON report file, stdout if omitted", config.Output),
+        };
+    }
+
+    bool ParseArgs(int argc, char** argv, FBenchConfig& config)
+    {
+        if (!ParseBenchArgs("JGraphicBench", argc, argv, GetOptions(config))) return false;
+
+        if (config.Model != "cube" && config.Model != "dio" && config.Model != "window" && config.Model != "mix")
+        {
+            std::cerr << "[JGraphicBench] Unknown model " << config.Model << std::endl;
+            return false;
+        }
+        config.Outlined = std::min(config.Outlined, config.Actors);
+        return true;
+    }
+
+    json CountersToJson(const FRenderCounters& sum, uint64_t frames)
+    {
+        const double scale = frames > 0 ? 1.0 / static_cast<double>(frames) : 0.0;
+        json counters;
+        counters["draw_calls"] = sum.DrawCalls * scale;
+        counters["instances"] = sum.Instances * scale;
+        counters["triangles"] = sum.Triangles * scale;
+        counters["program_binds"] = sum.ProgramBinds * scale;
+        counters["uniform_sets"] = sum.UniformSets * scale;
+        counters["texture_binds"] = sum.TextureBinds * scale;
+        counters["framebuffer_binds"] = sum.FramebufferBinds * scale;
+        counters["upload_bytes"] = sum.UploadBytes * scale;
+        return counters;
+    }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    /// Spacing of a grid of actors of this model, from its bounds.
+    float GetGridSpacing(const JModel& model)
+    {
+        if (!model.Bounds.IsValid()) return 2.f;
+        const glm::vec3 size = model.Bounds.Max - model.Bounds.Min;
+        return std::max(std::max(size.x, size.z) * 1.25f, 1.f);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FBenchConfig config;
+    if (!ParseArgs(argc, argv, config))
+    {
+        PrintBenchUsage("JGraphicBench", GetOptions(config));
+        return 1;
+    }
+
+    // ----------------- Hidden Window -----------------
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(config.Width, config.Height, "JGraphicBench", nullptr, nullptr);
+    if (!window)
+    {
+        std::cerr << "[JGraphicBench] Failed to create a GL context." << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0); // Never wait for vsync, frame times are the engine's
+    if (!gladLoadGL((GLADloadfunc)glfwGetProcAddress))
+    {
+        std::cerr << "[JGraphicBench] Failed to initialize GLAD." << std::endl;
+        return 1;
+    }
+
+    int fbWidth = 0, fbHeight = 0;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    json report;
+    {
+        // ----------------- Renderer -----------------
+        JRenderer renderer(fbWidth, fbHeight, 4);
+        renderer.SetOutlineMode(EOutlineMode::JumpFlood); // Outlines as the editor draws them
+        // Scaled like the editor renders, --fixed-resolution keeps runs comparable
+        renderer.GetDynamicResolution().SetEnabled(config.bDynamicResolution);
+
+        PostProcessManager postProcess(fbWidth, fbHeight, &renderer.GetTargetPool());
+        postProcess.SetGpuProfiler(&renderer.GetGpuProfiler());
+        for (int i = 0; i < config.Effects; ++i)
+        {
+            const char* effect = kEffects[i % (sizeof(kEffects) / sizeof(kEffects[0]))];
+            if (effect)
+                postProcess.AddProcessor(std::make_unique<JPostProcessor>("PostProcess", effect));
+            else
+                postProcess.AddProcessor(std::make_unique<JBlurProcessor>(EBlurMethod::DualFilter, 6.f));
+        }
+
+        // ----------------- Shaders -----------------
+        JShader litShader("ModelLoadingLit", "ModelLoadingLit");
+        JShader outlineShader("OutlineShader", "BlackColor");
+        JShader instancedShader("ModelLoadingLitInstanced", "ModelLoadingLit");
+        JShader transparentShader("ModelLoadingLit", "ModelLoadingLit", nullptr, "#define OIT_OUTPUT\n");
+        JShader transparentInstancedShader("ModelLoadingLitInstanced", "ModelLoadingLit", nullptr, "#define OIT_OUTPUT\n");
+
+        GLuint uboCamera = 0;
+        glGenBuffers(1, &uboCamera);
+        glBindBuffer(GL_UNIFORM_BUFFER, uboCamera);
+        glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, 0, uboCamera);
+        for (JShader* shader : { &litShader, &outlineShader, &instancedShader, &transparentShader,
+                                 &transparentInstancedShader })
+            shader->LinkUniformBlock("CameraData", 0);
+
+        const glm::vec3 sunDirection(-0.3f, -1.0f, -0.2f);
+        for (JShader* shader : { &litShader, &instancedShader, &transparentShader, &transparentInstancedShader })
+        {
+            shader->Use();
+            shader->SetVec3("DirLight.Direction", sunDirection);
+            shader->SetVec3("DirLight.Ambient", glm::vec3(0.35f));
+            shader->SetVec3("DirLight.Diffuse", glm::vec3(0.6f));
+            shader->SetVec3("DirLight.Specular", glm::vec3(0.2f));
+        }
+
+        JInstanceBatcher instanceBatcher;
+        JFrustumCuller frustumCuller;
+        JSoftwareOcclusion softwareOcclusion;
+        JTransparentSorter transparentSorter;
+        JInstanceBatcher transparentBatcher;
+        transparentBatcher.SetPass(EBatchPass::Transparent);
+        JClusteredLighting clusteredLighting;
+        JCascadedShadows shadows;
+        shadows.SetEnabled(config.bShadows);
+        JSkybox skybox("Sea", "Skybox", "Skybox");
+
+        // ----------------- Models -----------------
+        std::unique_ptr<JModel> cube, dio, windowModel;
+        const bool bMix = config.Model == "mix";
+        if (config.Model == "cube" || bMix) cube = std::make_unique<JModel>("Cube/Cube.obj");
+        if (config.Model == "dio" || bMix) dio = std::make_unique<JModel>("Dio Brando/DioMansion.obj");
+        windowModel = std::make_unique<JModel>("MedievalWindow/MedievalWindow.obj");
+
+        std::vector<JModel*> opaqueModels;
+        if (cube) opaqueModels.push_back(cube.get());
+        if (dio) opaqueModels.push_back(dio.get());
+        if (config.Model == "window" || bMix) opaqueModels.push_back(windowModel.get());
+
+        // ----------------- Scene -----------------
+        // Opaque actors on a square grid, transparent ones on a second grid above it
+        std::vector<JActor> actors;
+        actors.reserve(config.Actors + config.Transparent);
+
+        float spacing = 1.f;
+        for (const JModel* model : opaqueModels)
+            spacing = std::max(spacing, GetGridSpacing(*model));
+        const int side = std::max(static_cast<int>(std::ceil(std::sqrt(static_cast<float>(config.Actors)))), 1);
+        const float extent = side * spacing;
+        for (int i = 0; i < config.Actors; ++i)
+        {
+            JModel* model = opaqueModels[i % opaqueModels.size()];
+            const glm::vec3 position((i % side) * spacing - extent * 0.5f, 0.f, (i / side) * spacing - extent * 0.5f);
+            actors.emplace_back(model, "Actor " + std::to_string(i), position,
+                                glm::vec3(0.f, static_cast<float>(i * 37 % 360), 0.f), glm::vec3(1.f));
+            JActor& actor = actors.back();
+            actor.Config.bIsStatic = true;
+            actor.Config.bIsOccluder = model == dio.get();
+            actor.Config.bDrawOutline = i < config.Outlined;
+        }
+
+        const float windowSpacing = GetGridSpacing(*windowModel);
+        const int windowSide = std::max(static_cast<int>(std::ceil(std::sqrt(static_cast<float>(config.Transparent)))), 1);
+        for (int i = 0; i < config.Transparent; ++i)
+        {
+            const glm::vec3 position((i % windowSide - windowSide * 0.5f) * windowSpacing, spacing,
+                                     (i / windowSide - windowSide * 0.5f) * windowSpacing);
+            actors.emplace_back(windowModel.get(), "Window " + std::to_string(i), position);
+            actors.back().Config.bIsTransparent = true;
+        }
+
+        std::vector<JLightActor> lights;
+        for (int i = 0; i < config.Lights; ++i)
+        {
+            const float angle = i * 2.39996f; // Golden angle spiral over the grid
+            const float radius = extent * 0.5f * std::sqrt((i + 0.5f) / config.Lights);
+            const glm::vec3 color(0.5f + 0.5f * std::sin(i * 0.7f), 0.5f + 0.5f * std::sin(i * 1.3f + 2.f),
+                                  0.5f + 0.5f * std::sin(i * 2.1f + 4.f));
+            lights.emplace_back("Light " + std::to_string(i),
+                                glm::vec3(radius * std::cos(angle), 2.f, radius * std::sin(angle)), color, 6.f);
+            lights.back().Intensity = 8.f;
+        }
+
+        auto drawActor = [&](const JActor& act)
+        {
+            const bool bMark = act.Config.bDrawOutline && renderer.GetOutlineMode() == EOutlineMode::JumpFlood;
+            if (bMark) renderer.GetOutlineRenderer().BeginMark();
+            act.DrawConfig(litShader, outlineShader, !bMark);
+            if (bMark) renderer.GetOutlineRenderer().EndMark();
+        };
+
+        // ----------------- Frames -----------------
+        std::vector<const JActor*> cullActors, queryActors;
+        std::vector<const JLightActor*> activeLights;
+        std::vector<double> frameMs, submitMs;
+        frameMs.reserve(config.Frames);
+        submitMs.reserve(config.Frames);
+        FRenderCounters counterSum;
+        std::map<std::string, FPassTotals> passTotals;
+        std::map<std::string, std::pair<uint64_t, double>> gpuAtStart; // Samples and total ms when measuring began
+
+        // Adds the frame JRenderStats::BeginFrame() just closed to the sums
+        auto accumulateCounters = [&]()
+        {
+            const JRenderStats& renderStats = JRenderStats::Get();
+            counterSum += renderStats.GetLastFrame().Counters;
+            for (const FRenderPassStats& pass : renderStats.GetPasses())
+            {
+                if (!pass.bRanLastFrame) continue;
+                FPassTotals& totals = passTotals[pass.Name];
+                totals.Depth = pass.Depth;
+                ++totals.Frames;
+                totals.Sum += pass.Last;
+            }
+        };
+
+        JGpuProfiler& gpuProfiler = renderer.GetGpuProfiler();
+        JCpuProfiler::Get().SetThreadName("Main");
+
+        const glm::vec3 center(0.f, 1.f, 0.f);
+        const float orbitRadius = extent * 0.6f + 8.f;
+        const float farPlane = std::max(100.f, orbitRadius * 2.f + extent);
+        const int totalFrames = config.WarmupFrames + config.Frames;
+        for (int frame = 0; frame < totalFrames; ++frame)
+        {
+            const bool bMeasured = frame >= config.WarmupFrames;
+            if (frame == config.WarmupFrames)
+            {
+                // Read back every warmup frame so only measured ones add GPU samples
+                glFinish();
+                gpuProfiler.BeginFrame();
+                for (const FGpuPassStats& pass : gpuProfiler.GetPasses())
+                    gpuAtStart[pass.Name] = { pass.SampleCount, pass.TotalMs };
+                gpuProfiler.ResetPeaks();
+            }
+
+            const auto frameBegin = std::chrono::steady_clock::now();
+            JCpuProfiler::Get().BeginFrame();
+            JRenderStats::Get().BeginFrame();
+            if (frame > config.WarmupFrames) accumulateCounters();
+
+            // Fixed path: one orbit over the measured frames, warmup frames lead into it
+            const float t = static_cast<float>(frame - config.WarmupFrames) / config.Frames;
+            const float angle = t * 2.f * kPi;
+            const glm::vec3 eye = center + glm::vec3(std::cos(angle) * orbitRadius, orbitRadius * 0.35f,
+                                                     std::sin(angle) * orbitRadius);
+            const glm::vec3 forward = glm::normalize(center - eye);
+            JCamera camera(eye, glm::vec3(0.f, 1.f, 0.f), glm::degrees(std::atan2(forward.z, forward.x)),
+                           glm::degrees(std::asin(forward.y)));
+
+            const glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom),
+                                                          static_cast<float>(fbWidth) / fbHeight, kNearPlane, farPlane);
+            const glm::mat4 view = camera.GetViewMatrix();
+            glBindBuffer(GL_UNIFORM_BUFFER, uboCamera);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection));
+            glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
+
+            cullActors.clear();
+            for (const JActor& act : actors)
+                cullActors.push_back(&act);
+
+            shadows.Update(camera, static_cast<float>(fbWidth) / fbHeight, kNearPlane, sunDirection);
+            shadows.Render(cullActors);
+
+            renderer.BeginScene();
+
+            frustumCuller.Cull(projection * view, cullActors, nullptr);
+            softwareOcclusion.BeginFrame(projection * view);
+            for (size_t i = 0; i < actors.size(); ++i)
+            {
+                const JActor& act = actors[i];
+                const JModel* occluder = act.OccluderModel ? act.OccluderModel : act.Model;
+                if (act.Config.bIsOccluder && occluder && frustumCuller.IsActorVisible(i))
+                    softwareOcclusion.AddOccluder(*occluder, act.GetModelMatrix());
+            }
+            softwareOcclusion.Rasterize(nullptr);
+            frustumCuller.CullOccluded(softwareOcclusion, nullptr);
+
+            // Lights bob with the frame index, not the clock, so every run sees the same scene
+            const float time = frame / 60.f;
+            activeLights.clear();
+            for (size_t i = 0; i < lights.size(); ++i)
+            {
+                lights[i].Position.y = 2.f + 1.5f * std::sin(time + i * 0.37f);
+                activeLights.push_back(&lights[i]);
+            }
+            clusteredLighting.Build(view, projection, kNearPlane, farPlane, activeLights, nullptr);
+            for (JShader* shader : { &litShader, &instancedShader, &transparentShader, &transparentInstancedShader })
+            {
+                clusteredLighting.Bind(*shader, renderer.GetRenderWidth(), renderer.GetRenderHeight());
+                shadows.Bind(*shader);
+                shader->SetVec3("ViewPos", camera.Position);
+            }
+
+            instanceBatcher.Begin();
+            JOcclusionQueries& occlusionQueries = renderer.GetOcclusionQueries();
+            queryActors.clear();
+
+            const bool bOrderIndependent = renderer.GetTransparencyMode() == ETransparencyMode::WeightedBlended;
+            transparentBatcher.Begin();
+            transparentSorter.Begin(camera.Position);
+            for (size_t i = 0; i < actors.size(); ++i)
+            {
+                if (!frustumCuller.IsActorVisible(i)) continue;
+
+                const JActor& act = actors[i];
+                queryActors.push_back(&act);
+                if (!occlusionQueries.ShouldSubmit(act)) continue;
+
+                if (act.Config.bIsTransparent)
+                {
+                    if (!bOrderIndependent || !transparentBatcher.Submit(act, frustumCuller.GetMeshVisibility(i)))
+                        transparentSorter.Add(static_cast<uint32_t>(i), act, frustumCuller.GetMeshVisibility(i));
+                }
+                else if (!instanceBatcher.Submit(act, frustumCuller.GetMeshVisibility(i)))
+                {
+                    const bool bConditional = occlusionQueries.BeginConditionalDraw(act);
+                    drawActor(act);
+                    if (bConditional) occlusionQueries.EndConditionalDraw();
+                }
+            }
+
+            instanceBatcher.Flush(instancedShader);
+            occlusionQueries.IssueQueries(queryActors, camera.Position);
+            transparentSorter.Sort();
+
+            if (!bOrderIndependent)
+            {
+                for (size_t i = 0; i < transparentSorter.GetCount(); ++i)
+                {
+                    const FTransparentItem& item = transparentSorter.GetSorted(i);
+                    const JActor& act = actors[item.ActorIndex];
+                    if (item.MeshIndex < 0)
+                        drawActor(act);
+                    else
+                        act.DrawMesh(litShader, static_cast<size_t>(item.MeshIndex));
+                }
+            }
+
+            skybox.Draw(view, projection);
+
+            if (bOrderIndependent)
+            {
+                renderer.BeginTransparency();
+                transparentBatcher.Flush(transparentInstancedShader);
+                for (size_t i = 0; i < transparentSorter.GetCount(); ++i)
+                {
+                    const FTransparentItem& item = transparentSorter.GetSorted(i);
+                    const JActor& act = actors[item.ActorIndex];
+                    if (item.MeshIndex < 0)
+                        act.Draw(transparentShader);
+                    else
+                        act.DrawMesh(transparentShader, static_cast<size_t>(item.MeshIndex));
+                }
+                renderer.EndTransparency();
+            }
+
+            renderer.EndScene();
+            postProcess.ApplyChain(renderer.GetSceneTarget(), fbWidth, fbHeight, nullptr);
+
+            const auto submitEnd = std::chrono::steady_clock::now();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+
+            if (bMeasured)
+            {
+                const auto frameEnd = std::chrono::steady_clock::now();
+                frameMs.push_back(ElapsedMs(frameBegin, frameEnd));
+                submitMs.push_back(ElapsedMs(frameBegin, submitEnd));
+            }
+        }
+
+        // Close the last frame and read back every GPU frame still in flight
+        glFinish();
+        gpuProfiler.BeginFrame();
+        JRenderStats::Get().BeginFrame();
+        accumulateCounters();
+
+        // ----------------- Report -----------------
+        json& cfg = report["config"];
+        cfg["actors"] = config.Actors;
+        cfg["transparent"] = config.Transparent;
+        cfg["outlined"] = config.Outlined;
+        cfg["effects"] = config.Effects;
+        cfg["lights"] = config.Lights;
+        cfg["model"] = config.Model;
+        cfg["shadows"] = config.bShadows;
+        cfg["dynamic_resolution"] = config.bDynamicResolution;
+        cfg["frames"] = config.Frames;
+        cfg["warmup"] = config.WarmupFrames;
+        cfg["width"] = fbWidth;
+        cfg["height"] = fbHeight;
+
+        const char* glRenderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        const char* glVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        report["device"]["renderer"] = glRenderer ? glRenderer : "";
+        report["device"]["version"] = glVersion ? glVersion : "";
+
+        const FDynamicResolutionState& resolution = renderer.GetDynamicResolution().GetState();
+        report["resolution"]["final_scale"] = resolution.Scale;
+        report["resolution"]["adjustments"] = resolution.Adjustments;
+
+        report["cpu"]["frame_ms"] = SummarizeSamples(frameMs);
+        report["cpu"]["submit_ms"] = SummarizeSamples(submitMs);
+
+        // GPU passes: mean of the samples read back while measuring
+        json gpuPasses = json::array();
+        double gpuTotal = 0.0;
+        for (const FGpuPassStats& pass : gpuProfiler.GetPasses())
+        {
+            const auto start = gpuAtStart.find(pass.Name);
+            const uint64_t startSamples = start != gpuAtStart.end() ? start->second.first : 0;
+            const double startMs = start != gpuAtStart.end() ? start->second.second : 0.0;
+            const uint64_t samples = pass.SampleCount - startSamples;
+            if (samples == 0) continue;
+
+            const double meanMs = (pass.TotalMs - startMs) / static_cast<double>(samples);
+            if (pass.Depth == 0) gpuTotal += meanMs;
+
+            json entry;
+            entry["name"] = pass.Name;
+            entry["depth"] = pass.Depth;
+            entry["mean_ms"] = meanMs;
+            entry["max_ms"] = pass.PeakMs; // Whole run, MaxMs only covers the rolling history
+            entry["samples"] = samples;
+            gpuPasses.push_back(entry);
+        }
+        report["gpu"]["total_ms"] = gpuTotal;
+        report["gpu"]["passes"] = gpuPasses;
+
+        report["counters"]["per_frame"] = CountersToJson(counterSum, static_cast<uint64_t>(config.Frames));
+        json counterPasses = json::array();
+        for (const FRenderPassStats& pass : JRenderStats::Get().GetPasses())
+        {
+            const auto totals = passTotals.find(pass.Name);
+            if (totals == passTotals.end()) continue;
+
+            json entry;
+            entry["name"] = pass.Name;
+            entry["depth"] = totals->second.Depth;
+            entry["frames"] = totals->second.Frames;
+            entry["per_frame"] = CountersToJson(totals->second.Sum, totals->second.Frames);
+            counterPasses.push_back(entry);
+        }
+        report["counters"]["passes"] = counterPasses;
+
+        const FRenderGraphStats& graphStats = postProcess.GetGraphStats();
+        report["post_process"]["graph_passes"] = graphStats.Passes;
+        report["post_process"]["transient_textures"] = graphStats.TransientTextures;
+        report["post_process"]["pooled_bytes"] = graphStats.PooledBytes;
+
+        glDeleteBuffers(1, &uboCamera);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    if (config.Output.empty())
+    {
+        std::cout << report.dump(2) << std::endl;
+        return 0;
+    }
+
+    std::ofstream file(config.Output, std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "[JGraphicBench] Could not open '" << config.Output << "' for writing." << std::endl;
+        return 1;
+    }
+    file << report.dump(2) << std::endl;
+    std::cout << "[JGraphicBench] Wrote " << config.Output << std::endl;
+    return 0;
+}
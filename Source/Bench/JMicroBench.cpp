@@ -0,0 +1,376 @@
+// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+// Times CPU-only engine kernels (actor transforms, scene serialization and loading, mesh
+// conversion, image decoding) in isolation and reports per-operation percentiles as JSON, to
+// catch regressions in the hot paths that JGraphicBench only sees folded into frame times.
+// Needs no GL context. Run with --help for the parameters.
+
+#include <Rendering/Rendering.h>
+#include <Framework/SceneManager.h>
+#include <Scene/JActor.h>
+#include "JBenchUtils.h"
+#include <stb/stb_image.h>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using json = nlohmann::ordered_json;
+
+namespace
+{
+    constexpr int kMatrixActors = 4096;
+    constexpr int kSceneActors = 2048;
+    constexpr uint64_t kMaxIterations = uint64_t(1) << 30;
+
+    /// Run parameters, see GetOptions().
+    struct FMicroConfig
+    {
+        std::string Filter;
+        std::string Output;
+        int Repetitions = 30;
+        int WarmupRepetitions = 3;
+        double MinTimeMs = 10.0;
+        bool bList = false;
+    };
+
+    /// A prepared kernel: Run() is one operation, processing Items items.
+    struct FKernel
+    {
+        std::function<void()> Run;
+        uint64_t Items = 1;
+        const char* ItemName = "op";
+    };
+
+    /// A named kernel, prepared only if it passes the filter. Prepare() leaves Run empty to skip.
+    struct FKernelDesc
+    {
+        const char* Name;
+        std::function<FKernel()> Prepare;
+    };
+
+    /** @brief Forces the value to be computed, so the compiler can't drop the work producing it. */
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    std::vector<FBenchOption> GetOptions(FMicroConfig& config)
+    {
+        return {
+            MakeStringOption("--filter", "TEXT", "Only run kernels whose name contains TEXT", config.Filter),
+            MakeIntOption("--repetitions", "N", "Timed repetitions per kernel (30)", config.Repetitions, 1),
+            MakeIntOption("--warmup", "N", "Untimed repetitions before measuring (3)", config.WarmupRepetitions, 0),
+            { "--min-time-ms", "T", "Least time of a repetition, sets the operations per repetition (10)",
+              [&config](const char* value)
+            {
+                config.MinTimeMs = std::max(std::atof(value), 0.01);
+                return true;
+            } },
+            MakeFlagOption("--list", "Print the kernel names and exit", config.bList, true),
+            MakeStringOption("--output", "PATH", "JSON report file, stdout if omitted", config.Output),
+        };
+    }
+
+    std::string GetAssetPath(const std::string& relative)
+    {
+        return std::string(ENGINE_DIRECTORY) + "/Assets/" + relative;
+    }
+
+    bool ReadFileBytes(const std::string& path, std::vector<unsigned char>& outBytes)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        outBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !outBytes.empty();
+    }
+
+    /// Scene in the .jscene layout with actors spread over a grid, seeded for reproducible runs.
+    nlohmann::json MakeSceneJson(int actors)
+    {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> angle(0.f, 360.f);
+
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(actors))));
+        nlohmann::json scene;
+        scene["name"] = "MicroBench";
+        scene["next_actor_id"] = actors + 1;
+        scene["actor_count"] = actors;
+        scene["actors"] = nlohmann::json::array();
+        for (int i = 0; i < actors; ++i)
+        {
+            nlohmann::json actor;
+            actor["id"] = i + 1;
+            actor["vector_index"] = i;
+            actor["name"] = "Actor_" + std::to_string(i);
+            actor["position"] = { {"x", (i % side) * 2.f}, {"y", 0.f}, {"z", (i / side) * 2.f} };
+            actor["rotation"] = { {"x", angle(random)}, {"y", angle(random)}, {"z", angle(random)} };
+            scene["actors"].push_back(actor);
+        }
+        return scene;
+    }
+
+    // --------------------- Kernels ---------------------
+    FKernel PrepareModelMatrix()
+    {
+        auto actors = std::make_shared<std::vector<JActor>>(kMatrixActors);
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-100.f, 100.f);
+        std::uniform_real_distribution<float> angle(0.f, 360.f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.f);
+        for (JActor& actor : *actors)
+        {
+            actor.Position = glm::vec3(position(random), position(random), position(random));
+            actor.Rotation = glm::vec3(angle(random), angle(random), angle(random));
+            actor.Scale = glm::vec3(scale(random));
+        }
+
+        FKernel kernel;
+        kernel.Items = actors->size();
+        kernel.ItemName = "matrix";
+        kernel.Run = [actors]()
+        {
+            for (const JActor& actor : *actors)
+            {
+                const glm::mat4 model = actor.GetModelMatrix();
+                DoNotOptimize(model);
+            }
+        };
+        return kernel;
+    }
+
+    FKernel PrepareSceneSerialize()
+    {
+        auto manager = std::make_shared<SceneManager>();
+        JScene* scene = manager->LoadSceneJson(MakeSceneJson(kSceneActors));
+        JActor* moved = scene->FindActorByID(1);
+
+        FKernel kernel;
+        kernel.Items = kSceneActors;
+        kernel.ItemName = "actor";
+        kernel.Run = [manager, scene, moved]()
+        {
+            // A move dirties the scene, so each operation rebuilds the JSON instead of returning the cache
+            manager->SetActorTransform(moved, moved->Position + glm::vec3(0.001f), moved->Rotation, moved->Scale);
+            const nlohmann::json data = manager->SerializeScene(scene);
+            DoNotOptimize(data);
+        };
+        return kernel;
+    }
+
+    FKernel PrepareSceneLoad()
+    {
+        auto manager = std::make_shared<SceneManager>();
+        auto text = std::make_shared<std::string>(MakeSceneJson(kSceneActors).dump(4)); // As written by SaveSceneFile()
+
+        FKernel kernel;
+        kernel.Items = kSceneActors;
+        kernel.ItemName = "actor";
+        kernel.Run = [manager, text]()
+        {
+            const JScene* scene = manager->LoadSceneJson(nlohmann::json::parse(*text));
+            DoNotOptimize(scene);
+        };
+        return kernel;
+    }
+
+    FKernel PrepareConvertMesh()
+    {
+        auto importer = std::make_shared<Assimp::Importer>();
+        const aiScene* scene = importer->ReadFile(GetAssetPath("Meshes/Dio Brando/DioMansion.obj").c_str(), JModel::ImportFlags);
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
+        {
+            std::cerr << "[JMicroBench] Could not import DioMansion.obj: " << importer->GetErrorString() << std::endl;
+            return FKernel();
+        }
+
+        FKernel kernel;
+        kernel.Items = 0;
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+            kernel.Items += scene->mMeshes[i]->mNumVertices;
+        kernel.ItemName = "vertex";
+        kernel.Run = [importer, scene]()
+        {
+            // Fresh vectors per mesh, as JModel::ProcessMesh() does
+            for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+            {
+                std::vector<S_Vertex> vertices;
+                std::vector<unsigned int> indices;
+                JModel::ConvertMesh(scene->mMeshes[i], vertices, indices);
+                DoNotOptimize(vertices.data());
+                DoNotOptimize(indices.data());
+            }
+        };
+        return kernel;
+    }
+
+    FKernel PrepareImageDecode(const std::string& relativePath)
+    {
+        auto bytes = std::make_shared<std::vector<unsigned char>>();
+        int width = 0, height = 0, channels = 0;
+        if (!ReadFileBytes(GetAssetPath(relativePath), *bytes) ||
+            !stbi_info_from_memory(bytes->data(), static_cast<int>(bytes->size()), &width, &height, &channels))
+        {
+            std::cerr << "[JMicroBench] Could not read image " << relativePath << std::endl;
+            return FKernel();
+        }
+
+        FKernel kernel;
+        kernel.Items = static_cast<uint64_t>(width) * height;
+        kernel.ItemName = "pixel";
+        kernel.Run = [bytes]()
+        {
+            // Same call as the texture loaders, native channel count
+            int w = 0, h = 0, n = 0;
+            unsigned char* pixels = stbi_load_from_memory(bytes->data(), static_cast<int>(bytes->size()), &w, &h, &n, 0);
+            DoNotOptimize(pixels);
+            stbi_image_free(pixels);
+        };
+        return kernel;
+    }
+
+    std::vector<FKernelDesc> GetKernels()
+    {
+        return {
+            { "actor/model_matrix", PrepareModelMatrix },
+            { "scene/serialize", PrepareSceneSerialize },
+            { "scene/load_json", PrepareSceneLoad },
+            { "model/convert_mesh", PrepareConvertMesh },
+            { "image/decode_png", [] { return PrepareImageDecode("Meshes/Cube/Cube.png"); } },
+            { "image/decode_jpg", [] { return PrepareImageDecode("Skyboxes/Sea/front.jpg"); } },
+        };
+    }
+
+    // --------------------- Harness ---------------------
+    /// Wall time of iterations back to back runs, in nanoseconds.
+    double TimeIterations(const FKernel& kernel, uint64_t iterations)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i)
+            kernel.Run();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - begin).count();
+    }
+
+    /// Operations per repetition so that one lasts at least minTimeMs, doubling from a single one.
+    uint64_t CalibrateIterations(const FKernel& kernel, double minTimeMs)
+    {
+        const double minTimeNs = minTimeMs * 1e6;
+        uint64_t iterations = 1;
+        while (iterations < kMaxIterations)
+        {
+            const double elapsed = TimeIterations(kernel, iterations);
+            if (elapsed >= minTimeNs) break;
+
+            // Aim slightly past the target from the measured rate, at least doubling
+            const double perIteration = std::max(elapsed / static_cast<double>(iterations), 1.0);
+            const uint64_t estimate = static_cast<uint64_t>(minTimeNs * 1.2 / perIteration);
+            iterations = std::min(std::max(iterations * 2, estimate), kMaxIterations);
+        }
+        return iterations;
+    }
+
+    json RunKernel(const char* name, const FKernel& kernel, const FMicroConfig& config)
+    {
+        const uint64_t iterations = CalibrateIterations(kernel, config.MinTimeMs);
+        for (int i = 0; i < config.WarmupRepetitions; ++i)
+            TimeIterations(kernel, iterations);
+
+        std::vector<double> nsPerOp;
+        nsPerOp.reserve(config.Repetitions);
+        for (int i = 0; i < config.Repetitions; ++i)
+            nsPerOp.push_back(TimeIterations(kernel, iterations) / static_cast<double>(iterations));
+
+        json result;
+        result["name"] = name;
+        result["item"] = kernel.ItemName;
+        result["items_per_op"] = kernel.Items;
+        result["ops_per_repetition"] = iterations;
+        result["ns_per_op"] = SummarizeSamples(nsPerOp);
+
+        const double median = result["ns_per_op"]["p50"].get<double>();
+        const double items = static_cast<double>(std::max<uint64_t>(kernel.Items, 1));
+        result["ns_per_item"] = median / items;
+        result["items_per_second"] = median > 0.0 ? items * 1e9 / median : 0.0;
+
+        std::cerr << "[JMicroBench] " << name << ": " << median / 1e3 << " us/op (p50), "
+                  << median / items << " ns/" << kernel.ItemName << std::endl;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FMicroConfig config;
+    if (!ParseBenchArgs("JMicroBench", argc, argv, GetOptions(config)))
+    {
+        PrintBenchUsage("JMicroBench", GetOptions(config));
+        return 1;
+    }
+
+    const std::vector<FKernelDesc> kernels = GetKernels();
+    if (config.bList)
+    {
+        for (const FKernelDesc& desc : kernels)
+            std::cout << desc.Name << "\n";
+        return 0;
+    }
+
+    json report;
+    report["config"] = {
+        {"filter", config.Filter},
+        {"repetitions", config.Repetitions},
+        {"warmup_repetitions", config.WarmupRepetitions},
+        {"min_time_ms", config.MinTimeMs},
+    };
+    report["kernels"] = json::array();
+
+    for (const FKernelDesc& desc : kernels)
+    {
+        if (!config.Filter.empty() && std::string(desc.Name).find(config.Filter) == std::string::npos) continue;
+
+        const FKernel kernel = desc.Prepare();
+        if (!kernel.Run)
+        {
+            std::cerr << "[JMicroBench] Skipped " << desc.Name << std::endl;
+            continue;
+        }
+        report["kernels"].push_back(RunKernel(desc.Name, kernel, config));
+    }
+
+    if (config.Output.empty())
+    {
+        std::cout << report.dump(2) << std::endl;
+        return 0;
+    }
+
+    std::ofstream file(config.Output, std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "[JMicroBench] Could not open '" << config.Output << "' for writing." << std::endl;
+        return 1;
+    }
+    file << report.dump(2) << std::endl;
+    std::cout << "[JMicroBench] Wrote " << config.Output << std::endl;
+    return 0;
+}
@@ -5,12 +5,20 @@
 #include <EditorContext.h>
 #include <ImGuiLayer.h>
 #include <Panels/SceneHierarchyPanel.h>
+#include <Panels/CpuProfilerPanel.h>
+#include <Panels/GpuProfilerPanel.h>
+#include <Panels/RenderStatsPanel.h>
+#include <Core/JCpuProfiler.h>
+#include <Rendering/Rendering.h>
 
 EditorApp::EditorApp(GLFWwindow* window)
 {
     m_Context = std::make_unique<EditorContext>(GEngine->GetState());
     m_ImGuiLayer = std::make_unique<ImGuiLayer>(window);
     m_SceneHierarchyPanel = std::make_unique<SceneHierarchyPanel>();
+    m_CpuProfilerPanel = std::make_unique<CpuProfilerPanel>();
+    m_GpuProfilerPanel = std::make_unique<GpuProfilerPanel>();
+    m_RenderStatsPanel = std::make_unique<RenderStatsPanel>();
 }
 
 EditorApp::~EditorApp() = default;
@@ -23,6 +31,10 @@ void EditorApp::BeginFrame()
 void EditorApp::RenderPanels()
 {
     m_SceneHierarchyPanel->Draw(*m_Context);
+    m_CpuProfilerPanel->Draw(JCpuProfiler::Get());
+    if (m_GpuProfiler)
+        m_GpuProfilerPanel->Draw(*m_GpuProfiler);
+    m_RenderStatsPanel->Draw(JRenderStats::Get());
 }
 
 void EditorApp::EndFrame()
@@ -0,0 +1,99 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "CpuProfilerPanel.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "imgui.h"
+#include "Core/JCpuProfiler.h"
+
+namespace
+{
+    constexpr float kRowHeight = 18.f;
+    constexpr float kThreadLabelWidth = 80.f;
+
+    /// Stable color per zone name.
+    ImU32 GetZoneColor(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (const char* c = name; *c; ++c)
+            hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+        return IM_COL32(90 + hash % 120, 90 + (hash >> 8) % 120, 90 + (hash >> 16) % 120, 255);
+    }
+}
+
+void CpuProfilerPanel::Draw(JCpuProfiler& profiler)
+{
+    ImGui::Begin("CPU Profiler");
+
+    bool bEnabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Record", &bEnabled))
+        profiler.SetEnabled(bEnabled);
+    ImGui::SameLine();
+    ImGui::SliderInt("Frames", &m_CaptureFrames, 1, JCpuProfiler::MaxCaptureFrames);
+    ImGui::SameLine();
+    if (!profiler.IsCapturing() && ImGui::Button("Capture Trace"))
+        profiler.RequestCapture("Captures/Trace" + std::to_string(m_CaptureCount++) + ".json", m_CaptureFrames);
+    if (profiler.IsCapturing())
+        ImGui::Text("Capturing...");
+    else if (!profiler.GetLastCapturePath().empty())
+        ImGui::Text("Last trace: %s", profiler.GetLastCapturePath().c_str());
+
+    const std::vector<FCpuZoneEvent>& events = profiler.GetFrameEvents();
+    const uint64_t frameBegin = profiler.GetFrameBegin();
+    const double frameUs = profiler.ToMicroseconds(profiler.GetFrameEnd() - frameBegin);
+    ImGui::Text("Frame: %.2f ms, %zu zones, %llu dropped", frameUs * 1e-3, events.size(),
+                static_cast<unsigned long long>(profiler.GetDroppedEvents()));
+    ImGui::SliderFloat("Zoom", &m_Zoom, 1.f, 50.f, "%.1fx");
+
+    if (events.empty() || frameUs <= 0.0)
+    {
+        ImGui::End();
+        return;
+    }
+
+    // Rows per thread, one per nesting level
+    const std::vector<std::string> threads = profiler.GetThreadNames();
+    std::vector<uint32_t> depths(threads.size(), 0);
+    for (const FCpuZoneEvent& event : events)
+        depths[event.Thread] = std::max(depths[event.Thread], event.Depth + 1);
+
+    ImGui::BeginChild("Timeline", ImVec2(0.f, 0.f), false, ImGuiWindowFlags_HorizontalScrollbar);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = (ImGui::GetContentRegionAvail().x - kThreadLabelWidth) * m_Zoom;
+    const float pixelsPerUs = static_cast<float>(width / frameUs);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    std::vector<float> rowTop(threads.size(), 0.f);
+    float height = 0.f;
+    for (size_t t = 0; t < threads.size(); ++t)
+    {
+        rowTop[t] = height;
+        if (depths[t] == 0) continue;
+        drawList->AddText(ImVec2(origin.x, origin.y + height), IM_COL32(200, 200, 200, 255), threads[t].c_str());
+        height += depths[t] * kRowHeight + 4.f;
+    }
+
+    for (const FCpuZoneEvent& event : events)
+    {
+        // Zones that began in an earlier frame are clipped to the frame
+        const double beginUs = event.Begin > frameBegin ? profiler.ToMicroseconds(event.Begin - frameBegin) : 0.0;
+        const double endUs = event.End > frameBegin ? profiler.ToMicroseconds(event.End - frameBegin) : 0.0;
+        const ImVec2 min(origin.x + kThreadLabelWidth + static_cast<float>(beginUs) * pixelsPerUs,
+                         origin.y + rowTop[event.Thread] + event.Depth * kRowHeight);
+        const ImVec2 max(std::max(min.x + 1.f, origin.x + kThreadLabelWidth + static_cast<float>(endUs) * pixelsPerUs),
+                         min.y + kRowHeight - 1.f);
+
+        drawList->AddRectFilled(min, max, GetZoneColor(event.Name));
+        if (max.x - min.x > ImGui::CalcTextSize(event.Name).x + 4.f)
+            drawList->AddText(ImVec2(min.x + 2.f, min.y + 2.f), IM_COL32(0, 0, 0, 255), event.Name);
+        if (ImGui::IsMouseHoveringRect(min, max))
+            ImGui::SetTooltip("%s\n%.3f ms", event.Name, (endUs - beginUs) * 1e-3);
+    }
+
+    ImGui::Dummy(ImVec2(kThreadLabelWidth + width, height));
+    ImGui::EndChild();
+
+    ImGui::End();
+}
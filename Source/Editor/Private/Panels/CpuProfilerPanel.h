@@ -0,0 +1,17 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+class JCpuProfiler;
+
+class CpuProfilerPanel
+{
+public:
+
+    void Draw(JCpuProfiler& profiler);
+
+private:
+    int m_CaptureFrames = 120;
+    int m_CaptureCount = 0;
+    float m_Zoom = 1.f;
+};
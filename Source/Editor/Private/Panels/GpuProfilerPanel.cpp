@@ -0,0 +1,53 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "GpuProfilerPanel.h"
+
+#include "imgui.h"
+#include "Rendering/Rendering.h"
+
+void GpuProfilerPanel::Draw(JGpuProfiler& profiler)
+{
+    ImGui::Begin("GPU Profiler");
+
+    bool bEnabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &bEnabled))
+        profiler.SetEnabled(bEnabled);
+    ImGui::SameLine();
+    ImGui::Text("Total %.2f ms, %d frames pending", profiler.GetTotalMs(), profiler.GetPendingFrames());
+
+    const float total = profiler.GetTotalMs();
+    if (ImGui::BeginTable("Passes", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+    {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("Average");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableSetupColumn("History");
+        ImGui::TableHeadersRow();
+
+        for (const FGpuPassStats& pass : profiler.GetPasses())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Indent(pass.Depth * 12.f + 1.f);
+            ImGui::TextUnformatted(pass.Name.c_str());
+            ImGui::Unindent(pass.Depth * 12.f + 1.f);
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f ms (%.0f%%)", pass.AverageMs, total > 0.f ? pass.AverageMs / total * 100.f : 0.f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f ms", pass.MaxMs);
+
+            ImGui::TableNextColumn();
+            if (!pass.History.empty())
+            {
+                ImGui::PushID(pass.Name.c_str());
+                ImGui::PlotLines("##History", pass.History.data(), static_cast<int>(pass.History.size()),
+                                 pass.HistoryHead, nullptr, 0.f, pass.MaxMs * 1.1f, ImVec2(-1.f, 18.f));
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,12 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+class JGpuProfiler;
+
+class GpuProfilerPanel
+{
+public:
+
+    void Draw(JGpuProfiler& profiler);
+};
@@ -0,0 +1,102 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "RenderStatsPanel.h"
+
+#include <algorithm>
+#include <string>
+#include "imgui.h"
+#include "Rendering/Rendering.h"
+
+namespace
+{
+    constexpr float kOverlayMargin = 10.f;
+    constexpr int kCsvFrames = 600;
+
+    unsigned long long ToULL(uint64_t value)
+    {
+        return static_cast<unsigned long long>(value);
+    }
+}
+
+void RenderStatsPanel::Draw(JRenderStats& stats)
+{
+    // Small translucent overlay pinned to the top right corner of the viewport
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - kOverlayMargin,
+                                   viewport->WorkPos.y + kOverlayMargin), ImGuiCond_Always, ImVec2(1.f, 0.f));
+    ImGui::SetNextWindowBgAlpha(0.6f);
+    const int flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                      ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                      ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+    ImGui::Begin("Render Stats", nullptr, flags);
+
+    const FRenderFrameStats& last = stats.GetLastFrame();
+    const FRenderFrameStats average = stats.GetAverage();
+    const FRenderCounters& counters = last.Counters;
+    ImGui::Text("%.2f ms (avg %.2f ms)", last.FrameMs, average.FrameMs);
+    ImGui::Text("Draws %llu (avg %llu), %llu instances", ToULL(counters.DrawCalls),
+                ToULL(average.Counters.DrawCalls), ToULL(counters.Instances));
+    ImGui::Text("Triangles %.2f M", counters.Triangles / 1e6);
+    ImGui::Text("Programs %llu, uniforms %llu", ToULL(counters.ProgramBinds), ToULL(counters.UniformSets));
+    ImGui::Text("Textures %llu, framebuffers %llu", ToULL(counters.TextureBinds), ToULL(counters.FramebufferBinds));
+    ImGui::Text("Uploaded %.1f KB", counters.UploadBytes / 1024.0);
+
+    // Draw calls over the history, oldest first
+    const std::vector<FRenderFrameStats> history = stats.GetHistory();
+    m_DrawCallHistory.clear();
+    float peak = 1.f;
+    for (const FRenderFrameStats& frame : history)
+    {
+        m_DrawCallHistory.push_back(static_cast<float>(frame.Counters.DrawCalls));
+        peak = std::max(peak, m_DrawCallHistory.back());
+    }
+    if (!m_DrawCallHistory.empty())
+        ImGui::PlotLines("##DrawCalls", m_DrawCallHistory.data(), static_cast<int>(m_DrawCallHistory.size()), 0,
+                         "Draw calls", 0.f, peak * 1.1f, ImVec2(220.f, 32.f));
+
+    ImGui::Checkbox("Passes", &m_bShowPasses);
+    ImGui::SameLine();
+    if (stats.IsWritingCsv())
+    {
+        if (ImGui::Button("Stop CSV"))
+            stats.StopCsv();
+    }
+    else if (ImGui::Button("Dump CSV"))
+    {
+        stats.StartCsv("Captures/RenderStats" + std::to_string(m_CsvCount++) + ".csv", kCsvFrames);
+    }
+
+    if (m_bShowPasses &&
+        ImGui::BeginTable("Passes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+    {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("Draws");
+        ImGui::TableSetupColumn("Triangles");
+        ImGui::TableSetupColumn("Binds");
+        ImGui::TableSetupColumn("Uniforms");
+        ImGui::TableHeadersRow();
+
+        for (const FRenderPassStats& pass : stats.GetPasses())
+        {
+            if (!pass.bRanLastFrame) continue;
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Indent(pass.Depth * 12.f + 1.f);
+            ImGui::TextUnformatted(pass.Name.c_str());
+            ImGui::Unindent(pass.Depth * 12.f + 1.f);
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu (peak %llu)", ToULL(pass.Last.DrawCalls), ToULL(pass.PeakDrawCalls));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", ToULL(pass.Last.Triangles));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", ToULL(pass.Last.ProgramBinds + pass.Last.TextureBinds + pass.Last.FramebufferBinds));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", ToULL(pass.Last.UniformSets));
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,19 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <vector>
+
+class JRenderStats;
+
+class RenderStatsPanel
+{
+public:
+
+    void Draw(JRenderStats& stats);
+
+private:
+    bool m_bShowPasses = false;
+    int m_CsvCount = 0;
+    std::vector<float> m_DrawCallHistory; ///< Scratch for the plot
+};
@@ -4,6 +4,10 @@
 struct GLFWwindow;
 class EditorContext;
 class ImGuiLayer;
+class CpuProfilerPanel;
+class GpuProfilerPanel;
+class RenderStatsPanel;
+class JGpuProfiler;
 class SceneHierarchyPanel;
 
 class EditorApp
@@ -17,8 +21,15 @@ public:
     void EndFrame();
     void Shutdown();
 
+    /// Show the timings of profiler in a panel, null hides it.
+    void SetGpuProfiler(JGpuProfiler* profiler) { m_GpuProfiler = profiler; }
+
 private:
     std::unique_ptr<EditorContext> m_Context;
     std::unique_ptr<ImGuiLayer> m_ImGuiLayer;
     std::unique_ptr<SceneHierarchyPanel> m_SceneHierarchyPanel;
+    std::unique_ptr<CpuProfilerPanel> m_CpuProfilerPanel;
+    std::unique_ptr<GpuProfilerPanel> m_GpuProfilerPanel;
+    std::unique_ptr<RenderStatsPanel> m_RenderStatsPanel;
+    JGpuProfiler* m_GpuProfiler = nullptr;
 };
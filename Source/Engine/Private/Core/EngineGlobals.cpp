@@ -2,6 +2,11 @@
 
 #include "Core/EngineGlobals.h"
 #include "Core/JEngine.h"
+#include "Core/JJobSystem.h"
 
 JEngine* GEngine = nullptr;
 
+JJobSystem* GetJobSystem()
+{
+    return (GEngine) ? GEngine->GetService<JJobSystem>() : nullptr;
+}
@@ -0,0 +1,277 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "Core/JCpuProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define J_PROFILER_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define J_PROFILER_RDTSC 1
+#else
+#define J_PROFILER_RDTSC 0
+#endif
+
+namespace
+{
+    /// Calibration window below which the tick rate isn't updated, in nanoseconds.
+    constexpr int64_t kMinCalibrationNanoseconds = 10'000'000;
+
+    int64_t GetSteadyNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void WriteJsonString(std::ostream& out, const std::string& text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+}
+
+/// Events of one thread. The thread writes at Head, BeginFrame() reads from Tail.
+struct JCpuProfiler::FThreadRing
+{
+    std::unique_ptr<FCpuZoneEvent[]> Events{ new FCpuZoneEvent[RingCapacity] };
+    std::atomic<uint64_t> Head{ 0 };
+    std::atomic<uint64_t> Tail{ 0 };
+    std::atomic<uint64_t> Dropped{ 0 };
+    uint32_t Index = 0;
+    uint32_t Depth = 0; ///< Owning thread only
+    std::string Name;   ///< Guarded by RingsMutex
+};
+
+std::atomic<bool> JCpuProfiler::bRecording{ false };
+thread_local JCpuProfiler::FThreadRing* JCpuProfiler::ThreadRing = nullptr;
+
+namespace
+{
+    /// Name given before the thread's first zone, its ring isn't allocated until then.
+    thread_local std::string tThreadName;
+}
+
+JCpuProfiler& JCpuProfiler::Get()
+{
+    static JCpuProfiler instance;
+    return instance;
+}
+
+JCpuProfiler::JCpuProfiler()
+{
+    CalibrationTicks = Now();
+    CalibrationNanoseconds = GetSteadyNanoseconds();
+}
+
+JCpuProfiler::~JCpuProfiler() = default;
+
+uint64_t JCpuProfiler::Now()
+{
+#if J_PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(GetSteadyNanoseconds());
+#endif
+}
+
+// --------------------- Zones ---------------------
+uint64_t JCpuProfiler::BeginZone()
+{
+    ++Get().GetThreadRing().Depth;
+    return Now();
+}
+
+void JCpuProfiler::EndZone(const char* name, uint64_t begin)
+{
+    const uint64_t end = Now();
+    FThreadRing& ring = Get().GetThreadRing();
+    if (ring.Depth > 0) --ring.Depth;
+
+    const uint64_t head = ring.Head.load(std::memory_order_relaxed);
+    if (head - ring.Tail.load(std::memory_order_acquire) >= RingCapacity)
+    {
+        ring.Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    FCpuZoneEvent& event = ring.Events[head % RingCapacity];
+    event.Name = name;
+    event.Begin = begin;
+    event.End = end;
+    event.Thread = ring.Index;
+    event.Depth = ring.Depth;
+    ring.Head.store(head + 1, std::memory_order_release);
+}
+
+JCpuProfiler::FThreadRing& JCpuProfiler::GetThreadRing()
+{
+    if (ThreadRing) return *ThreadRing;
+
+    std::lock_guard<std::mutex> lock(RingsMutex);
+    auto ring = std::make_unique<FThreadRing>();
+    ring->Index = static_cast<uint32_t>(Rings.size());
+    ring->Name = tThreadName.empty() ? "Thread " + std::to_string(ring->Index) : tThreadName;
+    ThreadRing = ring.get();
+    Rings.push_back(std::move(ring));
+    return *ThreadRing;
+}
+
+// --------------------- Frames ---------------------
+void JCpuProfiler::BeginFrame()
+{
+    UpdateCalibration();
+
+    FrameEvents.clear();
+    {
+        std::lock_guard<std::mutex> lock(RingsMutex);
+        for (const auto& ring : Rings)
+        {
+            const uint64_t head = ring->Head.load(std::memory_order_acquire);
+            for (uint64_t i = ring->Tail.load(std::memory_order_relaxed); i < head; ++i)
+                FrameEvents.push_back(ring->Events[i % RingCapacity]);
+            ring->Tail.store(head, std::memory_order_release);
+        }
+    }
+    std::sort(FrameEvents.begin(), FrameEvents.end(), [](const FCpuZoneEvent& a, const FCpuZoneEvent& b)
+    {
+        return a.Thread != b.Thread ? a.Thread < b.Thread : a.Begin < b.Begin;
+    });
+
+    const uint64_t now = Now();
+    FrameBegin = FrameEnd ? FrameEnd : now;
+    FrameEnd = now;
+
+    if (CaptureFramesLeft > 0)
+    {
+        CaptureEvents.insert(CaptureEvents.end(), FrameEvents.begin(), FrameEvents.end());
+        if (--CaptureFramesLeft == 0)
+        {
+            WriteCapture();
+            UpdateRecording();
+        }
+    }
+}
+
+void JCpuProfiler::SetEnabled(bool bEnable)
+{
+    bEnabled = bEnable;
+    UpdateRecording();
+}
+
+void JCpuProfiler::RequestCapture(const std::string& path, int frames)
+{
+    CapturePath = path;
+    CaptureEvents.clear();
+
+    // If zones weren't recorded, the first drain only holds the end of the current frame
+    CaptureFramesLeft = std::min(std::max(frames, 1), MaxCaptureFrames) + (IsRecording() ? 0 : 1);
+    UpdateRecording();
+}
+
+void JCpuProfiler::SetThreadName(const std::string& name)
+{
+    tThreadName = name;
+    if (!ThreadRing) return;
+
+    std::lock_guard<std::mutex> lock(RingsMutex);
+    ThreadRing->Name = name;
+}
+
+std::vector<std::string> JCpuProfiler::GetThreadNames() const
+{
+    std::lock_guard<std::mutex> lock(RingsMutex);
+    std::vector<std::string> names;
+    names.reserve(Rings.size());
+    for (const auto& ring : Rings)
+        names.push_back(ring->Name);
+    return names;
+}
+
+uint64_t JCpuProfiler::GetDroppedEvents() const
+{
+    std::lock_guard<std::mutex> lock(RingsMutex);
+    uint64_t dropped = 0;
+    for (const auto& ring : Rings)
+        dropped += ring->Dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+double JCpuProfiler::ToMicroseconds(uint64_t ticks) const
+{
+    return static_cast<double>(ticks) * MicrosecondsPerTick;
+}
+
+void JCpuProfiler::UpdateRecording()
+{
+    bRecording.store(bEnabled || CaptureFramesLeft > 0, std::memory_order_relaxed);
+}
+
+void JCpuProfiler::UpdateCalibration()
+{
+#if J_PROFILER_RDTSC
+    // The longer the window, the more precise the rate
+    const int64_t nanoseconds = GetSteadyNanoseconds() - CalibrationNanoseconds;
+    const uint64_t ticks = Now() - CalibrationTicks;
+    if (nanoseconds >= kMinCalibrationNanoseconds && ticks > 0)
+        MicrosecondsPerTick = static_cast<double>(nanoseconds) * 1e-3 / static_cast<double>(ticks);
+#endif
+}
+
+// --------------------- Chrome trace ---------------------
+void JCpuProfiler::WriteCapture()
+{
+    const std::filesystem::path parent = std::filesystem::path(CapturePath).parent_path();
+    std::error_code error;
+    if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+    std::ofstream file(CapturePath, std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "[JCpuProfiler] Could not open '" << CapturePath << "' for writing." << std::endl;
+        CaptureEvents.clear();
+        return;
+    }
+
+    uint64_t origin = ~0ull;
+    for (const FCpuZoneEvent& event : CaptureEvents)
+        origin = std::min(origin, event.Begin);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    const std::vector<std::string> threadNames = GetThreadNames();
+    for (size_t i = 0; i < threadNames.size(); ++i)
+    {
+        file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+        WriteJsonString(file, threadNames[i]);
+        file << "}}" << (i + 1 < threadNames.size() || !CaptureEvents.empty() ? ",\n" : "\n");
+    }
+
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (size_t i = 0; i < CaptureEvents.size(); ++i)
+    {
+        const FCpuZoneEvent& event = CaptureEvents[i];
+        file << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << event.Thread << ",\"name\":";
+        WriteJsonString(file, event.Name);
+        file << ",\"ts\":" << ToMicroseconds(event.Begin - origin)
+             << ",\"dur\":" << ToMicroseconds(event.End - event.Begin) << "}"
+             << (i + 1 < CaptureEvents.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+
+    std::cout << "[JCpuProfiler] Wrote " << CaptureEvents.size() << " zones to " << CapturePath << std::endl;
+    LastCapturePath = CapturePath;
+    CaptureEvents.clear();
+    CaptureEvents.shrink_to_fit();
+}
@@ -4,17 +4,29 @@
 
 #include "Framework/SceneManager.h"
 #include "Core/EngineGlobals.h"
+#include "Core/JCpuProfiler.h"
+#include "Core/JJobSystem.h"
 #include "Core/Contexts/FViewportContext.h"
 #include "Rendering/JRenderer.h"
+#include "Rendering/JFrameCapture.h"
+#include "Rendering/JGeometryPool.h"
+#include "Rendering/JGpuProfiler.h"
+#include "Rendering/JRenderStats.h"
 #include "Framework/PostProcessManager.h"
 #include "Scene/JCamera.h"
 #include <iostream>
 
 #include "glad/gl.h"
 
+JEngine::JEngine()
+{
+    GEngine = this;
+}
+
 bool JEngine::Initialize()
 {
     if (!GLFWInitialize()) return false;
+    JCpuProfiler::Get().SetThreadName("Main");
 
     GEngine = this;
 
@@ -56,6 +68,7 @@ bool JEngine::Initialize()
 
 void JEngine::Tick()
 {
+    J_PROFILE_SCOPE("JEngine::Tick");
     auto* sceneMgr = GetSceneManager();
     if (sceneMgr)
         sceneMgr->Update(m_State.GetDeltaTime());
@@ -70,6 +83,8 @@ bool JEngine::Run()
         m_State.SetDeltaTime(currentFrame - m_State.GetLastFrameTime());
         m_State.SetLastFrameTime(currentFrame);
 
+        JCpuProfiler::Get().BeginFrame();
+        JRenderStats::Get().BeginFrame();
         Tick();
     }
     Shutdown();
@@ -94,9 +109,12 @@ void JEngine::ProcessInputs(GLFWwindow* window, float deltaTime)
 
 void JEngine::OnFramebufferResize(int width, int height)
 {
+    // Both only record the size, targets are reallocated once the resize settles
     glViewport(0, 0, width, height);
     if (auto Renderer = GetService<JRenderer>())
         Renderer->Resize(width, height);
+    if (auto PostProcess = GetPostProcessManager())
+        PostProcess->Resize(width, height);
 }
 
 void JEngine::OnMouseMove(double xPosIn, double yPosIn)
@@ -156,14 +174,21 @@ PostProcessManager * JEngine::GetPostProcessManager()
 
 void JEngine::Shutdown()
 {
+    // Pools outlive the context otherwise
+    JGeometryPool::ShutdownAll();
     GEngine = nullptr;
 }
 
 void JEngine::RegisterServices()
 {
     m_Services.RegisterService<JRenderer>(m_State.GetWindowWidth(), m_State.GetWindowHeight(), 4);
-    m_Services.RegisterService<PostProcessManager>(m_State.GetWindowWidth(), m_State.GetWindowHeight());
+    // Post-process targets share the renderer's pool, so a resize can reuse either's freed targets
+    m_Services.RegisterService<PostProcessManager>(m_State.GetWindowWidth(), m_State.GetWindowHeight(),
+                                                   &GetService<JRenderer>()->GetTargetPool());
+    GetService<PostProcessManager>()->SetGpuProfiler(&GetService<JRenderer>()->GetGpuProfiler());
+    m_Services.RegisterService<JFrameCapture>();
     m_Services.RegisterService<SceneManager>();
+    m_Services.RegisterService<JJobSystem>();
 }
 
 bool JEngine::GLFWInitialize()
@@ -0,0 +1,117 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "Core/JFreeListAllocator.h"
+
+JFreeListAllocator::JFreeListAllocator(size_t capacity)
+    : Capacity(capacity)
+{
+    if (capacity > 0)
+        InsertFreeBlock(0, capacity);
+}
+
+size_t JFreeListAllocator::Allocate(size_t size)
+{
+    if (size == 0) return InvalidOffset;
+
+    // Best fit: the smallest free block that can hold the request
+    auto bySize = FreeBySize.lower_bound(size);
+    if (bySize == FreeBySize.end()) return InvalidOffset;
+
+    const size_t blockSize = bySize->first;
+    const size_t blockOffset = bySize->second;
+    EraseFreeBlock(FreeByOffset.find(blockOffset));
+
+    // Give the remainder back as a smaller free block
+    if (blockSize > size)
+        InsertFreeBlock(blockOffset + size, blockSize - size);
+
+    Used += size;
+    return blockOffset;
+}
+
+void JFreeListAllocator::Free(size_t offset, size_t size)
+{
+    if (offset == InvalidOffset || size == 0) return;
+
+    Used -= size;
+
+    // Merge with the following block
+    auto next = FreeByOffset.lower_bound(offset);
+    if (next != FreeByOffset.end() && next->first == offset + size)
+    {
+        size += next->second;
+        EraseFreeBlock(next);
+    }
+
+    // Merge with the preceding block
+    auto prev = FreeByOffset.lower_bound(offset);
+    if (prev != FreeByOffset.begin())
+    {
+        --prev;
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            size += prev->second;
+            EraseFreeBlock(prev);
+        }
+    }
+
+    InsertFreeBlock(offset, size);
+}
+
+void JFreeListAllocator::Grow(size_t newCapacity)
+{
+    if (newCapacity <= Capacity) return;
+
+    const size_t oldCapacity = Capacity;
+    Capacity = newCapacity;
+
+    // Free() coalesces the new tail with a trailing free block, Used is compensated up front
+    Used += newCapacity - oldCapacity;
+    Free(oldCapacity, newCapacity - oldCapacity);
+}
+
+void JFreeListAllocator::Reset(size_t capacity, size_t used)
+{
+    FreeByOffset.clear();
+    FreeBySize.clear();
+
+    Capacity = capacity;
+    Used = used;
+    if (capacity > used)
+        InsertFreeBlock(used, capacity - used);
+}
+
+size_t JFreeListAllocator::GetLargestFreeBlock() const
+{
+    return FreeBySize.empty() ? 0 : FreeBySize.rbegin()->first;
+}
+
+float JFreeListAllocator::GetFragmentation() const
+{
+    const size_t freeUnits = Capacity - Used;
+    if (freeUnits == 0) return 0.f;
+    return 1.f - static_cast<float>(GetLargestFreeBlock()) / static_cast<float>(freeUnits);
+}
+
+// --------------------- Internal Helpers ---------------------
+void JFreeListAllocator::InsertFreeBlock(size_t offset, size_t size)
+{
+    FreeByOffset.emplace(offset, size);
+    FreeBySize.emplace(size, offset);
+}
+
+void JFreeListAllocator::EraseFreeBlock(std::map<size_t, size_t>::iterator it)
+{
+    // Several blocks can share a size, find the one with the matching offset
+    auto range = FreeBySize.equal_range(it->second);
+    for (auto bySize = range.first; bySize != range.second; ++bySize)
+    {
+        if (bySize->second == it->first)
+        {
+            FreeBySize.erase(bySize);
+            break;
+        }
+    }
+    FreeByOffset.erase(it);
+}
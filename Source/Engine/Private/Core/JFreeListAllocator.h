@@ -0,0 +1,85 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+
+/**
+ * @class JFreeListAllocator
+ * @brief Best-fit range allocator over an abstract [0, capacity) address space.
+ *
+ * JFreeListAllocator does not own any memory; it only hands out offsets. It is used to
+ * sub-allocate large GPU buffers (see JGeometryPool) where the actual storage lives
+ * on the GPU and only the bookkeeping happens on the CPU.
+ *
+ * Free blocks are indexed both by offset (for O(log n) coalescing of neighbours on Free())
+ * and by size (for O(log n) best-fit lookup on Allocate()). Units are whatever the
+ * caller decides (vertices, indices, bytes...).
+ */
+class JFreeListAllocator {
+public:
+    static constexpr size_t InvalidOffset = ~static_cast<size_t>(0);
+
+    /**
+     * @brief Construct an allocator managing a single free block of @p capacity units.
+     */
+    explicit JFreeListAllocator(size_t capacity = 0);
+
+    /**
+     * @brief Allocate a contiguous range.
+     * @param size Number of units to allocate.
+     * @return Offset of the range, or InvalidOffset if no free block is large enough.
+     */
+    size_t Allocate(size_t size);
+
+    /**
+     * @brief Return a range to the allocator, merging it with adjacent free blocks.
+     * @param offset Offset previously returned by Allocate().
+     * @param size Size that was passed to Allocate().
+     */
+    void Free(size_t offset, size_t size);
+
+    /**
+     * @brief Extend the address space. The new tail is merged with a trailing free block.
+     * @param newCapacity New capacity, must be >= the current capacity.
+     */
+    void Grow(size_t newCapacity);
+
+    /**
+     * @brief Reset to a state where [0, used) is allocated and the rest is one free block.
+     *
+     * Used after compaction, once all live ranges have been packed to the front.
+     */
+    void Reset(size_t capacity, size_t used);
+
+    /// Total number of units managed.
+    inline size_t GetCapacity() const { return Capacity; }
+
+    /// Number of allocated units.
+    inline size_t GetUsed() const { return Used; }
+
+    /// Number of disjoint free blocks.
+    inline size_t GetFreeBlockCount() const { return FreeByOffset.size(); }
+
+    /// Size of the largest free block.
+    size_t GetLargestFreeBlock() const;
+
+    /**
+     * @brief Fragmentation of the free space in [0, 1].
+     *
+     * 0 means all free space is one contiguous block, values close to 1 mean
+     * the free space is scattered in many small holes.
+     */
+    float GetFragmentation() const;
+
+private:
+    size_t Capacity = 0;
+    size_t Used = 0;
+
+    std::map<size_t, size_t> FreeByOffset;    ///< offset -> size
+    std::multimap<size_t, size_t> FreeBySize; ///< size -> offset
+
+    void InsertFreeBlock(size_t offset, size_t size);
+    void EraseFreeBlock(std::map<size_t, size_t>::iterator it);
+};
@@ -0,0 +1,105 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JJobSystem.h"
+
+#include "Core/JCpuProfiler.h"
+
+#include <algorithm>
+
+JJobSystem::JJobSystem(unsigned int workerCount)
+{
+    if (workerCount == 0)
+    {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    Workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++)
+        Workers.emplace_back(&JJobSystem::WorkerLoop, this);
+}
+
+JJobSystem::~JJobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(QueueMutex);
+        bStopping = true;
+    }
+    QueueCondition.notify_all();
+
+    for (auto& worker : Workers)
+        worker.join();
+}
+
+void JJobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& task)
+{
+    if (count == 0) return;
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    if (Workers.empty() || count <= grainSize)
+    {
+        task(0, count);
+        return;
+    }
+
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+    std::atomic<size_t> remaining(chunkCount);
+
+    {
+        std::lock_guard<std::mutex> lock(QueueMutex);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            const size_t begin = chunk * grainSize;
+            const size_t end = std::min(begin + grainSize, count);
+            Queue.emplace_back([&task, &remaining, begin, end]()
+            {
+                {
+                    J_PROFILE_SCOPE("Job");
+                    task(begin, end);
+                }
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+    }
+    QueueCondition.notify_all();
+
+    // Help out instead of blocking, then spin on chunks still running on workers
+    while (remaining.load(std::memory_order_acquire) != 0)
+    {
+        if (!RunOne())
+            std::this_thread::yield();
+    }
+}
+
+// --------------------- Internal Helpers ---------------------
+void JJobSystem::WorkerLoop()
+{
+    JCpuProfiler::Get().SetThreadName("Worker");
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(QueueMutex);
+            QueueCondition.wait(lock, [this] { return bStopping || !Queue.empty(); });
+            if (bStopping && Queue.empty()) return;
+
+            job = std::move(Queue.front());
+            Queue.pop_front();
+        }
+        job();
+    }
+}
+
+bool JJobSystem::RunOne()
+{
+    std::function<void()> job;
+    {
+        std::lock_guard<std::mutex> lock(QueueMutex);
+        if (Queue.empty()) return false;
+
+        job = std::move(Queue.front());
+        Queue.pop_front();
+    }
+    job();
+    return true;
+}
@@ -0,0 +1,65 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JJobSystem
+ * @brief Fixed pool of worker threads for data-parallel engine work.
+ *
+ * The job system is deliberately minimal: work is expressed as ParallelFor() over an index
+ * range, split into chunks that workers pull from a shared queue. The calling thread helps
+ * execute chunks while it waits, so a ParallelFor() never idles the caller and is safe to
+ * use with zero workers (everything then runs inline).
+ *
+ * Jobs must not touch GL, only the main thread owns the context.
+ *
+ * Example usage:
+ * @code
+ * jobs.ParallelFor(items.size(), 1024, [&](size_t begin, size_t end)
+ * {
+ *     for (size_t i = begin; i < end; ++i) Process(items[i]);
+ * });
+ * @endcode
+ */
+class JJobSystem {
+public:
+    /**
+     * @param workerCount Number of worker threads. 0 picks hardware_concurrency() - 1.
+     */
+    explicit JJobSystem(unsigned int workerCount = 0);
+    ~JJobSystem();
+
+    JJobSystem(const JJobSystem&) = delete;
+    JJobSystem& operator=(const JJobSystem&) = delete;
+
+    /**
+     * @brief Run task over [0, count) in chunks of grainSize and wait for completion.
+     * @param count Number of items.
+     * @param grainSize Items per chunk. Ranges smaller than one chunk run inline.
+     * @param task Called as task(begin, end) for each chunk, possibly concurrently.
+     */
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& task);
+
+    inline unsigned int GetWorkerCount() const { return static_cast<unsigned int>(Workers.size()); }
+
+private:
+    std::vector<std::thread> Workers;
+    std::deque<std::function<void()>> Queue;
+    std::mutex QueueMutex;
+    std::condition_variable QueueCondition;
+    bool bStopping = false;
+
+    void WorkerLoop();
+
+    /// Pop and run one queued job. Returns false if the queue was empty.
+    bool RunOne();
+};
@@ -0,0 +1,61 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cfloat>
+#include <glm/glm.hpp>
+
+/**
+ * @struct FAABB
+ * @brief Axis-aligned bounding box stored as min/max corners.
+ *
+ * A default constructed box is empty (Min > Max) and becomes valid after the first Expand().
+ */
+struct FAABB
+{
+    glm::vec3 Min = glm::vec3(FLT_MAX);
+    glm::vec3 Max = glm::vec3(-FLT_MAX);
+
+    inline bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+    inline void Expand(const glm::vec3& point)
+    {
+        Min = glm::min(Min, point);
+        Max = glm::max(Max, point);
+    }
+
+    inline void Expand(const FAABB& other)
+    {
+        if (!other.IsValid()) return;
+        Min = glm::min(Min, other.Min);
+        Max = glm::max(Max, other.Max);
+    }
+
+    inline glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+    inline glm::vec3 GetExtent() const { return (Max - Min) * 0.5f; }
+
+    /**
+     * @brief Bounds of this box after an affine transform.
+     *
+     * Transforms the center and projects the extent on the absolute value of the
+     * rotation/scale part (Arvo), which is exact for the resulting AABB and avoids
+     * transforming all eight corners.
+     */
+    inline FAABB Transform(const glm::mat4& m) const
+    {
+        if (!IsValid()) return *this;
+
+        const glm::vec3 center = GetCenter();
+        const glm::vec3 extent = GetExtent();
+
+        const glm::vec3 newCenter = glm::vec3(m[0]) * center.x + glm::vec3(m[1]) * center.y +
+                                    glm::vec3(m[2]) * center.z + glm::vec3(m[3]);
+        const glm::vec3 newExtent = glm::abs(glm::vec3(m[0])) * extent.x + glm::abs(glm::vec3(m[1])) * extent.y +
+                                    glm::abs(glm::vec3(m[2])) * extent.z;
+
+        FAABB result;
+        result.Min = newCenter - newExtent;
+        result.Max = newCenter + newExtent;
+        return result;
+    }
+};
@@ -0,0 +1,66 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include "FAABB.h"
+
+/**
+ * @struct FFrustum
+ * @brief Six view-frustum planes in world space, normals pointing inwards.
+ *
+ * Each plane is stored as (n.x, n.y, n.z, d) with dot(n, p) + d >= 0 for points inside.
+ */
+struct FFrustum
+{
+    enum EPlane { Left, Right, Bottom, Top, Near, Far, Count };
+
+    glm::vec4 Planes[Count];
+
+    /**
+     * @brief Extract the planes from a projection * view matrix (Gribb/Hartmann).
+     *
+     * With a model matrix appended the planes come out in that model's local space instead.
+     */
+    static FFrustum FromMatrix(const glm::mat4& viewProjection)
+    {
+        // glm is column-major: row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&viewProjection](int i)
+        {
+            return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        };
+
+        const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+        FFrustum frustum;
+        frustum.Planes[Left]   = r3 + r0;
+        frustum.Planes[Right]  = r3 - r0;
+        frustum.Planes[Bottom] = r3 + r1;
+        frustum.Planes[Top]    = r3 - r1;
+        frustum.Planes[Near]   = r3 + r2;
+        frustum.Planes[Far]    = r3 - r2;
+
+        for (auto& plane : frustum.Planes)
+        {
+            const float length = glm::length(glm::vec3(plane));
+            if (length > 0.f) plane = plane * (1.f / length);
+        }
+        return frustum;
+    }
+
+    /// Conservative box test: false only if the box is fully outside one plane.
+    bool Intersects(const FAABB& box) const
+    {
+        const glm::vec3 center = box.GetCenter();
+        const glm::vec3 extent = box.GetExtent();
+
+        for (const auto& plane : Planes)
+        {
+            const glm::vec3 normal(plane);
+            const float distance = glm::dot(normal, center) + plane.w;
+            const float radius = glm::dot(glm::abs(normal), extent);
+            if (distance + radius < 0.f) return false;
+        }
+        return true;
+    }
+};
@@ -2,59 +2,442 @@
 
 #include "Framework/PostProcessManager.h"
 
+#include "Core/JCpuProfiler.h"
 #include "Rendering/JFramebufferTarget.h"
 #include <glad/gl.h>
-#include <iostream>
+#include <algorithm>
+#include <string>
+#include "Rendering/JColorLUT.h"
 #include "Rendering/JPostProcessor.h"
+#include "Rendering/JRenderGraph.h"
 
-PostProcessManager::PostProcessManager(int width, int height)
-    : Width(width), Height(height)
+namespace
 {
-    Ping = std::make_unique<JFramebufferTarget>(width, height, 1);
-    Pong = std::make_unique<JFramebufferTarget>(width, height, 1);
+    /// Fused shaders share the regular post-process vertex stage.
+    constexpr const char* kFusedVertexShader = "PostProcess.vert";
+
+    /// LUT resolution for smooth color effects, and for ones with hard steps (posterization).
+    constexpr int kColorLUTSize = 32;
+    constexpr int kSteppedColorLUTSize = 64;
+
+    /// Guide textures of the bilateral upsample, next to its input on unit 0.
+    constexpr int kGuideLowUnit = 1;
+    constexpr int kGuideFullUnit = 2;
+
+    /// Effect source without its #version line, ready to be pasted into a fused shader.
+    std::string StripVersion(std::string source)
+    {
+        const size_t version = source.find("#version");
+        if (version != std::string::npos)
+            source.erase(version, source.find('\n', version) - version);
+        return source;
+    }
+}
+
+PostProcessManager::PostProcessManager(int width, int height, JRenderTargetPool* targetPool)
+    : Width(width), Height(height), ChainWidth(width), ChainHeight(height)
+{
+    Graph = std::make_unique<JRenderGraph>(targetPool);
+    Passthrough = std::make_unique<JPostProcessor>();
+    Downsampler = std::make_unique<JPostProcessor>("PostProcess", "PostProcess/Downsample");
+    Upsampler = std::make_unique<JPostProcessor>("PostProcess", "PostProcess/BilateralUpsample");
+    Upscaler = std::make_unique<JPostProcessor>("PostProcess", "PostProcess/Upscale");
 }
 
+PostProcessManager::~PostProcessManager() = default;
+
 void PostProcessManager::AddProcessor(std::unique_ptr<JPostProcessor> processor) {
     Processors.push_back(std::move(processor));
+    bChainDirty = true;
+}
+
+void PostProcessManager::ApplyChain(unsigned int inputTexture, int screenWidth, int screenHeight, JJobSystem* jobs) {
+    Graph->Reset();
+    const FRGTexture input = Graph->ImportTexture("Scene", inputTexture, { Width, Height, EColorFormat::RGB8, 1 });
+    RunGraph(input, screenWidth, screenHeight, jobs);
 }
 
-void PostProcessManager::ApplyChain(unsigned int inputTexture, int screenWidth, int screenHeight) {
-    if (Processors.empty()) {
-        AddProcessor(std::make_unique<JPostProcessor>());
+void PostProcessManager::ApplyChain(JFramebufferTarget& inputTarget, int screenWidth, int screenHeight, JJobSystem* jobs) {
+    Graph->Reset();
+    const FRGTexture input = Graph->ImportTarget("Scene", inputTarget);
+    RunGraph(input, screenWidth, screenHeight, jobs);
+}
+
+const FRenderGraphStats& PostProcessManager::GetGraphStats() const {
+    return Graph->GetStats();
+}
+
+void PostProcessManager::SetGpuProfiler(JGpuProfiler* profiler) {
+    Graph->SetProfiler(profiler);
+}
+
+void PostProcessManager::RunGraph(uint32_t input, int screenWidth, int screenHeight, JJobSystem* jobs) {
+    J_PROFILE_SCOPE("Post-Processing");
+
+    // Effects toggling between passthrough and active change which passes exist and can fuse
+    for (size_t i = 0; i < Processors.size() && !bChainDirty; ++i) {
+        bChainDirty = Processors[i]->IsPassthrough() != DroppedProcessors[i];
+    }
+    if (bChainDirty) {
+        CompileChain();
     }
 
-    bool horizontal = true;
-    unsigned int currentTexture = inputTexture;
+    // The chain runs at the input's size, below the screen size under dynamic resolution
+    ChainWidth = Graph->GetDesc(input).Width;
+    ChainHeight = Graph->GetDesc(input).Height;
+    const bool bUpscale = ChainWidth != screenWidth || ChainHeight != screenHeight;
 
-    for (size_t i = 0; i < Processors.size(); ++i) {
-        const JFramebufferTarget* target = horizontal ? Ping.get() : Pong.get();
+    // A smaller chain ends in a transient texture and one filtered upscale to the screen
+    const FRGTexture backbuffer = Graph->ImportBackbuffer(screenWidth, screenHeight);
+    const FRGTexture screen = bUpscale && !Passes.empty()
+        ? Graph->CreateTexture("PostProcess", GetReducedDesc(1)) : backbuffer;
+
+    // Nothing left after dropping passthroughs: just draw the input
+    if (Passes.empty()) {
+        JPostProcessor* processor = bUpscale ? Upscaler.get() : Passthrough.get();
+        Graph->AddPass(bUpscale ? "Upscale" : "Passthrough", [processor, input, screen](const FRGContext& ctx) {
+            const FRGTextureDesc& desc = ctx.GetDesc(screen);
+            processor->Apply(ctx.GetTexture(input), desc.Width, desc.Height);
+        }).Read(input).Write(screen);
+    }
 
-        // Bind target framebuffer and clear
-        target->Bind();
-        glClear(GL_COLOR_BUFFER_BIT);
+    // Full-resolution input of the open reduced-resolution segment, and its downsampled copy
+    FRGTexture guideFull = InvalidRGTexture;
+    FRGTexture guideLow = InvalidRGTexture;
 
-        // Apply the processor using the current input texture
-        Processors[i]->Apply(currentTexture, Width, Height);
+    FRGTexture current = input;
+    for (size_t i = 0; i < Passes.size(); ++i) {
+        FChainPass* pass = &Passes[i];
+        const int divisor = static_cast<int>(pass->Resolution);
+        const bool bLast = i + 1 == Passes.size();
 
-        // Unbind framebuffer
-        target->Unbind(screenWidth, screenHeight);
+        // Consecutive passes at the same reduced resolution share one downsample and one upsample
+        if (divisor > 1 && guideFull == InvalidRGTexture) {
+            guideFull = current;
+            guideLow = AddDownsamplePass(current, divisor);
+            current = guideLow;
+        }
+        const bool bSegmentEnd = divisor > 1 && (bLast || Passes[i + 1].Resolution != pass->Resolution);
+
+        // The last full-resolution pass writes straight to the screen, the others to a transient texture
+        FRGTexture output;
+        if (divisor > 1) {
+            output = Graph->CreateTexture("PostProcess (Reduced)", GetReducedDesc(divisor));
+        } else {
+            output = bLast ? screen : Graph->CreateTexture("PostProcess", GetReducedDesc(1));
+        }
+
+        if (pass->Processor->GetKind() == EPostEffectKind::MultiPass) {
+            pass->Processor->AddPasses(*Graph, current, output);
+        } else {
+            Graph->AddPass(pass->Name, [pass, current, output, jobs](const FRGContext& ctx) {
+                if (ctx.GetTarget(output)) {
+                    glClear(GL_COLOR_BUFFER_BIT);
+                }
+
+                MirrorUniforms(*pass);
+                if (pass->ColorStage) {
+                    UpdateColorStage(*pass->ColorStage, *pass->Processor, jobs);
+                }
+
+                const FRGTextureDesc& desc = ctx.GetDesc(output);
+                pass->Processor->Apply(ctx.GetTexture(current), desc.Width, desc.Height);
+            }).Read(current).Write(output);
+        }
 
         // Output of this pass becomes input for next
-        currentTexture = target->GetTexture();
-        horizontal = !horizontal;
+        current = output;
+
+        if (bSegmentEnd) {
+            const FRGTexture upsampled = bLast ? screen : Graph->CreateTexture("PostProcess", GetReducedDesc(1));
+            AddUpsamplePass(current, guideLow, guideFull, upsampled);
+            current = upsampled;
+            guideFull = guideLow = InvalidRGTexture;
+        }
     }
 
-    // After the last pass, render the final texture to the screen
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, screenWidth, screenHeight);
+    if (bUpscale && !Passes.empty()) {
+        Graph->AddPass("Upscale", [this, screen, backbuffer](const FRGContext& ctx) {
+            const FRGTextureDesc& desc = ctx.GetDesc(backbuffer);
+            Upscaler->Apply(ctx.GetTexture(screen), desc.Width, desc.Height);
+        }).Read(screen).Write(backbuffer);
+    }
+
+    Graph->Compile();
+    Graph->Execute();
+}
 
-    Processors.back()->Apply(currentTexture, screenWidth, screenHeight);
+FRGTextureDesc PostProcessManager::GetReducedDesc(int divisor) const {
+    return { std::max(1, ChainWidth / divisor), std::max(1, ChainHeight / divisor), EColorFormat::RGB8, 1 };
+}
+
+uint32_t PostProcessManager::AddDownsamplePass(uint32_t input, int divisor) {
+    const FRGTexture output = Graph->CreateTexture("PostProcess (Downsampled)", GetReducedDesc(divisor));
+    Graph->AddPass("Downsample", [this, input, output, divisor](const FRGContext& ctx) {
+        // Taps a quarter block off center average the block's texels, one bilinear tap would skip most of them
+        const FRGTextureDesc& inputDesc = ctx.GetDesc(input);
+        JShader& shader = Downsampler->GetShader();
+        shader.Use();
+        shader.SetVec2("u_TapOffset", 0.25f * divisor / inputDesc.Width, 0.25f * divisor / inputDesc.Height);
+
+        const FRGTextureDesc& desc = ctx.GetDesc(output);
+        Downsampler->Apply(ctx.GetTexture(input), desc.Width, desc.Height);
+    }).Read(input).Write(output);
+    return output;
+}
+
+void PostProcessManager::AddUpsamplePass(uint32_t input, uint32_t guideLow, uint32_t guideFull, uint32_t output) {
+    Graph->AddPass("Upsample", [this, input, guideLow, guideFull, output](const FRGContext& ctx) {
+        JShader& shader = Upsampler->GetShader();
+        shader.Use();
+        glActiveTexture(GL_TEXTURE0 + kGuideLowUnit);
+        glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(guideLow));
+        shader.SetInt("u_GuideLow", kGuideLowUnit);
+        glActiveTexture(GL_TEXTURE0 + kGuideFullUnit);
+        glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(guideFull));
+        shader.SetInt("u_GuideFull", kGuideFullUnit);
+
+        const FRGTextureDesc& desc = ctx.GetDesc(output);
+        Upsampler->Apply(ctx.GetTexture(input), desc.Width, desc.Height);
+
+        glActiveTexture(GL_TEXTURE0 + kGuideFullUnit);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0 + kGuideLowUnit);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }).Read(input).Read(guideLow).Read(guideFull).Write(output);
 }
 
 void PostProcessManager::Resize(int newWidth, int newHeight) {
     Width = newWidth;
     Height = newHeight;
+}
+
+// --------------------- Chain Compilation ---------------------
+void PostProcessManager::CompileChain() {
+    Passes.clear();
+    ColorStages.clear();
+    DroppedProcessors.clear();
+
+    std::vector<JPostProcessor*> run;
+    std::vector<JPostProcessor*> colorRun;
+    bool bRunSamples = false;
+
+    auto flushRun = [&]() {
+        FChainPass pass;
+        if (run.size() == 1) {
+            pass.Processor = run.front();
+        } else if (run.size() > 1) {
+            pass = FuseEffects(run);
+        }
+
+        if (pass.Processor) {
+            pass.Resolution = run.front()->GetResolution();
+            for (const JPostProcessor* effect : run)
+                pass.Name += (pass.Name.empty() ? "" : " + ") + effect->GetFunctionName();
+            for (const auto& stage : ColorStages) {
+                if (std::find(run.begin(), run.end(), stage->Processor.get()) != run.end())
+                    pass.ColorStage = stage.get();
+            }
+            Passes.push_back(std::move(pass));
+        }
+        run.clear();
+        bRunSamples = false;
+    };
+
+    auto addFusable = [&](JPostProcessor* effect) {
+        // A fused shader contains each effect's source once, a repeated effect starts a new run
+        const bool bInRun = std::any_of(run.begin(), run.end(), [&](const JPostProcessor* other) {
+            return other->GetFragmentPath() == effect->GetFragmentPath();
+        });
+
+        // Two sampling effects would have to evaluate each other per tap
+        const bool bSampling = effect->GetKind() == EPostEffectKind::Sampling;
+        const bool bOtherResolution = !run.empty() && run.front()->GetResolution() != effect->GetResolution();
+        if (bInRun || (bSampling && bRunSamples) || bOtherResolution) flushRun();
+
+        run.push_back(effect);
+        bRunSamples |= bSampling;
+    };
+
+    // Consecutive color-only effects collapse into one LUT lookup
+    auto flushColorRun = [&]() {
+        if (colorRun.size() == 1) {
+            addFusable(colorRun.front());
+        } else if (colorRun.size() > 1) {
+            const bool bDiscontinuous = std::any_of(colorRun.begin(), colorRun.end(), [](const JPostProcessor* effect) {
+                return JColorLUT::FindOp(effect->GetFunctionName())->bDiscontinuous;
+            });
+
+            auto stage = std::make_unique<FColorLUTStage>();
+            stage->Processor = std::make_unique<JPostProcessor>("PostProcess", "PostProcess/ColorLUT",
+                EPostEffectKind::PointWise);
+            stage->Processor->SetResolution(colorRun.front()->GetResolution());
+            stage->LUT = std::make_unique<JColorLUT>(bDiscontinuous ? kSteppedColorLUTSize : kColorLUTSize);
+            stage->Effects = colorRun;
+
+            JPostProcessor* processor = stage->Processor.get();
+            ColorStages.push_back(std::move(stage));
+            addFusable(processor);
+        }
+        colorRun.clear();
+    };
+
+    for (const auto& processor : Processors) {
+        DroppedProcessors.push_back(processor->IsPassthrough());
+        if (DroppedProcessors.back()) continue;
+
+        const EPostEffectKind kind = processor->GetKind();
+
+        if (kind == EPostEffectKind::PointWise && JColorLUT::FindOp(processor->GetFunctionName())) {
+            // One LUT stage runs at one resolution
+            if (!colorRun.empty() && colorRun.front()->GetResolution() != processor->GetResolution())
+                flushColorRun();
+            colorRun.push_back(processor.get());
+            continue;
+        }
+        flushColorRun();
+
+        if (kind == EPostEffectKind::Pass || kind == EPostEffectKind::MultiPass) {
+            flushRun();
+            FChainPass pass;
+            pass.Processor = processor.get();
+            pass.Name = processor->GetFunctionName();
+            pass.Resolution = processor->GetResolution();
+            Passes.push_back(std::move(pass));
+        } else {
+            addFusable(processor.get());
+        }
+    }
+    flushColorRun();
+    flushRun();
+
+    bChainDirty = false;
+}
+
+PostProcessManager::FChainPass PostProcessManager::FuseEffects(const std::vector<JPostProcessor*>& effects) {
+    // Point-wise effects before the sampling one are applied to every tap it takes through
+    // PP_Input(), the ones after it to its result
+    const auto sampling = std::find_if(effects.begin(), effects.end(), [](const JPostProcessor* effect) {
+        return effect->GetKind() == EPostEffectKind::Sampling;
+    });
+    const size_t samplingIndex = static_cast<size_t>(sampling - effects.begin());
+
+    std::string source =
+        "#version 330 core\n"
+        "#define PP_FUSED\n\n"
+        "out vec4 FragColor;\n"
+        "in vec2 TexCoords;\n\n"
+        "uniform sampler2D screenTexture;\n\n";
+
+    for (size_t i = 0; i < samplingIndex; ++i)
+        source += StripVersion(JShader::LoadShaderSource(effects[i]->GetFragmentPath() + ".frag")) + "\n";
+
+    source += "vec3 PP_Input(vec2 uv)\n{\n    vec3 color = texture(screenTexture, uv).rgb;\n";
+    for (size_t i = 0; i < samplingIndex; ++i)
+        source += "    color = " + effects[i]->GetFunctionName() + "(color, uv);\n";
+    source += "    return color;\n}\n\n";
+
+    for (size_t i = samplingIndex; i < effects.size(); ++i)
+        source += StripVersion(JShader::LoadShaderSource(effects[i]->GetFragmentPath() + ".frag")) + "\n";
+
+    source += "void main()\n{\n";
+    if (samplingIndex < effects.size())
+        source += "    vec3 color = " + effects[samplingIndex]->GetFunctionName() + "(TexCoords);\n";
+    else
+        source += "    vec3 color = PP_Input(TexCoords);\n";
+    for (size_t i = samplingIndex + 1; i < effects.size(); ++i)
+        source += "    color = " + effects[i]->GetFunctionName() + "(color, TexCoords);\n";
+    source += "    FragColor = vec4(color, 1.0);\n}\n";
+
+    FChainPass pass;
+    pass.Fused = std::make_unique<JPostProcessor>(
+        JShader::CreateFromSource(JShader::LoadShaderSource(kFusedVertexShader), source));
+    pass.Processor = pass.Fused.get();
+
+    // Link every scalar/vector uniform of the effects' own programs to the fused program
+    const GLuint fusedProgram = pass.Fused->GetShader().GetProgram();
+    pass.Effects = effects;
+    pass.Revisions.assign(effects.size(), ~uint64_t(0)); // Mirror everything once
+    for (size_t e = 0; e < effects.size(); ++e) {
+        const GLuint program = effects[e]->GetShader().GetProgram();
+        GLint uniformCount = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+        for (GLint u = 0; u < uniformCount; ++u) {
+            GLchar name[128];
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program, static_cast<GLuint>(u), sizeof(name), nullptr, &size, &type, name);
+
+            const bool bSupported = type == GL_FLOAT || type == GL_FLOAT_VEC2 || type == GL_FLOAT_VEC3 ||
+                                    type == GL_FLOAT_VEC4 || type == GL_INT || type == GL_BOOL;
+            if (!bSupported || size != 1) continue;
+
+            FUniformLink link;
+            link.SourceProgram = program;
+            link.Effect = e;
+            link.SourceLocation = glGetUniformLocation(program, name);
+            link.TargetLocation = glGetUniformLocation(fusedProgram, name);
+            link.Type = type;
+            if (link.SourceLocation >= 0 && link.TargetLocation >= 0)
+                pass.Uniforms.push_back(link);
+        }
+    }
+
+    return pass;
+}
+
+void PostProcessManager::MirrorUniforms(FChainPass& pass) {
+    if (pass.Uniforms.empty()) return;
+
+    // glGetUniform* is a synchronous readback, only effects whose uniforms were set since are read
+    bool bChanged = false;
+    for (size_t e = 0; e < pass.Effects.size(); ++e) {
+        const uint64_t revision = pass.Effects[e]->GetShader().GetRevision();
+        bChanged |= revision != pass.Revisions[e];
+    }
+    if (!bChanged) return;
+
+    pass.Processor->GetShader().Use();
+    for (const FUniformLink& link : pass.Uniforms) {
+        if (pass.Effects[link.Effect]->GetShader().GetRevision() == pass.Revisions[link.Effect]) continue;
+
+        if (link.Type == GL_INT || link.Type == GL_BOOL) {
+            GLint value = 0;
+            glGetUniformiv(link.SourceProgram, link.SourceLocation, &value);
+            glUniform1i(link.TargetLocation, value);
+            continue;
+        }
+
+        GLfloat value[4] = {};
+        glGetUniformfv(link.SourceProgram, link.SourceLocation, value);
+        switch (link.Type) {
+        case GL_FLOAT:      glUniform1fv(link.TargetLocation, 1, value); break;
+        case GL_FLOAT_VEC2: glUniform2fv(link.TargetLocation, 1, value); break;
+        case GL_FLOAT_VEC3: glUniform3fv(link.TargetLocation, 1, value); break;
+        default:            glUniform4fv(link.TargetLocation, 1, value); break;
+        }
+    }
+
+    for (size_t e = 0; e < pass.Effects.size(); ++e)
+        pass.Revisions[e] = pass.Effects[e]->GetShader().GetRevision();
+}
+
+void PostProcessManager::UpdateColorStage(FColorLUTStage& stage, JPostProcessor& pass, JJobSystem* jobs) {
+    // Parameters live in the baked effects' own programs, changes there trigger a re-bake
+    stage.Ops.clear();
+    for (JPostProcessor* effect : stage.Effects) {
+        const FColorOpInfo* info = JColorLUT::FindOp(effect->GetFunctionName());
+        FColorOp op;
+        op.Op = info->Op;
+        if (info->ParamUniform) {
+            const GLuint program = effect->GetShader().GetProgram();
+            const GLint location = glGetUniformLocation(program, info->ParamUniform);
+            if (location >= 0) glGetUniformfv(program, location, &op.Param);
+        }
+        stage.Ops.push_back(op);
+    }
 
-    Ping->Resize(newWidth, newHeight);
-    Pong->Resize(newWidth, newHeight);
+    stage.LUT->Update(stage.Ops, jobs);
+    stage.LUT->Bind(pass.GetShader());
 }
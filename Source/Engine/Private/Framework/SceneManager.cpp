@@ -1,6 +1,7 @@
 #include "Framework/SceneManager.h"
 
 #include <fstream>
+#include "Core/JCpuProfiler.h"
 #include "nlohmann/json.hpp"
 #include "Scene/JActor.h"
 
@@ -31,8 +32,30 @@ bool SceneManager::RemoveActor(unsigned int id)
     return RemoveActor(actor);
 }
 
+void SceneManager::NotifyActorMoved(JActor* actor)
+{
+    if (!m_ActiveScene || !actor) return;
+
+    m_ActiveScene->UpdateActorBounds(actor);
+    m_ActiveScene->m_bIsDirty = true; // Transforms are serialized
+    if (OnActorMoved) OnActorMoved(actor);
+}
+
+bool SceneManager::SetActorTransform(JActor* actor, const glm::vec3& position, const glm::vec3& rotation,
+                                     const glm::vec3& scale)
+{
+    if (!m_ActiveScene || !actor || m_ActiveScene->FindActorByID(actor->ID) != actor) return false;
+
+    actor->Position = position;
+    actor->Rotation = rotation;
+    actor->Scale = scale;
+    NotifyActorMoved(actor);
+    return true;
+}
+
 void SceneManager::Update(float deltaTime)
 {
+    J_PROFILE_SCOPE("SceneManager::Update");
     if(m_ActiveScene)
         m_ActiveScene->UpdateActors(deltaTime);
 }
@@ -54,9 +77,14 @@ JScene* SceneManager::LoadSceneFile(const std::string &filename)
     json j;
     file >> j;
 
-    std::string name = j.value("name", "UnnamedScene");
+    return LoadSceneJson(j);
+}
+
+JScene* SceneManager::LoadSceneJson(const nlohmann::json &data)
+{
+    std::string name = data.value("name", "UnnamedScene");
     auto scene = std::make_unique<JScene>(name);
-    scene->Deserialize(j);
+    scene->Deserialize(data);
 
     if (OnSceneLoaded) OnSceneLoaded(scene.get());
     m_ActiveScene = std::move(scene);
@@ -64,6 +92,11 @@ JScene* SceneManager::LoadSceneFile(const std::string &filename)
     return m_ActiveScene.get();
 }
 
+nlohmann::json SceneManager::SerializeScene(const JScene *scene) const
+{
+    return scene ? scene->Serialize() : json();
+}
+
 bool SceneManager::SaveSceneFile(const JScene *scene, const std::string &filename) const
 {
     if (!scene) return false;
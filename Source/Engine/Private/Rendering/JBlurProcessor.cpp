@@ -0,0 +1,193 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JBlurProcessor.h"
+
+#include <glad/gl.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /// Radius one dual filter level with offset 1 adds, in pixels of the level it starts from.
+    constexpr float kDualFilterLevelRadius = 1.5f;
+
+    /// Radius the Gaussian kernel reaches, in standard deviations.
+    constexpr float kGaussianSigmas = 3.f;
+
+    /// Size of a texture halved level times, never below one pixel.
+    FRGTextureDesc GetLevelDesc(const FRGTextureDesc& desc, int level)
+    {
+        FRGTextureDesc levelDesc = desc;
+        levelDesc.Width = std::max(1, desc.Width >> level);
+        levelDesc.Height = std::max(1, desc.Height >> level);
+        levelDesc.Samples = 1;
+        return levelDesc;
+    }
+
+    /// Levels a texture can be halved before its smaller side drops below two pixels.
+    int GetMaxLevels(const FRGTextureDesc& desc)
+    {
+        int levels = 0;
+        while (levels < JBlurProcessor::MaxLevels && std::min(desc.Width, desc.Height) >> (levels + 1) >= 2)
+            ++levels;
+        return levels;
+    }
+}
+
+JBlurProcessor::JBlurProcessor(EBlurMethod method, float radius)
+    : JPostProcessor("PostProcess", "PostProcess/GaussianBlur", EPostEffectKind::MultiPass),
+      Method(method), Radius(radius)
+{
+    Downsample = std::make_unique<JPostProcessor>("PostProcess", "PostProcess/DualFilterDown");
+    Upsample = std::make_unique<JPostProcessor>("PostProcess", "PostProcess/DualFilterUp");
+    Copy = std::make_unique<JPostProcessor>();
+}
+
+JBlurProcessor::~JBlurProcessor() = default;
+
+void JBlurProcessor::AddPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output)
+{
+    PassCount = 0;
+    // Only reached when called outside PostProcessManager, which drops passthroughs
+    if (IsPassthrough())
+    {
+        AddResamplePass(graph, *Copy, input, output, 0.f);
+        return;
+    }
+
+    if (Method == EBlurMethod::Gaussian)
+        AddGaussianPasses(graph, input, output);
+    else
+        AddDualFilterPasses(graph, input, output);
+}
+
+// --------------------- Gaussian ---------------------
+void JBlurProcessor::AddGaussianPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output)
+{
+    const FRGTextureDesc inputDesc = graph.GetDesc(input);
+    const int maxLevels = GetMaxLevels(inputDesc);
+
+    // Halve the resolution until the remaining radius fits in the kernel
+    int levels = 0;
+    float radius = Radius;
+    while (radius > MaxGaussianRadius && levels < maxLevels)
+    {
+        radius *= 0.5f;
+        ++levels;
+    }
+    UpdateKernel(std::min(radius, MaxGaussianRadius));
+
+    FRGTexture source = input;
+    for (int level = 1; level <= levels; ++level)
+        source = AddDownsamplePass(graph, source, 1.f);
+
+    const FRGTextureDesc levelDesc = GetLevelDesc(inputDesc, levels);
+    const FRGTexture horizontal = graph.CreateTexture("Blur Horizontal", levelDesc);
+    const FRGTexture vertical = levels == 0 ? output : graph.CreateTexture("Blur Vertical", levelDesc);
+
+    auto addAxis = [this, &graph](FRGTexture from, FRGTexture to, bool bHorizontal)
+    {
+        graph.AddPass("Blur Gaussian", [this, from, to, bHorizontal](const FRGContext& ctx)
+        {
+            const FRGTextureDesc& fromDesc = ctx.GetDesc(from);
+            JShader& shader = GetShader();
+            shader.Use();
+            shader.SetVec2("u_Direction", bHorizontal ? 1.f / fromDesc.Width : 0.f,
+                           bHorizontal ? 0.f : 1.f / fromDesc.Height);
+            shader.SetInt("u_TapCount", TapCount);
+            glUniform1fv(glGetUniformLocation(shader.GetProgram(), "u_Weights"), TapCount + 1, Weights.data());
+            glUniform1fv(glGetUniformLocation(shader.GetProgram(), "u_Offsets"), TapCount + 1, Offsets.data());
+
+            const FRGTextureDesc& toDesc = ctx.GetDesc(to);
+            Apply(ctx.GetTexture(from), toDesc.Width, toDesc.Height);
+        }).Read(from).Write(to);
+        ++PassCount;
+    };
+    addAxis(source, horizontal, true);
+    addAxis(horizontal, vertical, false);
+
+    // The blurred image is smooth at this scale, bilinear upsampling loses nothing visible
+    source = vertical;
+    for (int level = levels - 1; level >= 0; --level)
+    {
+        const FRGTexture target = level == 0 ? output
+            : graph.CreateTexture("Blur Upsample", GetLevelDesc(inputDesc, level));
+        AddResamplePass(graph, *Copy, source, target, 0.f);
+        source = target;
+    }
+}
+
+void JBlurProcessor::UpdateKernel(float radius)
+{
+    if (radius == KernelRadius) return;
+    KernelRadius = radius;
+
+    // Discrete Gaussian over [-texels, texels], normalized
+    const int texels = std::max(1, static_cast<int>(std::ceil(radius)));
+    const float sigma = std::max(radius, 1.f) / kGaussianSigmas;
+    std::vector<float> texelWeights(texels + 2, 0.f);
+    float total = 0.f;
+    for (int i = 0; i <= texels; ++i)
+    {
+        texelWeights[i] = std::exp(-0.5f * i * i / (sigma * sigma));
+        total += i == 0 ? texelWeights[i] : 2.f * texelWeights[i];
+    }
+
+    // Merge texels (i, i + 1) into one bilinear fetch placed at their weighted center
+    Weights.assign(1, texelWeights[0] / total);
+    Offsets.assign(1, 0.f);
+    for (int i = 1; i <= texels; i += 2)
+    {
+        const float weight = texelWeights[i] + texelWeights[i + 1];
+        Weights.push_back(weight / total);
+        Offsets.push_back((i * texelWeights[i] + (i + 1) * texelWeights[i + 1]) / weight);
+    }
+    TapCount = static_cast<int>(Weights.size()) - 1;
+}
+
+// --------------------- Dual Filter ---------------------
+void JBlurProcessor::AddDualFilterPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output)
+{
+    const FRGTextureDesc inputDesc = graph.GetDesc(input);
+
+    // Each level doubles the footprint, the tap offset scales the last doubling to the exact radius
+    const int maxLevels = std::max(1, GetMaxLevels(inputDesc));
+    const int levels = std::min(maxLevels,
+        std::max(1, static_cast<int>(std::ceil(std::log2(Radius / kDualFilterLevelRadius)))));
+    const float offset = Radius / (kDualFilterLevelRadius * static_cast<float>(1 << levels));
+
+    FRGTexture source = input;
+    for (int level = 1; level <= levels; ++level)
+        source = AddDownsamplePass(graph, source, offset);
+
+    for (int level = levels - 1; level >= 0; --level)
+    {
+        const FRGTexture target = level == 0 ? output
+            : graph.CreateTexture("Blur Upsample", GetLevelDesc(inputDesc, level));
+        AddResamplePass(graph, *Upsample, source, target, offset);
+        source = target;
+    }
+}
+
+// --------------------- Internal Helpers ---------------------
+FRGTexture JBlurProcessor::AddDownsamplePass(JRenderGraph& graph, FRGTexture input, float offset)
+{
+    const FRGTexture output = graph.CreateTexture("Blur Downsample", GetLevelDesc(graph.GetDesc(input), 1));
+    AddResamplePass(graph, *Downsample, input, output, offset);
+    return output;
+}
+
+void JBlurProcessor::AddResamplePass(JRenderGraph& graph, JPostProcessor& processor, FRGTexture input,
+                                     FRGTexture output, float offset)
+{
+    graph.AddPass("Blur Resample", [&processor, input, output, offset](const FRGContext& ctx)
+    {
+        const FRGTextureDesc& desc = ctx.GetDesc(output);
+        JShader& shader = processor.GetShader();
+        shader.Use();
+        shader.SetVec2("u_HalfPixel", 0.5f / desc.Width, 0.5f / desc.Height);
+        shader.SetFloat("u_Offset", offset);
+        processor.Apply(ctx.GetTexture(input), desc.Width, desc.Height);
+    }).Read(input).Write(output);
+    ++PassCount;
+}
@@ -0,0 +1,102 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "JPostProcessor.h"
+
+/// Filter used by JBlurProcessor.
+enum class EBlurMethod : uint8_t
+{
+    Gaussian,  ///< Separable Gaussian, exact shape, two passes plus the downsample chain of large radii
+    DualFilter ///< Dual Kawase down/up chain, cheapest per pixel, close to Gaussian
+};
+
+/**
+ * @class JBlurProcessor
+ * @brief Post-process blur with a radius in pixels, independent of the target resolution.
+ *
+ * Both methods cost O(log r) fullscreen passes for a radius of r pixels instead of
+ * growing the kernel:
+ * - Gaussian: a horizontal and a vertical pass using the linear sampling trick (one
+ *   bilinear fetch weighs two neighbouring texels, so a radius of r takes r/2 + 1 taps per
+ *   side). Radii above MaxGaussianRadius are blurred on a half-resolution copy, halved
+ *   again until the remaining radius fits, then upsampled bilinearly.
+ * - DualFilter: the input is halved log2(r) times with a 5-tap filter and brought back up
+ *   with an 8-tap one. Each level doubles the footprint, the tap offset covers the remainder.
+ *
+ * Intermediate levels are transient render graph textures, so the down and up halves of the
+ * chain alias the same pooled targets.
+ *
+ * The blur only runs through AddPasses() (EPostEffectKind::MultiPass); Apply() alone copies.
+ * Below half a pixel of radius PostProcessManager skips it entirely, so a disabled blur costs
+ * no pass and doesn't keep the previous pass from writing straight to the screen.
+ *
+ * Typical usage:
+ * @code
+ * auto blur = std::make_unique<JBlurProcessor>(EBlurMethod::DualFilter, 24.f);
+ * JBlurProcessor* blurHandle = blur.get();
+ * postProcessManager.AddProcessor(std::move(blur));
+ * blurHandle->SetRadius(48.f); // Any time, takes effect next frame
+ * @endcode
+ */
+class JBlurProcessor : public JPostProcessor {
+public:
+    /// Largest radius the separable Gaussian covers at one resolution level (two texels per tap).
+    static constexpr int MaxGaussianTaps = 16;
+    static constexpr float MaxGaussianRadius = 2.f * MaxGaussianTaps;
+
+    /// Limit of the downsample chain, enough for radii of thousands of pixels.
+    static constexpr int MaxLevels = 8;
+
+    /**
+     * @param method Filter to use.
+     * @param radius Blur radius in pixels of the input. Below half a pixel the effect is a passthrough.
+     */
+    explicit JBlurProcessor(EBlurMethod method = EBlurMethod::DualFilter, float radius = 8.f);
+    ~JBlurProcessor() override;
+
+    void AddPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output) override;
+
+    /// A radius below half a pixel wouldn't move any texel, the blur drops out of the chain.
+    inline bool IsPassthrough() const override { return Radius < 0.5f; }
+
+    inline void SetRadius(float radius) { Radius = radius; }
+    inline float GetRadius() const { return Radius; }
+
+    inline void SetMethod(EBlurMethod method) { Method = method; }
+    inline EBlurMethod GetMethod() const { return Method; }
+
+    /// Fullscreen passes declared by the last AddPasses().
+    inline int GetPassCount() const { return PassCount; }
+
+private:
+    EBlurMethod Method;
+    float Radius;
+    int PassCount = 0;
+
+    std::unique_ptr<JPostProcessor> Downsample; ///< PostProcess/DualFilterDown
+    std::unique_ptr<JPostProcessor> Upsample;   ///< PostProcess/DualFilterUp
+    std::unique_ptr<JPostProcessor> Copy;       ///< Bilinear copy, Gaussian upsampling
+
+    // Linear-sampled Gaussian taps of KernelRadius, index 0 is the center texel
+    float KernelRadius = -1.f;
+    int TapCount = 0;
+    std::vector<float> Weights;
+    std::vector<float> Offsets;
+
+    void AddGaussianPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output);
+    void AddDualFilterPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output);
+
+    /// Half-resolution copy of a texture through the dual filter's downsample pass.
+    FRGTexture AddDownsamplePass(JRenderGraph& graph, FRGTexture input, float offset);
+
+    /// Pass running processor from input to output, with the half-texel size of output bound.
+    void AddResamplePass(JRenderGraph& graph, JPostProcessor& processor, FRGTexture input, FRGTexture output,
+                         float offset);
+
+    /// Rebuild the tap weights and offsets for a radius in texels (<= MaxGaussianRadius).
+    void UpdateKernel(float radius);
+};
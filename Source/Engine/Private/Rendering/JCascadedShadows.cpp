@@ -0,0 +1,281 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JCascadedShadows.h"
+
+#include <cmath>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Core/Math/FFrustum.h"
+#include "JRenderStats.h"
+#include "JShader.h"
+#include "Scene/JActor.h"
+#include "Scene/JCamera.h"
+
+namespace
+{
+    /// Blend between uniform (0) and logarithmic (1) cascade splits.
+    constexpr float kSplitLambda = 0.75f;
+
+    /// Cached cascades move in steps of this many texels, so their projection rarely changes.
+    constexpr float kCachedSnapTexels = 64.f;
+
+    /// Extra depth behind each cascade so casters outside the view still reach it.
+    constexpr float kCasterDepthExtension = 50.f;
+
+    glm::vec3 GetLightUp(const glm::vec3& direction)
+    {
+        return std::abs(direction.y) > 0.99f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f);
+    }
+}
+
+JCascadedShadows::JCascadedShadows(int resolution, float shadowDistance)
+    : Resolution(resolution), ShadowDistance(shadowDistance)
+{
+    DepthArray = CreateDepthArray(Resolution, CascadeCount, true);
+    CacheArray = CreateDepthArray(Resolution, CascadeCount - FirstCachedCascade, false);
+
+    glGenFramebuffers(CascadeCount, CascadeFBOs);
+    glGenFramebuffers(CascadeCount - FirstCachedCascade, CacheFBOs);
+    for (int c = 0; c < CascadeCount; ++c)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, CascadeFBOs[c]);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, DepthArray, 0, c);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+
+        if (c < FirstCachedCascade) continue;
+        glBindFramebuffer(GL_FRAMEBUFFER, CacheFBOs[c - FirstCachedCascade]);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, CacheArray, 0, c - FirstCachedCascade);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    DepthShader = std::make_unique<JShader>("ShadowDepth", "ShadowDepth");
+    Batcher.SetPass(EBatchPass::ShadowCaster);
+}
+
+JCascadedShadows::~JCascadedShadows()
+{
+    Shutdown();
+}
+
+void JCascadedShadows::Shutdown()
+{
+    if (!DepthArray) return;
+
+    glDeleteFramebuffers(CascadeCount, CascadeFBOs);
+    glDeleteFramebuffers(CascadeCount - FirstCachedCascade, CacheFBOs);
+    glDeleteTextures(1, &DepthArray);
+    if (CacheArray) glDeleteTextures(1, &CacheArray);
+    DepthArray = CacheArray = 0;
+}
+
+void JCascadedShadows::Update(JCamera& camera, float aspect, float nearPlane, const glm::vec3& lightDirection)
+{
+    LightDirection = glm::normalize(lightDirection);
+    const glm::vec3 up = GetLightUp(LightDirection);
+    const glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.f), LightDirection, up);
+    const glm::mat4 inverseLightRotation = glm::inverse(lightRotation);
+
+    const glm::mat4 inverseView = glm::inverse(camera.GetViewMatrix());
+    const float tanY = std::tan(glm::radians(camera.Zoom) * 0.5f);
+    const float tanX = tanY * aspect;
+
+    float splitNear = nearPlane;
+    for (int c = 0; c < CascadeCount; ++c)
+    {
+        FCascade& cascade = Cascades[c];
+
+        // Practical split scheme
+        const float p = static_cast<float>(c + 1) / CascadeCount;
+        const float logSplit = nearPlane * std::pow(ShadowDistance / nearPlane, p);
+        const float uniformSplit = nearPlane + (ShadowDistance - nearPlane) * p;
+        const float splitFar = glm::mix(uniformSplit, logSplit, kSplitLambda);
+        cascade.SplitFar = splitFar;
+
+        // Bounding sphere of the slice: its radius doesn't change when the camera turns
+        glm::vec3 corners[8];
+        glm::vec3 center(0.f);
+        for (int i = 0; i < 8; ++i)
+        {
+            const float depth = i < 4 ? splitNear : splitFar;
+            const glm::vec4 viewCorner((i & 1 ? 1.f : -1.f) * tanX * depth, (i & 2 ? 1.f : -1.f) * tanY * depth, -depth, 1.f);
+            corners[i] = glm::vec3(inverseView * viewCorner);
+            center += corners[i] / 8.f;
+        }
+        float radius = 0.f;
+        for (const glm::vec3& corner : corners)
+            radius = std::max(radius, glm::length(corner - center));
+        radius = std::ceil(radius * 16.f) / 16.f;
+
+        // Cached cascades snap coarsely: the center moves by up to one step, 2 * radius / Resolution
+        // * kCachedSnapTexels, on each light axis, so grow the box until it still covers the slice
+        const bool bCached = c >= FirstCachedCascade;
+        if (bCached)
+            radius /= 1.f - 2.f * kCachedSnapTexels / Resolution;
+
+        const float texelSize = 2.f * radius / Resolution;
+        const float snapStep = bCached ? texelSize * kCachedSnapTexels : texelSize;
+
+        // Snap across the light in whole texels to keep the rasterization stable; depth is left alone,
+        // moving along the light doesn't shimmer and a snapped depth could clip the slice
+        glm::vec3 lightCenter = glm::vec3(lightRotation * glm::vec4(center, 1.f));
+        lightCenter.x = std::floor(lightCenter.x / snapStep) * snapStep;
+        lightCenter.y = std::floor(lightCenter.y / snapStep) * snapStep;
+        const glm::vec3 snappedCenter = glm::vec3(inverseLightRotation * glm::vec4(lightCenter, 1.f));
+
+        const float backDistance = radius + kCasterDepthExtension;
+        const glm::mat4 lightView = glm::lookAt(snappedCenter - LightDirection * backDistance, snappedCenter, up);
+        const glm::mat4 lightProjection = glm::ortho(-radius, radius, -radius, radius, 0.f, backDistance + radius);
+        const glm::mat4 lightViewProjection = lightProjection * lightView;
+
+        if (lightViewProjection != cascade.LightViewProjection)
+            cascade.bCacheValid = false;
+        cascade.LightViewProjection = lightViewProjection;
+
+        splitNear = splitFar;
+    }
+}
+
+void JCascadedShadows::Render(const std::vector<const JActor*>& casters)
+{
+    Stats = FShadowStats();
+    if (!bEnabled) return;
+
+    glViewport(0, 0, Resolution, Resolution);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+
+    // Slope-scaled bias against acne
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.f, 4.f);
+
+    for (int c = 0; c < CascadeCount; ++c)
+    {
+        FCascade& cascade = Cascades[c];
+        const bool bCached = c >= FirstCachedCascade;
+        const FFrustum frustum = FFrustum::FromMatrix(cascade.LightViewProjection);
+
+        // Per-cascade culling against the light frustum
+        StaticCasters.clear();
+        DynamicCasters.clear();
+        for (const JActor* actor : casters)
+        {
+            if (!actor->Model || !actor->Config.bCastShadows || actor->Config.bIsTransparent) continue;
+            if (!frustum.Intersects(actor->GetWorldBounds())) continue;
+
+            if (bCached && actor->Config.bIsStatic)
+                StaticCasters.push_back(actor);
+            else
+                DynamicCasters.push_back(actor);
+        }
+        Stats.Casters[c] = static_cast<int>(StaticCasters.size() + DynamicCasters.size());
+
+        if (bCached)
+        {
+            const int layer = c - FirstCachedCascade;
+
+            // Static casters are re-rendered only if one of them moved, appeared or left the cascade
+            CurrentStatic.clear();
+            for (const JActor* actor : StaticCasters)
+                CurrentStatic.emplace_back(actor, actor->GetModelMatrix());
+
+            if (!cascade.bCacheValid || CurrentStatic != cascade.CachedCasters)
+            {
+                glBindFramebuffer(GL_FRAMEBUFFER, CacheFBOs[layer]);
+                JRenderStats::CountFramebufferBind();
+                glClear(GL_DEPTH_BUFFER_BIT);
+                DrawCasters(StaticCasters, cascade.LightViewProjection, c);
+
+                cascade.CachedCasters.swap(CurrentStatic);
+                cascade.bCacheValid = true;
+                ++Stats.StaticRebuilds;
+            }
+            else
+            {
+                Stats.Cached[c] = true;
+            }
+
+            // Start the live cascade from the cached static depth
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, CacheFBOs[layer]);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, CascadeFBOs[c]);
+            glBlitFramebuffer(0, 0, Resolution, Resolution, 0, 0, Resolution, Resolution,
+                GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+            glBindFramebuffer(GL_FRAMEBUFFER, CascadeFBOs[c]);
+            JRenderStats::CountFramebufferBind(3);
+        }
+        else
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, CascadeFBOs[c]);
+            JRenderStats::CountFramebufferBind();
+            glClear(GL_DEPTH_BUFFER_BIT);
+        }
+
+        DrawCasters(DynamicCasters, cascade.LightViewProjection, c);
+    }
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    JRenderStats::CountFramebufferBind();
+}
+
+void JCascadedShadows::Bind(JShader& shader) const
+{
+    shader.Use();
+
+    glActiveTexture(GL_TEXTURE0 + TextureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, DepthArray);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.SetInt("u_ShadowMap", TextureUnit);
+    shader.SetInt("u_ShadowsEnabled", bEnabled ? 1 : 0);
+    for (int c = 0; c < CascadeCount; ++c)
+        shader.SetMat4("u_CascadeMatrices[" + std::to_string(c) + "]", Cascades[c].LightViewProjection);
+    shader.SetVec4("u_CascadeSplits", Cascades[0].SplitFar, Cascades[1].SplitFar, Cascades[2].SplitFar,
+        Cascades[3].SplitFar);
+}
+
+// --------------------- Internal Helpers ---------------------
+GLuint JCascadedShadows::CreateDepthArray(int resolution, int layers, bool bCompare)
+{
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution, layers, 0,
+        GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+    // Linear filtering with comparison gives hardware 2x2 PCF
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, bCompare ? GL_LINEAR : GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, bCompare ? GL_LINEAR : GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    const float border[] = { 1.f, 1.f, 1.f, 1.f }; // outside the cascade counts as lit
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+    if (bCompare)
+    {
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return texture;
+}
+
+void JCascadedShadows::DrawCasters(const std::vector<const JActor*>& casters, const glm::mat4& lightViewProjection,
+                                   int cascade)
+{
+    if (casters.empty()) return;
+
+    Batcher.Begin();
+    for (const JActor* actor : casters)
+        Batcher.Submit(*actor);
+
+    DepthShader->Use();
+    DepthShader->SetMat4("u_LightViewProjection", lightViewProjection);
+    Batcher.Flush(*DepthShader, EVertexStream::PositionOnly);
+
+    Stats.Draws[cascade] += Batcher.GetDrawCount();
+    Stats.DrawCalls[cascade] += Batcher.GetSubmitCallCount();
+}
@@ -0,0 +1,145 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "JInstanceBatcher.h"
+
+class JActor;
+class JCamera;
+class JShader;
+
+/// Counters of the last JCascadedShadows::Render().
+struct FShadowStats
+{
+    static constexpr int MaxCascades = 4;
+
+    int Casters[MaxCascades] = {};    ///< Casters inside each cascade's light frustum
+    int Draws[MaxCascades] = {};      ///< Draw commands issued per cascade
+    int DrawCalls[MaxCascades] = {};  ///< GL draw calls per cascade
+    bool Cached[MaxCascades] = {};    ///< Static casters of the cascade came from the cache
+    int StaticRebuilds = 0;           ///< Cached cascades whose static casters were re-rendered
+
+    inline int GetTotalDraws() const
+    {
+        int total = 0;
+        for (int draws : Draws) total += draws;
+        return total;
+    }
+};
+
+/**
+ * @class JCascadedShadows
+ * @brief Directional cascaded shadow maps with cached static casters in the far cascades.
+ *
+ * The camera range up to the shadow distance is split into CascadeCount slices (practical
+ * split scheme, a blend of logarithmic and uniform splits). Each slice gets a bounding sphere
+ * and an orthographic light projection snapped to whole texels, so shadows don't shimmer when
+ * the camera moves or turns. All cascades live in one depth texture array.
+ *
+ * Casters are culled per cascade against its light frustum and drawn depth-only through a
+ * JInstanceBatcher from the geometry pool's position-only stream.
+ *
+ * Far cascades (index >= FirstCachedCascade) snap their center to a coarse grid, so their
+ * projection stays fixed for many frames. Their static casters (S_JActorRenderConfig::bIsStatic)
+ * are rendered into a separate cache only when the projection changes or a static caster inside
+ * them moved, appeared or disappeared. Every frame the cache is copied in and only the dynamic
+ * casters are drawn on top.
+ *
+ * Typical usage:
+ * @code
+ * Shadows.Update(camera, aspect, nearPlane, lightDirection);
+ * Shadows.Render(casters);
+ * Shadows.Bind(litShader);
+ * @endcode
+ */
+class JCascadedShadows {
+public:
+    static constexpr int CascadeCount = FShadowStats::MaxCascades;
+    static constexpr int FirstCachedCascade = 2;
+
+    /// Texture unit of the shadow map array, after the clustered lighting buffers.
+    static constexpr int TextureUnit = 11;
+
+    /**
+     * @param resolution Width and height of every cascade.
+     * @param shadowDistance View distance covered by the last cascade.
+     */
+    explicit JCascadedShadows(int resolution = 2048, float shadowDistance = 80.f);
+    ~JCascadedShadows();
+
+    /** @brief Delete the cascade targets, while the GL context is still current. */
+    void Shutdown();
+
+    JCascadedShadows(const JCascadedShadows&) = delete;
+    JCascadedShadows& operator=(const JCascadedShadows&) = delete;
+
+    /**
+     * @brief Fit the cascades to the camera.
+     * @param camera Camera the shadows are viewed from.
+     * @param aspect Aspect ratio of the camera's projection.
+     * @param nearPlane Near plane of the camera's projection.
+     * @param lightDirection Direction the light travels in (world space).
+     */
+    void Update(JCamera& camera, float aspect, float nearPlane, const glm::vec3& lightDirection);
+
+    /**
+     * @brief Render the shadow casters into the cascades.
+     * @param casters Candidate casters, culled per cascade. Actors without bCastShadows are skipped.
+     *
+     * Changes the framebuffer binding and viewport; rebind the scene target afterwards.
+     */
+    void Render(const std::vector<const JActor*>& casters);
+
+    /**
+     * @brief Bind the shadow map and cascade uniforms to a lit shader (left in use).
+     */
+    void Bind(JShader& shader) const;
+
+    inline void SetEnabled(bool bEnable) { bEnabled = bEnable; }
+    inline bool IsEnabled() const { return bEnabled; }
+
+    inline float GetShadowDistance() const { return ShadowDistance; }
+    inline const FShadowStats& GetStats() const { return Stats; }
+
+private:
+    struct FCascade
+    {
+        float SplitFar = 0.f;              ///< View depth where the cascade ends
+        glm::mat4 LightViewProjection = glm::mat4(1.f);
+
+        // Static cache state (far cascades only)
+        bool bCacheValid = false;
+        std::vector<std::pair<const JActor*, glm::mat4>> CachedCasters; ///< Static casters of the last cache render
+    };
+
+    int Resolution;
+    float ShadowDistance;
+    bool bEnabled = true;
+    glm::vec3 LightDirection = glm::vec3(0.f, -1.f, 0.f);
+
+    FCascade Cascades[CascadeCount];
+
+    GLuint DepthArray = 0;                           ///< Live cascades, sampled by the lit shaders
+    GLuint CacheArray = 0;                           ///< Static casters of the cached cascades
+    GLuint CascadeFBOs[CascadeCount] = {};
+    GLuint CacheFBOs[CascadeCount - FirstCachedCascade] = {};
+
+    std::unique_ptr<JShader> DepthShader;
+    JInstanceBatcher Batcher;
+
+    // Per-cascade scratch, reused every frame
+    std::vector<const JActor*> StaticCasters;
+    std::vector<const JActor*> DynamicCasters;
+    std::vector<std::pair<const JActor*, glm::mat4>> CurrentStatic;
+
+    FShadowStats Stats;
+
+    static GLuint CreateDepthArray(int resolution, int layers, bool bCompare);
+
+    /// Draw casters into the bound framebuffer with a light matrix and add the counts to the cascade's stats.
+    void DrawCasters(const std::vector<const JActor*>& casters, const glm::mat4& lightViewProjection, int cascade);
+};
@@ -0,0 +1,312 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JClusteredLighting.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "Core/JCpuProfiler.h"
+#include "Core/JJobSystem.h"
+#include "JRenderStats.h"
+#include "JShader.h"
+#include "Scene/JLightActor.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define JCLUSTER_SIMD_WIDTH 4
+#else
+    #define JCLUSTER_SIMD_WIDTH 1
+#endif
+
+namespace
+{
+    constexpr size_t kSimdWidth = JCLUSTER_SIMD_WIDTH;
+    constexpr int kTilesPerSlice = JClusteredLighting::GridX * JClusteredLighting::GridY;
+
+    /// Texels of light data per light.
+    constexpr size_t kTexelsPerLight = 4;
+
+    /// View depth of the near boundary of a slice, slices are spaced exponentially.
+    inline float SliceDepth(int slice, float nearPlane, float farPlane)
+    {
+        return nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(slice) / JClusteredLighting::GridZ);
+    }
+
+    GLuint CreateBufferTexture(GLuint& buffer, GLenum format)
+    {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        return texture;
+    }
+
+    void UploadBuffer(GLuint buffer, const void* data, size_t bytes)
+    {
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        // Orphan the previous contents so the upload doesn't wait on last frame's draws
+        glBufferData(GL_TEXTURE_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, data);
+        JRenderStats::CountUpload(bytes);
+    }
+}
+
+JClusteredLighting::JClusteredLighting()
+{
+    LightTexture = CreateBufferTexture(LightBuffer, GL_RGBA32F);
+    GridTexture = CreateBufferTexture(GridBuffer, GL_RG32UI);
+    IndexTexture = CreateBufferTexture(IndexBuffer, GL_R32UI);
+
+    ClusterMin.resize(ClusterCount);
+    ClusterMax.resize(ClusterCount);
+    Slices.resize(GridZ);
+    Grid.resize(ClusterCount * 2);
+}
+
+JClusteredLighting::~JClusteredLighting()
+{
+    Shutdown();
+}
+
+void JClusteredLighting::Shutdown()
+{
+    for (GLuint texture : { LightTexture, GridTexture, IndexTexture })
+        if (texture) glDeleteTextures(1, &texture);
+    for (GLuint buffer : { LightBuffer, GridBuffer, IndexBuffer })
+        if (buffer) glDeleteBuffers(1, &buffer);
+    LightTexture = GridTexture = IndexTexture = 0;
+    LightBuffer = GridBuffer = IndexBuffer = 0;
+}
+
+void JClusteredLighting::Build(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane,
+                               const std::vector<const JLightActor*>& lights, JJobSystem* jobs)
+{
+    J_PROFILE_SCOPE("Light Clustering");
+    Stats = FClusterStats();
+    Stats.Lights = static_cast<int>(lights.size());
+
+    if (projection != CachedProjection || nearPlane != CachedNear || farPlane != CachedFar)
+        BuildClusterBounds(projection, nearPlane, farPlane);
+
+    // Light data for the shaders (world space) and culling spheres (view space)
+    ViewSpheres.resize(lights.size());
+    LightData.resize(std::max<size_t>(lights.size(), 1) * kTexelsPerLight);
+    for (size_t i = 0; i < lights.size(); ++i)
+    {
+        const JLightActor& light = *lights[i];
+
+        glm::vec3 center;
+        float radius;
+        light.GetBoundingSphere(center, radius);
+        ViewSpheres[i] = glm::vec4(glm::vec3(view * glm::vec4(center, 1.f)), radius);
+
+        const bool bSpot = light.Type == ELightType::Spot;
+        glm::vec4* texels = &LightData[i * kTexelsPerLight];
+        texels[0] = glm::vec4(light.Position, light.Range);
+        texels[1] = glm::vec4(light.Color * light.Intensity, bSpot ? 1.f : 0.f);
+        texels[2] = glm::vec4(glm::normalize(light.Direction), light.InnerCutOff);
+        texels[3] = glm::vec4(light.OuterCutOff, 0.f, 0.f, 0.f);
+    }
+
+    // One job per depth slice, each slice owns its scratch
+    if (jobs)
+        jobs->ParallelFor(GridZ, 1, [this](size_t begin, size_t end)
+        {
+            for (size_t z = begin; z < end; ++z) AssignSlice(static_cast<int>(z));
+        });
+    else
+        for (int z = 0; z < GridZ; ++z) AssignSlice(z);
+
+    // Concatenate the slices' lists into one index buffer
+    Indices.clear();
+    LightVisible.assign(lights.size(), 0);
+    for (int z = 0; z < GridZ; ++z)
+    {
+        const FSlice& slice = Slices[z];
+        const uint32_t base = static_cast<uint32_t>(Indices.size());
+        Indices.insert(Indices.end(), slice.Indices.begin(), slice.Indices.end());
+
+        for (int tile = 0; tile < kTilesPerSlice; ++tile)
+        {
+            const size_t cluster = static_cast<size_t>(z) * kTilesPerSlice + tile;
+            Grid[cluster * 2] = base + slice.Offsets[tile];
+            Grid[cluster * 2 + 1] = slice.Counts[tile];
+
+            if (slice.Counts[tile] > 0) ++Stats.ActiveClusters;
+            Stats.MaxLightsPerCluster = std::max(Stats.MaxLightsPerCluster, static_cast<int>(slice.Counts[tile]));
+        }
+        for (uint32_t index : slice.Indices)
+            LightVisible[index] = 1;
+    }
+    Stats.LightIndices = static_cast<int>(Indices.size());
+    Stats.VisibleLights = static_cast<int>(std::count(LightVisible.begin(), LightVisible.end(), 1));
+
+    NearPlane = nearPlane;
+    FarPlane = farPlane;
+    Upload();
+}
+
+void JClusteredLighting::Bind(JShader& shader, int screenWidth, int screenHeight) const
+{
+    shader.Use();
+
+    glActiveTexture(GL_TEXTURE0 + FirstTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, LightTexture);
+    glActiveTexture(GL_TEXTURE0 + FirstTextureUnit + 1);
+    glBindTexture(GL_TEXTURE_BUFFER, GridTexture);
+    glActiveTexture(GL_TEXTURE0 + FirstTextureUnit + 2);
+    glBindTexture(GL_TEXTURE_BUFFER, IndexTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.SetInt("u_LightData", FirstTextureUnit);
+    shader.SetInt("u_ClusterGrid", FirstTextureUnit + 1);
+    shader.SetInt("u_LightIndices", FirstTextureUnit + 2);
+
+    // slice = log(depth) * scale + bias inverts SliceDepth()
+    const float logRatio = std::log(FarPlane / NearPlane);
+    shader.SetVec3("u_GridSize", static_cast<float>(GridX), static_cast<float>(GridY), static_cast<float>(GridZ));
+    shader.SetVec2("u_TileSize", static_cast<float>(screenWidth) / GridX, static_cast<float>(screenHeight) / GridY);
+    shader.SetFloat("u_ClusterScale", GridZ / logRatio);
+    shader.SetFloat("u_ClusterBias", -GridZ * std::log(NearPlane) / logRatio);
+}
+
+// --------------------- Internal Helpers ---------------------
+void JClusteredLighting::BuildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane)
+{
+    CachedProjection = projection;
+    CachedNear = nearPlane;
+    CachedFar = farPlane;
+
+    const glm::mat4 inverseProjection = glm::inverse(projection);
+
+    // View-space direction through an NDC point, scaled to unit view depth
+    auto RayAtUnitDepth = [&](float ndcX, float ndcY)
+    {
+        glm::vec4 point = inverseProjection * glm::vec4(ndcX, ndcY, -1.f, 1.f);
+        const glm::vec3 p = glm::vec3(point) / point.w;
+        return p / -p.z;
+    };
+
+    for (int z = 0; z < GridZ; ++z)
+    {
+        const float depthNear = SliceDepth(z, nearPlane, farPlane);
+        const float depthFar = SliceDepth(z + 1, nearPlane, farPlane);
+
+        for (int y = 0; y < GridY; ++y)
+        {
+            for (int x = 0; x < GridX; ++x)
+            {
+                const float x0 = -1.f + 2.f * x / GridX, x1 = -1.f + 2.f * (x + 1) / GridX;
+                const float y0 = -1.f + 2.f * y / GridY, y1 = -1.f + 2.f * (y + 1) / GridY;
+                const glm::vec3 rays[4] = {
+                    RayAtUnitDepth(x0, y0), RayAtUnitDepth(x1, y0), RayAtUnitDepth(x0, y1), RayAtUnitDepth(x1, y1)
+                };
+
+                glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+                for (const glm::vec3& ray : rays)
+                {
+                    for (float depth : { depthNear, depthFar })
+                    {
+                        boundsMin = glm::min(boundsMin, ray * depth);
+                        boundsMax = glm::max(boundsMax, ray * depth);
+                    }
+                }
+
+                const size_t cluster = static_cast<size_t>(z) * kTilesPerSlice + y * GridX + x;
+                ClusterMin[cluster] = boundsMin;
+                ClusterMax[cluster] = boundsMax;
+            }
+        }
+    }
+}
+
+void JClusteredLighting::AssignSlice(int z)
+{
+    FSlice& slice = Slices[z];
+    slice.CenterX.clear(); slice.CenterY.clear(); slice.CenterZ.clear();
+    slice.RadiusSq.clear(); slice.LightIndex.clear();
+    slice.Indices.clear();
+
+    // Keep only the lights overlapping the slice's depth range
+    const float depthNear = SliceDepth(z, CachedNear, CachedFar);
+    const float depthFar = SliceDepth(z + 1, CachedNear, CachedFar);
+    for (size_t i = 0; i < ViewSpheres.size(); ++i)
+    {
+        const glm::vec4& sphere = ViewSpheres[i];
+        const float depth = -sphere.z;
+        if (depth + sphere.w < depthNear || depth - sphere.w > depthFar) continue;
+
+        slice.CenterX.push_back(sphere.x);
+        slice.CenterY.push_back(sphere.y);
+        slice.CenterZ.push_back(sphere.z);
+        slice.RadiusSq.push_back(sphere.w * sphere.w);
+        slice.LightIndex.push_back(static_cast<uint32_t>(i));
+    }
+
+    // Padding lanes can never pass: any distance is >= 0 > -1
+    const size_t candidates = slice.LightIndex.size();
+    const size_t padded = (candidates + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    slice.CenterX.resize(padded, 0.f);
+    slice.CenterY.resize(padded, 0.f);
+    slice.CenterZ.resize(padded, 0.f);
+    slice.RadiusSq.resize(padded, -1.f);
+
+    for (int tile = 0; tile < kTilesPerSlice; ++tile)
+    {
+        const size_t cluster = static_cast<size_t>(z) * kTilesPerSlice + tile;
+        const glm::vec3& boxMin = ClusterMin[cluster];
+        const glm::vec3& boxMax = ClusterMax[cluster];
+
+        slice.Offsets[tile] = static_cast<uint32_t>(slice.Indices.size());
+
+#if JCLUSTER_SIMD_WIDTH == 4
+        const __m128 minX = _mm_set1_ps(boxMin.x), minY = _mm_set1_ps(boxMin.y), minZ = _mm_set1_ps(boxMin.z);
+        const __m128 maxX = _mm_set1_ps(boxMax.x), maxY = _mm_set1_ps(boxMax.y), maxZ = _mm_set1_ps(boxMax.z);
+
+        for (size_t i = 0; i < padded; i += 4)
+        {
+            // Squared distance from the sphere center to its closest point in the box
+            const __m128 cx = _mm_loadu_ps(&slice.CenterX[i]);
+            const __m128 cy = _mm_loadu_ps(&slice.CenterY[i]);
+            const __m128 cz = _mm_loadu_ps(&slice.CenterZ[i]);
+            const __m128 dx = _mm_sub_ps(cx, _mm_min_ps(_mm_max_ps(cx, minX), maxX));
+            const __m128 dy = _mm_sub_ps(cy, _mm_min_ps(_mm_max_ps(cy, minY), maxY));
+            const __m128 dz = _mm_sub_ps(cz, _mm_min_ps(_mm_max_ps(cz, minZ), maxZ));
+            const __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_loadu_ps(&slice.RadiusSq[i])));
+            if (mask == 0) continue;
+            for (int lane = 0; lane < 4; ++lane)
+                if (mask & (1 << lane)) slice.Indices.push_back(slice.LightIndex[i + lane]);
+        }
+#else
+        for (size_t i = 0; i < candidates; ++i)
+        {
+            const glm::vec3 center(slice.CenterX[i], slice.CenterY[i], slice.CenterZ[i]);
+            const glm::vec3 delta = center - glm::clamp(center, boxMin, boxMax);
+            if (glm::dot(delta, delta) <= slice.RadiusSq[i])
+                slice.Indices.push_back(slice.LightIndex[i]);
+        }
+#endif
+
+        slice.Counts[tile] = static_cast<uint32_t>(slice.Indices.size()) - slice.Offsets[tile];
+    }
+}
+
+void JClusteredLighting::Upload()
+{
+    // Texture buffers can't be empty, keep at least one element in each
+    if (Indices.empty()) Indices.push_back(0);
+
+    UploadBuffer(LightBuffer, LightData.data(), LightData.size() * sizeof(glm::vec4));
+    UploadBuffer(GridBuffer, Grid.data(), Grid.size() * sizeof(uint32_t));
+    UploadBuffer(IndexBuffer, Indices.data(), Indices.size() * sizeof(uint32_t));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
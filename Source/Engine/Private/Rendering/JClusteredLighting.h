@@ -0,0 +1,134 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class JJobSystem;
+class JLightActor;
+class JShader;
+
+/// Counters of the last JClusteredLighting::Build().
+struct FClusterStats
+{
+    int Lights = 0;              ///< Lights passed in
+    int VisibleLights = 0;       ///< Lights touching at least one cluster
+    int ActiveClusters = 0;      ///< Clusters with at least one light
+    int LightIndices = 0;        ///< Total entries in the index list
+    int MaxLightsPerCluster = 0;
+};
+
+/**
+ * @class JClusteredLighting
+ * @brief CPU clustered light culling for forward shading.
+ *
+ * The view frustum is split into GridX x GridY screen tiles and GridZ exponentially spaced
+ * depth slices. Every frame, Build() assigns each point/spot light to the clusters its bounding
+ * sphere overlaps, so a fragment only evaluates the handful of lights of its own cluster
+ * instead of every light in the scene.
+ *
+ * Assignment runs one job per depth slice: lights are first rejected against the slice's depth
+ * range, then the survivors are tested against every cluster of the slice with a 4-wide SIMD
+ * sphere-AABB test. Cluster bounds are in view space and only rebuilt when the projection changes.
+ *
+ * Results are uploaded into three texture buffers:
+ * - light data, 4 RGBA32F texels per light (position/range, color/type, direction/inner cone, outer cone),
+ * - the cluster grid, one RG32UI (offset, count) texel per cluster,
+ * - the light index list, R32UI.
+ *
+ * Typical usage:
+ * @code
+ * Lighting.Build(view, projection, nearPlane, farPlane, lights, GetJobSystem());
+ * Lighting.Bind(shader, screenWidth, screenHeight);
+ * // draw lit geometry
+ * @endcode
+ *
+ * Shaders read the grid as in ModelLoadingLit.frag: cluster = tile from gl_FragCoord, slice from
+ * log(view depth) * u_ClusterScale + u_ClusterBias.
+ */
+class JClusteredLighting {
+public:
+    static constexpr int GridX = 16;
+    static constexpr int GridY = 9;
+    static constexpr int GridZ = 24;
+    static constexpr int ClusterCount = GridX * GridY * GridZ;
+
+    /// First texture unit used by Bind(), above the material textures bound by JMesh.
+    static constexpr int FirstTextureUnit = 8;
+
+    JClusteredLighting();
+    ~JClusteredLighting();
+
+    /** @brief Delete the light buffers and textures, while the GL context is still current. */
+    void Shutdown();
+
+    JClusteredLighting(const JClusteredLighting&) = delete;
+    JClusteredLighting& operator=(const JClusteredLighting&) = delete;
+
+    /**
+     * @brief Assign lights to clusters and upload the result.
+     * @param view Camera view matrix.
+     * @param projection Camera perspective projection matrix.
+     * @param nearPlane Near plane distance of the projection.
+     * @param farPlane Far plane distance of the projection.
+     * @param lights Lights of the scene.
+     * @param jobs Optional job system, slices are processed in parallel when present.
+     */
+    void Build(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane,
+               const std::vector<const JLightActor*>& lights, JJobSystem* jobs);
+
+    /**
+     * @brief Bind the light buffers and grid parameters for a shader.
+     * @param shader Clustered shader, left in use.
+     * @param screenWidth Width of the target the shader renders to.
+     * @param screenHeight Height of the target the shader renders to.
+     */
+    void Bind(JShader& shader, int screenWidth, int screenHeight) const;
+
+    inline const FClusterStats& GetStats() const { return Stats; }
+
+private:
+    /// Per depth slice scratch, owned by the slice's job
+    struct FSlice
+    {
+        // Candidate lights (overlapping the slice's depth range), SoA padded to the SIMD width
+        std::vector<float> CenterX, CenterY, CenterZ, RadiusSq;
+        std::vector<uint32_t> LightIndex;
+
+        std::vector<uint32_t> Indices; ///< Light indices of the slice's clusters, back to back
+        uint32_t Offsets[GridX * GridY];
+        uint32_t Counts[GridX * GridY];
+    };
+
+    // View-space cluster bounds, rebuilt when the projection changes
+    std::vector<glm::vec3> ClusterMin;
+    std::vector<glm::vec3> ClusterMax;
+    glm::mat4 CachedProjection = glm::mat4(0.f);
+    float CachedNear = 0.f, CachedFar = 0.f;
+
+    // View-space light spheres of this frame
+    std::vector<glm::vec4> ViewSpheres;
+    std::vector<uint8_t> LightVisible;
+
+    std::vector<FSlice> Slices;
+
+    // CPU copies of the uploaded buffers
+    std::vector<glm::vec4> LightData;
+    std::vector<uint32_t> Grid;
+    std::vector<uint32_t> Indices;
+
+    GLuint LightBuffer = 0, LightTexture = 0;
+    GLuint GridBuffer = 0, GridTexture = 0;
+    GLuint IndexBuffer = 0, IndexTexture = 0;
+
+    float NearPlane = 0.1f;
+    float FarPlane = 100.f;
+    FClusterStats Stats;
+
+    void BuildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane);
+    void AssignSlice(int z);
+    void Upload();
+};
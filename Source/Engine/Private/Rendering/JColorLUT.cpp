@@ -0,0 +1,187 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JColorLUT.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Core/JJobSystem.h"
+#include "JRenderStats.h"
+#include "JShader.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define JCOLORLUT_SIMD_WIDTH 4
+#else
+    #define JCOLORLUT_SIMD_WIDTH 1
+#endif
+
+namespace
+{
+    const FColorOpInfo kColorOps[] = {
+        { "Grayscale", EColorOp::Grayscale, nullptr, false },
+        { "ColorInverter", EColorOp::ColorInverter, nullptr, false },
+        { "Posterize", EColorOp::Posterize, "levels", true },
+    };
+
+#if JCOLORLUT_SIMD_WIDTH == 4
+    /// floor() with SSE2 only: truncate, then step down where truncation rounded up.
+    inline __m128 Floor(__m128 x)
+    {
+        const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.f)));
+    }
+
+    /// Quantize [0, 1] to 0-255 in the low byte of each lane.
+    inline __m128i ToUnorm8(__m128 x)
+    {
+        x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.f));
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(255.f)), _mm_set1_ps(0.5f)));
+    }
+#else
+    inline uint32_t ToUnorm8(float x)
+    {
+        return static_cast<uint32_t>(std::min(std::max(x, 0.f), 1.f) * 255.f + 0.5f);
+    }
+#endif
+}
+
+JColorLUT::JColorLUT(int size)
+    : Size(std::max(4, size & ~3))
+{
+    Texels.resize(static_cast<size_t>(Size) * Size * Size);
+
+    glGenTextures(1, &Texture);
+    glBindTexture(GL_TEXTURE_3D, Texture);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_RGBA8, Size, Size, Size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_3D, 0);
+}
+
+JColorLUT::~JColorLUT()
+{
+    if (Texture) glDeleteTextures(1, &Texture);
+}
+
+const FColorOpInfo* JColorLUT::FindOp(const std::string& functionName)
+{
+    for (const FColorOpInfo& info : kColorOps)
+        if (functionName == info.FunctionName) return &info;
+    return nullptr;
+}
+
+bool JColorLUT::Update(const std::vector<FColorOp>& ops, JJobSystem* jobs)
+{
+    if (bBaked && ops == BakedOps) return false;
+
+    BakedOps = ops;
+    const size_t slices = static_cast<size_t>(Size);
+    if (jobs)
+        jobs->ParallelFor(slices, 4, [this](size_t begin, size_t end) { BakeSlices(begin, end); });
+    else
+        BakeSlices(0, slices);
+
+    glBindTexture(GL_TEXTURE_3D, Texture);
+    glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, Size, Size, Size, GL_RGBA, GL_UNSIGNED_BYTE, Texels.data());
+    JRenderStats::CountUpload(Texels.size() * sizeof(Texels[0]));
+    glBindTexture(GL_TEXTURE_3D, 0);
+
+    bBaked = true;
+    ++BakeCount;
+    return true;
+}
+
+void JColorLUT::Bind(JShader& shader) const
+{
+    shader.Use();
+
+    glActiveTexture(GL_TEXTURE0 + TextureUnit);
+    glBindTexture(GL_TEXTURE_3D, Texture);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.SetInt("u_ColorLUT", TextureUnit);
+    shader.SetFloat("u_ColorLUTSize", static_cast<float>(Size));
+}
+
+// --------------------- Internal Helpers ---------------------
+void JColorLUT::BakeSlices(size_t begin, size_t end)
+{
+    const float step = 1.f / static_cast<float>(Size - 1);
+
+    for (size_t z = begin; z < end; ++z)
+    {
+        for (int y = 0; y < Size; ++y)
+        {
+            uint32_t* row = &Texels[(z * Size + y) * Size];
+
+#if JCOLORLUT_SIMD_WIDTH == 4
+            const __m128 one = _mm_set1_ps(1.f);
+            const __m128 third = _mm_set1_ps(1.f / 3.f);
+            const __m128 lane = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+
+            for (int x = 0; x < Size; x += 4)
+            {
+                __m128 r = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane), _mm_set1_ps(step));
+                __m128 g = _mm_set1_ps(y * step);
+                __m128 b = _mm_set1_ps(z * step);
+
+                for (const FColorOp& op : BakedOps)
+                {
+                    switch (op.Op)
+                    {
+                    case EColorOp::Grayscale:
+                        r = g = b = _mm_mul_ps(_mm_add_ps(_mm_add_ps(r, g), b), third);
+                        break;
+                    case EColorOp::ColorInverter:
+                        r = _mm_sub_ps(one, r);
+                        g = _mm_sub_ps(one, g);
+                        b = _mm_sub_ps(one, b);
+                        break;
+                    case EColorOp::Posterize:
+                    {
+                        const __m128 levels = _mm_set1_ps(op.Param);
+                        r = _mm_div_ps(Floor(_mm_mul_ps(r, levels)), levels);
+                        g = _mm_div_ps(Floor(_mm_mul_ps(g, levels)), levels);
+                        b = _mm_div_ps(Floor(_mm_mul_ps(b, levels)), levels);
+                        break;
+                    }
+                    }
+                }
+
+                const __m128i rgba = _mm_or_si128(
+                    _mm_or_si128(ToUnorm8(r), _mm_slli_epi32(ToUnorm8(g), 8)),
+                    _mm_or_si128(_mm_slli_epi32(ToUnorm8(b), 16), _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), rgba);
+            }
+#else
+            for (int x = 0; x < Size; ++x)
+            {
+                float r = x * step, g = y * step, b = z * step;
+                for (const FColorOp& op : BakedOps)
+                {
+                    switch (op.Op)
+                    {
+                    case EColorOp::Grayscale:
+                        r = g = b = (r + g + b) / 3.f;
+                        break;
+                    case EColorOp::ColorInverter:
+                        r = 1.f - r;
+                        g = 1.f - g;
+                        b = 1.f - b;
+                        break;
+                    case EColorOp::Posterize:
+                        r = std::floor(r * op.Param) / op.Param;
+                        g = std::floor(g * op.Param) / op.Param;
+                        b = std::floor(b * op.Param) / op.Param;
+                        break;
+                    }
+                }
+                row[x] = ToUnorm8(r) | (ToUnorm8(g) << 8) | (ToUnorm8(b) << 16) | 0xFF000000u;
+            }
+#endif
+        }
+    }
+}
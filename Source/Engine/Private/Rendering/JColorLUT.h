@@ -0,0 +1,104 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JJobSystem;
+class JShader;
+
+/// Color-only post effects JColorLUT can evaluate on the CPU, mirrors of their GLSL functions.
+enum class EColorOp : uint8_t
+{
+    Grayscale,     ///< PostProcess/Grayscale
+    ColorInverter, ///< PostProcess/ColorInverter
+    Posterize      ///< PostProcess/Posterize, Param = levels
+};
+
+/// One baked effect and its parameter.
+struct FColorOp
+{
+    EColorOp Op = EColorOp::Grayscale;
+    float Param = 0.f;
+
+    bool operator==(const FColorOp& other) const { return Op == other.Op && Param == other.Param; }
+    bool operator!=(const FColorOp& other) const { return !(*this == other); }
+};
+
+/// Describes which post effect an EColorOp mirrors.
+struct FColorOpInfo
+{
+    const char* FunctionName; ///< Effect function, see JPostProcessor::GetFunctionName()
+    EColorOp Op;
+    const char* ParamUniform; ///< Uniform read into FColorOp::Param, null if the effect has none
+    bool bDiscontinuous;      ///< Has hard steps, which need a finer LUT to stay sharp
+};
+
+/**
+ * @class JColorLUT
+ * @brief Bakes a chain of color-only effects into a 3D lookup table.
+ *
+ * Effects whose output depends only on the input color (Grayscale, ColorInverter, Posterize)
+ * are evaluated on the CPU for every texel of a Size^3 RGBA8 grid over [0, 1]^3, four texels
+ * at a time with SSE, one job per blue slice. The whole chain then costs a single trilinear
+ * lookup in ColorLUT.frag, however many effects it contains.
+ *
+ * Update() only re-bakes when the ops or their parameters differ from the last bake.
+ * Discontinuous effects (posterization steps) are smoothed over one texel by the trilinear
+ * filter, which is why PostProcessManager picks the 64^3 size for them.
+ *
+ * Typical usage:
+ * @code
+ * LUT.Update({ { EColorOp::Grayscale }, { EColorOp::Posterize, 5.f } }, GetJobSystem());
+ * LUT.Bind(colorLUTShader);
+ * @endcode
+ */
+class JColorLUT {
+public:
+    /// Texture unit of the LUT, next to the post-process input on unit 0.
+    static constexpr int TextureUnit = 1;
+
+    /**
+     * @param size Texels per axis, a multiple of 4 (typically 32 or 64).
+     */
+    explicit JColorLUT(int size = 32);
+    ~JColorLUT();
+
+    JColorLUT(const JColorLUT&) = delete;
+    JColorLUT& operator=(const JColorLUT&) = delete;
+
+    /// CPU mirror of a post effect, null if the effect can't be baked.
+    static const FColorOpInfo* FindOp(const std::string& functionName);
+
+    /**
+     * @brief Re-bake and upload the LUT if the chain changed since the last bake.
+     * @param ops Effects in application order.
+     * @param jobs Optional job system, slices are baked in parallel when present.
+     * @return true if the LUT was re-baked.
+     */
+    bool Update(const std::vector<FColorOp>& ops, JJobSystem* jobs = nullptr);
+
+    /// Bind the LUT and set u_ColorLUT / u_ColorLUTSize on a shader.
+    void Bind(JShader& shader) const;
+
+    inline int GetSize() const { return Size; }
+
+    /// Number of bakes so far.
+    inline int GetBakeCount() const { return BakeCount; }
+
+private:
+    int Size;
+    GLuint Texture = 0;
+
+    std::vector<FColorOp> BakedOps;
+    bool bBaked = false;
+    int BakeCount = 0;
+
+    std::vector<uint32_t> Texels; ///< RGBA8, red fastest
+
+    /// Evaluate BakedOps for blue slices [begin, end).
+    void BakeSlices(size_t begin, size_t end);
+};
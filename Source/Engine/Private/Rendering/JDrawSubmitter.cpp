@@ -0,0 +1,138 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JDrawSubmitter.h"
+
+#include <algorithm>
+#include <glm/glm.hpp>
+#include "JGeometryPool.h"
+#include "JGLCapabilities.h"
+#include "JRenderStats.h"
+
+FDrawElementsIndirectCommand FDrawElementsIndirectCommand::FromRange(const FGeometryRange& range,
+    GLuint baseInstance, GLuint instanceCount)
+{
+    return { range.IndexCount, instanceCount, range.FirstIndex, range.BaseVertex, baseInstance };
+}
+
+JDrawSubmitter::JDrawSubmitter()
+{
+    bIndirect = JGLCapabilities::Get().HasMultiDrawIndirect();
+    if (bIndirect)
+        glGenBuffers(1, &IndirectBuffer);
+}
+
+JDrawSubmitter::~JDrawSubmitter()
+{
+    if (IndirectBuffer) glDeleteBuffers(1, &IndirectBuffer);
+}
+
+void JDrawSubmitter::SetForceFallback(bool bForce)
+{
+    bIndirect = !bForce && JGLCapabilities::Get().HasMultiDrawIndirect() && IndirectBuffer != 0;
+}
+
+void JDrawSubmitter::Upload(const std::vector<FDrawElementsIndirectCommand>& commands)
+{
+    CallCount = 0;
+    Commands = &commands;
+
+    if (!bIndirect || commands.empty()) return;
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, IndirectBuffer);
+    if (commands.size() > IndirectCapacity)
+    {
+        IndirectCapacity = std::max(commands.size(), IndirectCapacity * 2);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, IndirectCapacity * sizeof(FDrawElementsIndirectCommand),
+            nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(FDrawElementsIndirectCommand),
+        commands.data());
+    JRenderStats::CountUpload(commands.size() * sizeof(FDrawElementsIndirectCommand));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void JDrawSubmitter::Draw(size_t first, size_t count, GLuint instanceVBO)
+{
+    if (count == 0 || !Commands || first + count > Commands->size()) return;
+
+    if (bIndirect)
+        DrawIndirect(first, count, instanceVBO);
+    else
+        DrawFallback(first, count, instanceVBO);
+}
+
+// --------------------- Backends ---------------------
+void JDrawSubmitter::DrawIndirect(size_t first, size_t count, GLuint instanceVBO)
+{
+    // BaseInstance offsets instanced attributes, so the instance buffer is bound once from its start
+    JGeometryPool::Get().SetInstanceBuffer(instanceVBO, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, IndirectBuffer);
+    JGLCapabilities::Get().MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(first * sizeof(FDrawElementsIndirectCommand)),
+        static_cast<GLsizei>(count), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    uint64_t triangles = 0, instances = 0;
+    for (size_t i = first; i < first + count; ++i)
+    {
+        const FDrawElementsIndirectCommand& command = (*Commands)[i];
+        triangles += static_cast<uint64_t>(command.Count / 3) * command.InstanceCount;
+        instances += command.InstanceCount;
+    }
+    JRenderStats::CountMultiDraw(triangles, instances);
+
+    ++CallCount;
+}
+
+void JDrawSubmitter::DrawFallback(size_t first, size_t count, GLuint instanceVBO)
+{
+    const JGeometryPool& pool = JGeometryPool::Get();
+    const std::vector<FDrawElementsIndirectCommand>& commands = *Commands;
+
+    size_t i = first;
+    const size_t end = first + count;
+    while (i < end)
+    {
+        const FDrawElementsIndirectCommand& head = commands[i];
+        if (head.InstanceCount == 0)
+        {
+            ++i;
+            continue;
+        }
+
+        // No baseInstance in 3.3: re-point the instance attribute at this run's instances instead
+        pool.SetInstanceBuffer(instanceVBO, head.BaseInstance * sizeof(glm::mat4));
+
+        if (head.InstanceCount > 1)
+        {
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, head.Count, GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(static_cast<uintptr_t>(head.FirstIndex) * sizeof(GLuint)),
+                head.InstanceCount, head.BaseVertex);
+            JRenderStats::CountDraw(head.Count / 3, head.InstanceCount);
+            ++CallCount;
+            ++i;
+            continue;
+        }
+
+        // Merge the run of single-instance commands reading the same instance
+        MultiCounts.clear();
+        MultiOffsets.clear();
+        MultiBaseVertices.clear();
+        uint64_t triangles = 0;
+        while (i < end && commands[i].InstanceCount == 1 && commands[i].BaseInstance == head.BaseInstance)
+        {
+            MultiCounts.push_back(static_cast<GLsizei>(commands[i].Count));
+            MultiOffsets.push_back(reinterpret_cast<const void*>(
+                static_cast<uintptr_t>(commands[i].FirstIndex) * sizeof(GLuint)));
+            MultiBaseVertices.push_back(commands[i].BaseVertex);
+            triangles += commands[i].Count / 3;
+            ++i;
+        }
+
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, MultiCounts.data(), GL_UNSIGNED_INT,
+            MultiOffsets.data(), static_cast<GLsizei>(MultiCounts.size()), MultiBaseVertices.data());
+        JRenderStats::CountMultiDraw(triangles, MultiCounts.size());
+        ++CallCount;
+    }
+}
@@ -0,0 +1,90 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <vector>
+
+struct FGeometryRange;
+
+/**
+ * @struct FDrawElementsIndirectCommand
+ * @brief One indexed draw, laid out exactly as GL expects it in a GL_DRAW_INDIRECT_BUFFER.
+ */
+struct FDrawElementsIndirectCommand
+{
+    GLuint Count;         ///< Number of indices
+    GLuint InstanceCount; ///< Number of instances
+    GLuint FirstIndex;    ///< First index in the bound element buffer
+    GLint BaseVertex;     ///< Added to every index
+    GLuint BaseInstance;  ///< First element read from instanced attributes
+
+    static FDrawElementsIndirectCommand FromRange(const FGeometryRange& range, GLuint baseInstance, GLuint instanceCount);
+};
+
+/**
+ * @class JDrawSubmitter
+ * @brief Submits whole batches of geometry-pool draws in as few GL calls as possible.
+ *
+ * A pass uploads all of its commands once with Upload(), then issues them batch by batch
+ * with Draw() (typically one batch per material/state bucket). All commands are expected to
+ * reference the currently bound JGeometryPool VAO and the per-instance matrix buffer.
+ *
+ * Backends:
+ * - GL 4.3+: commands are written into an indirect buffer and a batch is a single
+ *   glMultiDrawElementsIndirect call. BaseInstance selects each draw's instance data.
+ * - GL 3.3 (the profile JEngine requests): consecutive single-instance commands that share
+ *   a BaseInstance are merged into one glMultiDrawElementsBaseVertex call after pointing the
+ *   instance attribute at that BaseInstance. Multi-instance commands fall back to
+ *   glDrawElementsInstancedBaseVertex, since 3.3 has no instanced multi-draw.
+ */
+class JDrawSubmitter {
+public:
+    JDrawSubmitter();
+    ~JDrawSubmitter();
+
+    JDrawSubmitter(const JDrawSubmitter&) = delete;
+    JDrawSubmitter& operator=(const JDrawSubmitter&) = delete;
+
+    /**
+     * @brief Upload the commands of a whole pass. Resets the per-pass call counter.
+     * @param commands All commands of the pass, batches are contiguous sub-ranges. Not copied: the
+     *        vector must stay alive and unchanged until the pass' last Draw().
+     */
+    void Upload(const std::vector<FDrawElementsIndirectCommand>& commands);
+
+    /**
+     * @brief Issue a contiguous range of the uploaded commands.
+     * @param first Index of the first command.
+     * @param count Number of commands.
+     * @param instanceVBO Buffer holding one mat4 per instance.
+     */
+    void Draw(size_t first, size_t count, GLuint instanceVBO);
+
+    /// True when the indirect (GL 4.3) backend is in use.
+    inline bool IsIndirect() const { return bIndirect; }
+
+    /// Number of GL draw calls issued since the last Upload().
+    inline int GetCallCount() const { return CallCount; }
+
+    /// Force the 3.3 backend even when indirect drawing is available (debugging/benchmarks).
+    void SetForceFallback(bool bForce);
+
+private:
+    bool bIndirect = false;
+    int CallCount = 0;
+
+    GLuint IndirectBuffer = 0;
+    size_t IndirectCapacity = 0; ///< In commands
+
+    const std::vector<FDrawElementsIndirectCommand>* Commands = nullptr; ///< Caller's commands of the pass
+
+    // Scratch arrays for glMultiDrawElementsBaseVertex
+    std::vector<GLsizei> MultiCounts;
+    std::vector<const void*> MultiOffsets;
+    std::vector<GLint> MultiBaseVertices;
+
+    void DrawIndirect(size_t first, size_t count, GLuint instanceVBO);
+    void DrawFallback(size_t first, size_t count, GLuint instanceVBO);
+};
@@ -0,0 +1,135 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JDynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /// Weight of a new measurement in the smoothed GPU time.
+    constexpr float kSmoothing = 0.2f;
+}
+
+JDynamicResolution::JDynamicResolution()
+{
+    for (FFrameQueries& frame : Frames)
+    {
+        glGenQueries(1, &frame.Begin);
+        glGenQueries(1, &frame.End);
+    }
+    State.Scale = Settings.MaxScale;
+    State.TargetGpuMs = Settings.TargetGpuMs;
+}
+
+JDynamicResolution::~JDynamicResolution()
+{
+    for (FFrameQueries& frame : Frames)
+    {
+        if (frame.Begin) glDeleteQueries(1, &frame.Begin);
+        if (frame.End) glDeleteQueries(1, &frame.End);
+    }
+}
+
+void JDynamicResolution::BeginFrame()
+{
+    // Oldest frames first, the GPU finishes them in order
+    State.PendingQueries = 0;
+    for (int i = 1; i <= QueryLatency; ++i)
+    {
+        FFrameQueries& frame = Frames[(Head + i) % QueryLatency];
+        if (!frame.bPending) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(frame.End, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            ++State.PendingQueries;
+            continue;
+        }
+
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.Begin, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.End, GL_QUERY_RESULT, &end);
+        frame.bPending = false;
+        AddSample(static_cast<float>(end - begin) * 1e-6f);
+    }
+
+    Head = (Head + 1) % QueryLatency;
+    FFrameQueries& frame = Frames[Head];
+
+    // Still in flight after QueryLatency frames: skip timing rather than wait
+    bRecording = !frame.bPending;
+    if (bRecording)
+        glQueryCounter(frame.Begin, GL_TIMESTAMP);
+}
+
+void JDynamicResolution::EndFrame()
+{
+    if (!bRecording) return;
+
+    glQueryCounter(Frames[Head].End, GL_TIMESTAMP);
+    Frames[Head].bPending = true;
+    bRecording = false;
+}
+
+void JDynamicResolution::GetRenderSize(int outputWidth, int outputHeight, int& renderWidth, int& renderHeight)
+{
+    renderWidth = std::max(1, static_cast<int>(std::lround(outputWidth * State.Scale)));
+    renderHeight = std::max(1, static_cast<int>(std::lround(outputHeight * State.Scale)));
+    State.RenderWidth = renderWidth;
+    State.RenderHeight = renderHeight;
+}
+
+void JDynamicResolution::SetEnabled(bool bEnable)
+{
+    State.bEnabled = bEnable;
+    if (!bEnable) State.Scale = Quantize(Settings.MaxScale);
+}
+
+void JDynamicResolution::SetSettings(const FDynamicResolutionSettings& settings)
+{
+    Settings = settings;
+    Settings.MinScale = std::max(Settings.MinScale, 0.05f);
+    Settings.MaxScale = std::max(Settings.MaxScale, Settings.MinScale);
+    Settings.ScaleStep = std::max(Settings.ScaleStep, 0.01f);
+    State.TargetGpuMs = Settings.TargetGpuMs;
+    State.Scale = State.bEnabled ? Quantize(State.Scale) : Quantize(Settings.MaxScale);
+}
+
+// --------------------- Controller ---------------------
+void JDynamicResolution::AddSample(float gpuMs)
+{
+    State.bTimerAvailable = true;
+    State.LastGpuMs = gpuMs;
+
+    // Frames rendered before the last change don't describe the new resolution
+    if (SettleFrames > 0)
+    {
+        --SettleFrames;
+        return;
+    }
+    State.GpuMs = State.GpuMs > 0.f ? State.GpuMs + (gpuMs - State.GpuMs) * kSmoothing : gpuMs;
+    if (!State.bEnabled || State.GpuMs <= 0.f) return;
+
+    const float load = State.GpuMs / Settings.TargetGpuMs;
+    float scale = State.Scale;
+    if (load > 1.f + Settings.Deadband)
+        scale = Quantize(State.Scale * std::sqrt(1.f / load)); // Over budget: drop to the estimate at once
+    else if (load < 1.f - Settings.Deadband)
+        scale = Quantize(std::min(State.Scale * std::sqrt(1.f / load), State.Scale + Settings.ScaleStep));
+
+    if (scale == State.Scale) return;
+
+    State.Scale = scale;
+    ++State.Adjustments;
+    SettleFrames = QueryLatency;
+    State.GpuMs = 0.f;
+}
+
+float JDynamicResolution::Quantize(float scale) const
+{
+    // Round down so that a drop always lands under the estimate
+    const float steps = std::floor(scale / Settings.ScaleStep + 1e-3f);
+    return std::min(std::max(steps * Settings.ScaleStep, Settings.MinScale), Settings.MaxScale);
+}
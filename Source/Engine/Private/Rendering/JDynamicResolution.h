@@ -0,0 +1,104 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+
+/// Tuning of JDynamicResolution.
+struct FDynamicResolutionSettings
+{
+    float TargetGpuMs = 10.f; ///< Budget of the measured passes, leave room for post-processing and UI
+    float MinScale = 0.5f;    ///< Lowest render scale per axis
+    float MaxScale = 1.f;     ///< Highest render scale per axis
+    float ScaleStep = 0.05f;  ///< Scales are multiples of this, every change reallocates the scene targets
+    float Deadband = 0.1f;    ///< Relative distance to the budget within which the scale holds
+};
+
+/// Controller state, for telemetry.
+struct FDynamicResolutionState
+{
+    bool bEnabled = false;        ///< Opt-in, see JDynamicResolution::SetEnabled()
+    bool bTimerAvailable = false; ///< At least one GPU time has been measured
+    float Scale = 1.f;            ///< Current render scale per axis
+    float GpuMs = 0.f;            ///< Smoothed GPU time of the measured passes
+    float LastGpuMs = 0.f;        ///< Latest raw measurement
+    float TargetGpuMs = 0.f;
+    int RenderWidth = 0;          ///< Render size at Scale, see GetRenderSize()
+    int RenderHeight = 0;
+    int Adjustments = 0;          ///< Scale changes since creation
+    int PendingQueries = 0;       ///< Frames in flight whose GPU time is not known yet
+};
+
+/**
+ * @class JDynamicResolution
+ * @brief Scales the internal render resolution to keep the GPU time of a pass within a budget.
+ *
+ * BeginFrame() and EndFrame() bracket the measured passes with GL_TIMESTAMP queries. Queries are
+ * kept in a ring of QueryLatency frames and read back only once available, so the controller
+ * never stalls on the GPU; it reacts to timings a few frames old.
+ *
+ * GPU time is assumed to grow with the pixel count, so the scale per axis moves with the square
+ * root of budget / time. Over budget the scale drops at once, under budget it rises one step at
+ * a time, and within the deadband it holds. After each change the controller waits until the
+ * queries issued at the new resolution come back, so it never reacts twice to the same load.
+ *
+ * Typical usage (JRenderer does this around the scene pass):
+ * @code
+ * DynamicResolution.BeginFrame();
+ * DynamicResolution.GetRenderSize(screenWidth, screenHeight, renderWidth, renderHeight);
+ * // ... render the scene at renderWidth x renderHeight ...
+ * DynamicResolution.EndFrame();
+ * @endcode
+ */
+class JDynamicResolution {
+public:
+    /// Frames of timestamp queries in flight.
+    static constexpr int QueryLatency = 4;
+
+    JDynamicResolution();
+    ~JDynamicResolution();
+
+    JDynamicResolution(const JDynamicResolution&) = delete;
+    JDynamicResolution& operator=(const JDynamicResolution&) = delete;
+
+    /** @brief Read back finished frames, update the scale and start timing this frame. */
+    void BeginFrame();
+
+    /** @brief Stop timing this frame. */
+    void EndFrame();
+
+    /** @brief Render size for an output size at the current scale, at least one pixel. */
+    void GetRenderSize(int outputWidth, int outputHeight, int& renderWidth, int& renderHeight);
+
+    /** @brief Disabled by default. When disabled the scale returns to MaxScale and stays there. */
+    void SetEnabled(bool bEnable);
+    inline bool IsEnabled() const { return State.bEnabled; }
+
+    void SetSettings(const FDynamicResolutionSettings& settings);
+    inline const FDynamicResolutionSettings& GetSettings() const { return Settings; }
+
+    inline float GetScale() const { return State.Scale; }
+    inline const FDynamicResolutionState& GetState() const { return State; }
+
+private:
+    struct FFrameQueries
+    {
+        GLuint Begin = 0;
+        GLuint End = 0;
+        bool bPending = false;
+    };
+
+    FDynamicResolutionSettings Settings;
+    FDynamicResolutionState State;
+
+    FFrameQueries Frames[QueryLatency];
+    int Head = 0;           ///< Slot of the frame being recorded
+    bool bRecording = false;
+    int SettleFrames = 0;   ///< Measurements to skip after a scale change
+
+    /// Feed one GPU time into the smoothed value and adjust the scale.
+    void AddSample(float gpuMs);
+
+    float Quantize(float scale) const;
+};
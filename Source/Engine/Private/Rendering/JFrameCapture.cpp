@@ -0,0 +1,654 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JFrameCapture.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    /// Timeout of one wait on a fence while draining the ring, in nanoseconds.
+    constexpr GLuint64 kDrainTimeout = 100'000'000;
+
+    /// LZ77 window of deflate, and the longest match it can encode.
+    constexpr int kDeflateWindow = 32768;
+    constexpr int kMaxMatch = 258;
+
+    /// Hash chain entries tried per position, trades speed for ratio.
+    constexpr int kMaxChain = 32;
+    constexpr int kHashBits = 15;
+
+    // --------------------- PNG ---------------------
+    const std::array<uint32_t, 256>& GetCrcTable()
+    {
+        static const std::array<uint32_t, 256> table = []
+        {
+            std::array<uint32_t, 256> result{};
+            for (uint32_t n = 0; n < 256; ++n)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                result[n] = c;
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    uint32_t UpdateCrc(uint32_t crc, const uint8_t* data, size_t size)
+    {
+        const std::array<uint32_t, 256>& table = GetCrcTable();
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return crc;
+    }
+
+    void AppendBigEndian(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void AppendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data)
+    {
+        AppendBigEndian(out, static_cast<uint32_t>(data.size()));
+        const size_t typeStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        const uint32_t crc = UpdateCrc(0xFFFFFFFFu, out.data() + typeStart, out.size() - typeStart) ^ 0xFFFFFFFFu;
+        AppendBigEndian(out, crc);
+    }
+
+    // ------------------- Deflate -------------------
+    constexpr uint16_t kLengthBase[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    constexpr uint8_t kLengthExtra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    constexpr uint16_t kDistanceBase[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+        4097, 6145, 8193, 12289, 16385, 24577
+    };
+    constexpr uint8_t kDistanceExtra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    /// Deflate bit stream, values are packed least significant bit first.
+    class FBitWriter
+    {
+    public:
+        explicit FBitWriter(std::vector<uint8_t>& out) : Out(out) {}
+
+        void Write(uint32_t value, int count)
+        {
+            Bits |= value << Count;
+            Count += count;
+            for (; Count >= 8; Count -= 8, Bits >>= 8)
+                Out.push_back(static_cast<uint8_t>(Bits));
+        }
+
+        /// Huffman codes are packed most significant bit first.
+        void WriteCode(uint32_t code, int length)
+        {
+            uint32_t reversed = 0;
+            for (int i = 0; i < length; ++i, code >>= 1)
+                reversed = (reversed << 1) | (code & 1);
+            Write(reversed, length);
+        }
+
+        void Flush()
+        {
+            if (Count > 0) Out.push_back(static_cast<uint8_t>(Bits));
+            Bits = 0;
+            Count = 0;
+        }
+
+    private:
+        std::vector<uint8_t>& Out;
+        uint32_t Bits = 0;
+        int Count = 0;
+    };
+
+    /// Literal/length symbol with the fixed Huffman code of RFC 1951 3.2.6.
+    void WriteFixedSymbol(FBitWriter& writer, int symbol)
+    {
+        if (symbol < 144)      writer.WriteCode(0x30 + symbol, 8);
+        else if (symbol < 256) writer.WriteCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280) writer.WriteCode(symbol - 256, 7);
+        else                   writer.WriteCode(0xC0 + symbol - 280, 8);
+    }
+
+    void WriteMatch(FBitWriter& writer, int length, int distance)
+    {
+        int l = 0;
+        while (l < 28 && kLengthBase[l + 1] <= length) ++l;
+        WriteFixedSymbol(writer, 257 + l);
+        writer.Write(length - kLengthBase[l], kLengthExtra[l]);
+
+        int d = 0;
+        while (d < 29 && kDistanceBase[d + 1] <= distance) ++d;
+        writer.WriteCode(d, 5);
+        writer.Write(distance - kDistanceBase[d], kDistanceExtra[d]);
+    }
+
+    uint32_t HashTriplet(const uint8_t* data)
+    {
+        const uint32_t triplet = (data[0] << 16) | (data[1] << 8) | data[2];
+        return (triplet * 2654435761u) >> (32 - kHashBits);
+    }
+
+    /// zlib stream of a single fixed-Huffman deflate block, greedy LZ77 matches over hash chains.
+    std::vector<uint8_t> CompressZlib(const std::vector<uint8_t>& raw)
+    {
+        std::vector<uint8_t> out;
+        out.reserve(raw.size() / 2 + 64);
+        out.push_back(0x78);
+        out.push_back(0x01);
+
+        FBitWriter writer(out);
+        writer.Write(1, 1); // Final block
+        writer.Write(1, 2); // Fixed Huffman codes
+
+        const int size = static_cast<int>(raw.size());
+        std::vector<int32_t> head(size_t(1) << kHashBits, -1);
+        std::vector<int32_t> prev(kDeflateWindow, -1);
+        const auto insert = [&](int pos)
+        {
+            if (pos + 3 > size) return;
+            const uint32_t hash = HashTriplet(&raw[pos]);
+            prev[pos & (kDeflateWindow - 1)] = head[hash];
+            head[hash] = pos;
+        };
+
+        for (int pos = 0; pos < size;)
+        {
+            int bestLength = 0, bestDistance = 0;
+            if (pos + 3 <= size)
+            {
+                const int maxLength = std::min(kMaxMatch, size - pos);
+                int candidate = head[HashTriplet(&raw[pos])];
+                for (int chain = kMaxChain; candidate >= 0 && pos - candidate <= kDeflateWindow && chain > 0; --chain)
+                {
+                    int length = 0;
+                    while (length < maxLength && raw[candidate + length] == raw[pos + length]) ++length;
+                    if (length > bestLength)
+                    {
+                        bestLength = length;
+                        bestDistance = pos - candidate;
+                        if (length == maxLength) break;
+                    }
+                    candidate = prev[candidate & (kDeflateWindow - 1)];
+                }
+            }
+
+            if (bestLength >= 3)
+            {
+                WriteMatch(writer, bestLength, bestDistance);
+                for (const int end = pos + bestLength; pos < end; ++pos) insert(pos);
+            }
+            else
+            {
+                WriteFixedSymbol(writer, raw[pos]);
+                insert(pos++);
+            }
+        }
+        WriteFixedSymbol(writer, 256); // End of block
+        writer.Flush();
+
+        // Adler-32, reduced often enough to stay in 32 bits
+        uint32_t a = 1, b = 0;
+        for (size_t i = 0; i < raw.size();)
+        {
+            const size_t end = std::min(raw.size(), i + 5552);
+            for (; i < end; ++i)
+            {
+                a += raw[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        AppendBigEndian(out, (b << 16) | a);
+        return out;
+    }
+
+    uint8_t Paeth(int a, int b, int c)
+    {
+        const int p = a + b - c;
+        const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc) return static_cast<uint8_t>(a);
+        return static_cast<uint8_t>(pb <= pc ? b : c);
+    }
+
+    /// RGB PNG from RGBA8 pixels stored bottom row first.
+    std::vector<uint8_t> EncodePng(const std::vector<uint8_t>& pixels, int width, int height)
+    {
+        constexpr size_t kPixelBytes = 3;
+        const size_t rowBytes = static_cast<size_t>(width) * kPixelBytes;
+        std::vector<uint8_t> rgb(rowBytes * height);
+        for (int y = 0; y < height; ++y)
+        {
+            const uint8_t* src = pixels.data() + static_cast<size_t>(height - 1 - y) * width * 4;
+            uint8_t* dst = rgb.data() + y * rowBytes;
+            for (int x = 0; x < width; ++x, src += 4)
+            {
+                *dst++ = src[0];
+                *dst++ = src[1];
+                *dst++ = src[2];
+            }
+        }
+
+        // Each row takes the filter with the smallest sum of signed residuals, as libpng does
+        std::vector<uint8_t> raw((rowBytes + 1) * height);
+        std::array<std::vector<uint8_t>, 5> filtered;
+        for (std::vector<uint8_t>& row : filtered) row.resize(rowBytes);
+        const std::vector<uint8_t> zeroRow(rowBytes, 0);
+        for (int y = 0; y < height; ++y)
+        {
+            const uint8_t* row = rgb.data() + y * rowBytes;
+            const uint8_t* up = y > 0 ? row - rowBytes : zeroRow.data();
+            for (size_t i = 0; i < rowBytes; ++i)
+            {
+                const int left = i >= kPixelBytes ? row[i - kPixelBytes] : 0;
+                const int upLeft = i >= kPixelBytes ? up[i - kPixelBytes] : 0;
+                filtered[0][i] = row[i];
+                filtered[1][i] = static_cast<uint8_t>(row[i] - left);
+                filtered[2][i] = static_cast<uint8_t>(row[i] - up[i]);
+                filtered[3][i] = static_cast<uint8_t>(row[i] - ((left + up[i]) >> 1));
+                filtered[4][i] = static_cast<uint8_t>(row[i] - Paeth(left, up[i], upLeft));
+            }
+
+            size_t bestFilter = 0;
+            uint64_t bestCost = UINT64_MAX;
+            for (size_t f = 0; f < filtered.size(); ++f)
+            {
+                uint64_t cost = 0;
+                for (const uint8_t value : filtered[f]) cost += std::abs(static_cast<int8_t>(value));
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestFilter = f;
+                }
+            }
+
+            uint8_t* dst = raw.data() + y * (rowBytes + 1);
+            *dst++ = static_cast<uint8_t>(bestFilter);
+            std::copy(filtered[bestFilter].begin(), filtered[bestFilter].end(), dst);
+        }
+
+        std::vector<uint8_t> header;
+        AppendBigEndian(header, static_cast<uint32_t>(width));
+        AppendBigEndian(header, static_cast<uint32_t>(height));
+        header.insert(header.end(), { 8, 2, 0, 0, 0 }); // 8 bit, RGB, deflate, adaptive filter, no interlace
+
+        std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        AppendChunk(png, "IHDR", header);
+        AppendChunk(png, "IDAT", CompressZlib(raw));
+        AppendChunk(png, "IEND", {});
+        return png;
+    }
+
+    // --------------------- Y4M ---------------------
+    uint8_t ToByte(float value)
+    {
+        return static_cast<uint8_t>(std::min(std::max(value + 0.5f, 0.f), 255.f));
+    }
+
+    /// Full-range BT.601 4:2:0 planes from RGBA8 pixels stored bottom row first.
+    void EncodeYuv420(const std::vector<uint8_t>& pixels, int width, int height, std::vector<uint8_t>& out)
+    {
+        const int chromaWidth = (width + 1) / 2;
+        const int chromaHeight = (height + 1) / 2;
+        const size_t lumaSize = static_cast<size_t>(width) * height;
+        const size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+        out.resize(lumaSize + chromaSize * 2);
+
+        auto texel = [&](int x, int y) -> const uint8_t*
+        {
+            return pixels.data() + (static_cast<size_t>(height - 1 - y) * width + x) * 4;
+        };
+
+        uint8_t* luma = out.data();
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const uint8_t* p = texel(x, y);
+                *luma++ = ToByte(0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2]);
+            }
+        }
+
+        uint8_t* cb = out.data() + lumaSize;
+        uint8_t* cr = cb + chromaSize;
+        for (int y = 0; y < chromaHeight; ++y)
+        {
+            const int y0 = y * 2, y1 = std::min(y0 + 1, height - 1);
+            for (int x = 0; x < chromaWidth; ++x)
+            {
+                const int x0 = x * 2, x1 = std::min(x0 + 1, width - 1);
+                const uint8_t* p[4] = { texel(x0, y0), texel(x1, y0), texel(x0, y1), texel(x1, y1) };
+                const float r = (p[0][0] + p[1][0] + p[2][0] + p[3][0]) * 0.25f;
+                const float g = (p[0][1] + p[1][1] + p[2][1] + p[3][1]) * 0.25f;
+                const float b = (p[0][2] + p[1][2] + p[2][2] + p[3][2]) * 0.25f;
+                *cb++ = ToByte(128.f - 0.168736f * r - 0.331264f * g + 0.5f * b);
+                *cr++ = ToByte(128.f + 0.5f * r - 0.418688f * g - 0.081312f * b);
+            }
+        }
+    }
+
+    bool OpenOutput(std::ofstream& file, const std::string& path)
+    {
+        const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        std::error_code error;
+        if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            std::cerr << "[JFrameCapture] Could not open '" << path << "' for writing." << std::endl;
+        return static_cast<bool>(file);
+    }
+}
+
+JFrameCapture::JFrameCapture()
+{
+    for (FReadback& slot : Ring)
+        glGenBuffers(1, &slot.PBO);
+    Writer = std::thread(&JFrameCapture::WriterLoop, this);
+}
+
+JFrameCapture::~JFrameCapture()
+{
+    Shutdown();
+}
+
+void JFrameCapture::Shutdown()
+{
+    if (!Writer.joinable()) return;
+
+    StopRecording();
+    CollectReadbacks(true);
+    CloseVideoIfDone();
+
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        bStopping = true;
+    }
+    JobCondition.notify_all();
+    Writer.join();
+
+    for (FReadback& slot : Ring)
+    {
+        if (slot.Fence) glDeleteSync(slot.Fence);
+        if (slot.PBO) glDeleteBuffers(1, &slot.PBO);
+        slot.Fence = nullptr;
+        slot.PBO = 0;
+        slot.Capacity = 0;
+    }
+}
+
+void JFrameCapture::RequestScreenshot(const std::string& path)
+{
+    PendingScreenshot = path;
+}
+
+void JFrameCapture::StartRecording(const std::string& path, int framesPerSecond)
+{
+    StopRecording();
+
+    // The previous stream must be closed before a new one opens on the writer
+    if (bVideoOpen)
+    {
+        CollectReadbacks(true);
+        CloseVideoIfDone();
+    }
+
+    bRecording = true;
+    VideoPath = path;
+    VideoFramesPerSecond = std::max(framesPerSecond, 1);
+    VideoWidth = VideoHeight = 0;
+}
+
+void JFrameCapture::StopRecording()
+{
+    bRecording = false;
+}
+
+void JFrameCapture::EndFrame(int width, int height)
+{
+    if (!Writer.joinable()) return; // Shut down
+
+    CollectReadbacks(false);
+    CloseVideoIfDone();
+    if (width <= 0 || height <= 0) return;
+
+    if (!PendingScreenshot.empty() && IssueReadback(width, height, EJob::Screenshot, PendingScreenshot))
+        PendingScreenshot.clear();
+
+    if (bRecording)
+    {
+        // The stream takes the size of its first frame
+        if (!bVideoOpen)
+        {
+            FJob open;
+            open.Kind = EJob::OpenVideo;
+            open.Path = VideoPath;
+            open.Width = VideoWidth = width;
+            open.Height = VideoHeight = height;
+            open.FramesPerSecond = VideoFramesPerSecond;
+            PushJob(std::move(open));
+            bVideoOpen = true;
+        }
+
+        const bool bFits = width == VideoWidth && height == VideoHeight;
+        if (!bFits || GetQueuedCount() >= MaxQueuedFrames || !IssueReadback(width, height, EJob::VideoFrame, VideoPath))
+            ++Stats.FramesDropped;
+    }
+}
+
+FFrameCaptureStats JFrameCapture::GetStats() const
+{
+    FFrameCaptureStats stats = Stats;
+    stats.FramesWritten = FramesWritten.load();
+    stats.BytesWritten = BytesWritten.load();
+    stats.PendingReadbacks = InFlight;
+    stats.QueuedWrites = static_cast<int>(GetQueuedCount());
+    return stats;
+}
+
+// --------------------- Readback ---------------------
+void JFrameCapture::CollectReadbacks(bool bWait)
+{
+    while (InFlight > 0)
+    {
+        FReadback& slot = Ring[(Head - InFlight + RingSize) % RingSize];
+
+        // Without bWait only poll: a slot that isn't done stops the walk, later ones can't be either
+        const GLenum status = bWait
+            ? glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, kDrainTimeout)
+            : glClientWaitSync(slot.Fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            if (bWait) continue;
+            break;
+        }
+
+        glDeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+        --InFlight;
+        if (status == GL_WAIT_FAILED) continue;
+
+        FJob job;
+        job.Kind = slot.Kind;
+        job.Path = slot.Path;
+        job.Width = slot.Width;
+        job.Height = slot.Height;
+
+        const size_t size = static_cast<size_t>(slot.Width) * slot.Height * 4;
+        job.Pixels = TakeBuffer(size);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+        const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT);
+        if (data)
+        {
+            std::memcpy(job.Pixels.data(), data, size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (data) PushJob(std::move(job));
+    }
+}
+
+void JFrameCapture::CloseVideoIfDone()
+{
+    if (bRecording || !bVideoOpen) return;
+    for (int i = 1; i <= InFlight; ++i)
+    {
+        if (Ring[(Head - i + RingSize) % RingSize].Kind == EJob::VideoFrame)
+            return;
+    }
+
+    FJob close;
+    close.Kind = EJob::CloseVideo;
+    PushJob(std::move(close));
+    bVideoOpen = false;
+}
+
+bool JFrameCapture::IssueReadback(int width, int height, EJob kind, const std::string& path)
+{
+    if (InFlight == RingSize) return false;
+
+    FReadback& slot = Ring[Head];
+    const size_t size = static_cast<size_t>(width) * height * 4;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+    if (slot.Capacity < size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot.Capacity = size;
+    }
+
+    // With a pack buffer bound the copy is queued on the GPU and glReadPixels returns at once
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.Width = width;
+    slot.Height = height;
+    slot.Kind = kind;
+    slot.Path = path;
+
+    Head = (Head + 1) % RingSize;
+    ++InFlight;
+    ++Stats.FramesRead;
+    return true;
+}
+
+// --------------------- Writer ---------------------
+void JFrameCapture::PushJob(FJob&& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Jobs.push_back(std::move(job));
+    }
+    JobCondition.notify_one();
+}
+
+std::vector<uint8_t> JFrameCapture::TakeBuffer(size_t size)
+{
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (!FreeBuffers.empty())
+        {
+            buffer = std::move(FreeBuffers.back());
+            FreeBuffers.pop_back();
+        }
+    }
+    buffer.resize(size);
+    return buffer;
+}
+
+size_t JFrameCapture::GetQueuedCount() const
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Jobs.size();
+}
+
+void JFrameCapture::WriterLoop()
+{
+    std::ofstream video;
+    std::vector<uint8_t> yuv;
+
+    for (;;)
+    {
+        FJob job;
+        {
+            std::unique_lock<std::mutex> lock(Mutex);
+            JobCondition.wait(lock, [this] { return bStopping || !Jobs.empty(); });
+            if (Jobs.empty()) break; // Stopping, and everything queued is written
+            job = std::move(Jobs.front());
+            Jobs.pop_front();
+        }
+
+        uint64_t bytes = 0;
+        switch (job.Kind)
+        {
+            case EJob::Screenshot:
+            {
+                std::ofstream file;
+                if (!OpenOutput(file, job.Path)) break;
+                const std::vector<uint8_t> png = EncodePng(job.Pixels, job.Width, job.Height);
+                file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+                bytes = png.size();
+                break;
+            }
+            case EJob::OpenVideo:
+            {
+                if (video.is_open()) video.close();
+                if (!OpenOutput(video, job.Path)) break;
+                const std::string header = "YUV4MPEG2 W" + std::to_string(job.Width) + " H" + std::to_string(job.Height)
+                    + " F" + std::to_string(job.FramesPerSecond) + ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+                video << header;
+                bytes = header.size();
+                break;
+            }
+            case EJob::VideoFrame:
+            {
+                if (!video.is_open()) break;
+                EncodeYuv420(job.Pixels, job.Width, job.Height, yuv);
+                video << "FRAME\n";
+                video.write(reinterpret_cast<const char*>(yuv.data()), static_cast<std::streamsize>(yuv.size()));
+                bytes = yuv.size() + 6;
+                break;
+            }
+            case EJob::CloseVideo:
+                video.close();
+                break;
+        }
+
+        if (bytes > 0 && (job.Kind == EJob::Screenshot || job.Kind == EJob::VideoFrame))
+            ++FramesWritten;
+        BytesWritten += bytes;
+
+        if (job.Pixels.capacity() > 0)
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (FreeBuffers.size() < MaxQueuedFrames)
+                FreeBuffers.push_back(std::move(job.Pixels));
+        }
+    }
+}
@@ -0,0 +1,163 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Counters of JFrameCapture.
+struct FFrameCaptureStats
+{
+    uint64_t FramesRead = 0;     ///< Readbacks issued into the PBO ring
+    uint64_t FramesWritten = 0;  ///< Frames the writer thread finished
+    uint64_t FramesDropped = 0;  ///< Frames skipped because the ring or the writer was full
+    uint64_t BytesWritten = 0;
+    int PendingReadbacks = 0;    ///< Readbacks the GPU hasn't finished
+    int QueuedWrites = 0;        ///< Frames waiting for the writer thread
+};
+
+/**
+ * @class JFrameCapture
+ * @brief Records the default framebuffer to PNG screenshots or Y4M video without stalling.
+ *
+ * EndFrame() issues glReadPixels into the next pixel buffer object of a ring of RingSize,
+ * followed by a fence. The copy then runs on the GPU while the CPU moves on; the PBO is only
+ * mapped once its fence has signaled, typically two frames later, so the main thread never
+ * waits for the GPU. The mapped pixels are copied into a recycled buffer and handed to a
+ * background thread, which flips, converts and writes them:
+ * - Screenshots are RGB PNGs. Rows take the adaptive filter with the smallest residuals and are
+ *   deflated with greedy LZ77 matches and the fixed Huffman codes, all on the writer thread.
+ * - Recordings are a single YUV4MPEG2 stream (4:2:0, full-range BT.601), which ffmpeg and most
+ *   players read directly; the header tags the range (XCOLORRANGE=FULL). Frames of another size than the first one are dropped.
+ *
+ * If the ring is still busy (the GPU is more than RingSize frames behind) or the writer has
+ * MaxQueuedFrames waiting, a video frame is dropped rather than waited on; a screenshot moves
+ * to the next frame.
+ *
+ * Jobs never touch GL: only EndFrame() and Shutdown() (which drains the ring) do, on the
+ * thread owning the context.
+ *
+ * Typical usage:
+ * @code
+ * Capture.RequestScreenshot("Captures/Shot.png");
+ * Capture.StartRecording("Captures/Session.y4m", 60);
+ * // ... every frame, once the final image is in the default framebuffer, before the UI
+ * Capture.EndFrame(fbWidth, fbHeight);
+ * @endcode
+ */
+class JFrameCapture {
+public:
+    /// Pixel buffer objects in flight, frames of latency before a readback is mapped.
+    static constexpr int RingSize = 3;
+
+    /// Frames the writer thread may lag behind before video frames are dropped.
+    static constexpr size_t MaxQueuedFrames = 8;
+
+    JFrameCapture();
+    ~JFrameCapture();
+
+    /**
+     * @brief Finish pending captures, stop the writer and free the GL objects.
+     *
+     * Call while the context is still current, the destructor only repeats it if it wasn't.
+     * Nothing is captured afterwards.
+     */
+    void Shutdown();
+
+    JFrameCapture(const JFrameCapture&) = delete;
+    JFrameCapture& operator=(const JFrameCapture&) = delete;
+
+    /** @brief Save the next frame as a PNG. Parent directories are created. */
+    void RequestScreenshot(const std::string& path);
+
+    /**
+     * @brief Start writing every frame to a Y4M stream.
+     * @param path Output file, replaced if it exists.
+     * @param framesPerSecond Frame rate written in the stream header.
+     */
+    void StartRecording(const std::string& path, int framesPerSecond = 60);
+
+    /** @brief Stop recording, frames already read back are still written. */
+    void StopRecording();
+
+    inline bool IsRecording() const { return bRecording; }
+
+    /**
+     * @brief Collect finished readbacks and, if capturing, read this frame.
+     * @param width Size of the default framebuffer.
+     * @param height Size of the default framebuffer.
+     */
+    void EndFrame(int width, int height);
+
+    /// Snapshot of the counters.
+    FFrameCaptureStats GetStats() const;
+
+private:
+    enum class EJob : uint8_t { Screenshot, OpenVideo, VideoFrame, CloseVideo };
+
+    struct FJob
+    {
+        EJob Kind = EJob::VideoFrame;
+        std::string Path;
+        int Width = 0;
+        int Height = 0;
+        int FramesPerSecond = 0;
+        std::vector<uint8_t> Pixels; ///< RGBA8, bottom row first (glReadPixels order)
+    };
+
+    struct FReadback
+    {
+        GLuint PBO = 0;
+        GLsync Fence = nullptr;
+        size_t Capacity = 0;
+        int Width = 0;
+        int Height = 0;
+        EJob Kind = EJob::VideoFrame;
+        std::string Path;
+    };
+
+    FReadback Ring[RingSize];
+    int Head = 0;     ///< Next slot to read into
+    int InFlight = 0; ///< Slots before Head waiting for their fence
+
+    std::string PendingScreenshot;
+    bool bRecording = false;
+    bool bVideoOpen = false;  ///< The writer has (or will have) an open stream
+    std::string VideoPath;
+    int VideoFramesPerSecond = 60;
+    int VideoWidth = 0;
+    int VideoHeight = 0;
+
+    // Writer thread
+    std::thread Writer;
+    std::deque<FJob> Jobs;
+    std::vector<std::vector<uint8_t>> FreeBuffers; ///< Pixel buffers returned by the writer
+    mutable std::mutex Mutex;
+    std::condition_variable JobCondition;
+    bool bStopping = false;
+
+    FFrameCaptureStats Stats;
+    std::atomic<uint64_t> FramesWritten{ 0 };
+    std::atomic<uint64_t> BytesWritten{ 0 };
+
+    /// Map finished readbacks in order and queue them; with bWait, block until all are done.
+    void CollectReadbacks(bool bWait);
+
+    /// Queue the end of the stream once its last frame has been read back.
+    void CloseVideoIfDone();
+
+    /// Issue a readback of the default framebuffer into the head slot.
+    bool IssueReadback(int width, int height, EJob kind, const std::string& path);
+
+    void PushJob(FJob&& job);
+    std::vector<uint8_t> TakeBuffer(size_t size);
+    size_t GetQueuedCount() const;
+    void WriterLoop();
+};
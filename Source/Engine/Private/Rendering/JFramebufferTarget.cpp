@@ -1,10 +1,41 @@
 // Copyright 2025 JesseTheCatLover. All Rights Reserved.
 
 #include "JFramebufferTarget.h"
+#include "JRenderStats.h"
 #include <iostream>
+#include <utility>
+
+namespace
+{
+    struct FColorFormatInfo
+    {
+        GLint InternalFormat;
+        GLenum Format;
+        GLenum Type;
+    };
+
+    FColorFormatInfo GetFormatInfo(EColorFormat format)
+    {
+        switch (format)
+        {
+            case EColorFormat::RGBA8:   return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE };
+            case EColorFormat::RGBA16F: return { GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT };
+            case EColorFormat::R16F:    return { GL_R16F, GL_RED, GL_HALF_FLOAT };
+            case EColorFormat::RG16F:   return { GL_RG16F, GL_RG, GL_HALF_FLOAT };
+            case EColorFormat::R8:      return { GL_R8, GL_RED, GL_UNSIGNED_BYTE };
+            case EColorFormat::RGB8:
+            default:                    return { GL_RGB, GL_RGB, GL_UNSIGNED_BYTE };
+        }
+    }
+}
 
 JFramebufferTarget::JFramebufferTarget(int width, int height, int samples)
-    : Width(width), Height(height), Samples(samples)
+    : JFramebufferTarget(width, height, { EColorFormat::RGB8 }, samples)
+{
+}
+
+JFramebufferTarget::JFramebufferTarget(int width, int height, std::vector<EColorFormat> colorFormats, int samples)
+    : Formats(std::move(colorFormats)), Width(width), Height(height), Samples(samples)
 {
     CreateBuffers();
 }
@@ -21,22 +52,35 @@ void JFramebufferTarget::CreateBuffers()
     glGenFramebuffers(1, &FBO);
     glBindFramebuffer(GL_FRAMEBUFFER, FBO);
 
-    // Generate color attachment texture
-    glGenTextures(1, &ColorTex);
-
-    if (Samples > 1) {
-        // Multi-sampled color texture for MSAA
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, ColorTex);
-        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Samples, GL_RGB, Width, Height, GL_TRUE);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, ColorTex, 0);
-    } else {
-        // Standard single-sample texture
-        glBindTexture(GL_TEXTURE_2D, ColorTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, Width, Height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ColorTex, 0);
+    // Generate color attachment textures
+    ColorTextures.resize(Formats.size());
+    glGenTextures(static_cast<GLsizei>(ColorTextures.size()), ColorTextures.data());
+
+    std::vector<GLenum> drawBuffers;
+    for (size_t i = 0; i < ColorTextures.size(); ++i)
+    {
+        const FColorFormatInfo info = GetFormatInfo(Formats[i]);
+        const GLenum attachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+
+        if (Samples > 1) {
+            // Multi-sampled color texture for MSAA
+            glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, ColorTextures[i]);
+            glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Samples, info.InternalFormat, Width, Height, GL_TRUE);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D_MULTISAMPLE, ColorTextures[i], 0);
+        } else {
+            // Standard single-sample texture
+            glBindTexture(GL_TEXTURE_2D, ColorTextures[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, info.InternalFormat, Width, Height, 0, info.Format, info.Type, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            // Filtered taps at the border (blurs, upsampling) must not wrap to the opposite edge
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, ColorTextures[i], 0);
+        }
+        drawBuffers.push_back(attachment);
     }
+    glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
 
     // Create depth-stencil renderbuffer
     glGenRenderbuffers(1, &RBO);
@@ -60,12 +104,13 @@ void JFramebufferTarget::CreateBuffers()
 void JFramebufferTarget::Destroy()
 {
     if (RBO) glDeleteRenderbuffers(1, &RBO);
-    if (ColorTex) glDeleteTextures(1, &ColorTex);
+    if (!ColorTextures.empty())
+        glDeleteTextures(static_cast<GLsizei>(ColorTextures.size()), ColorTextures.data());
     if (FBO) glDeleteFramebuffers(1, &FBO);
 
     // Reset IDs to 0 to prevent dangling references
     FBO = 0;
-    ColorTex = 0;
+    ColorTextures.clear();
     RBO = 0;
 }
 
@@ -74,12 +119,14 @@ void JFramebufferTarget::Bind() const
 {
     glBindFramebuffer(GL_FRAMEBUFFER, FBO);
     glViewport(0, 0, Width, Height);
+    JRenderStats::CountFramebufferBind();
 }
 
 void JFramebufferTarget::Unbind(int screenWidth, int screenHeight) const
 {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glViewport(0, 0, screenWidth, screenHeight);
+    JRenderStats::CountFramebufferBind();
 }
 
 void JFramebufferTarget::Resize(int newWidth, int newHeight)
@@ -108,4 +155,23 @@ void JFramebufferTarget::ResolveTo(JFramebufferTarget& target) const
 
     // Restore default framebuffer binding
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    JRenderStats::CountFramebufferBind(3);
+}
+
+void JFramebufferTarget::BlitDepthTo(JFramebufferTarget& target) const
+{
+    if (FBO == 0 || target.FBO == 0) return; // Safety check
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.FBO);
+
+    // Depth-stencil blits must be nearest and the same size, a multi-sampled source is resolved
+    glBlitFramebuffer(
+        0, 0, Width, Height,
+        0, 0, target.Width, target.Height,
+        GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT, GL_NEAREST
+    );
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    JRenderStats::CountFramebufferBind(3);
 }
@@ -3,6 +3,20 @@
 #pragma once
 
 #include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Storage format of a color attachment.
+enum class EColorFormat : uint8_t
+{
+    RGB8,    ///< Default scene/post-process color
+    RGBA8,
+    RGBA16F, ///< HDR or accumulation buffers
+    R16F,    ///< Single-channel float, e.g. OIT weights
+    RG16F,   ///< Two-channel float, e.g. jump-flood seed coordinates
+    R8
+};
 
 /**
  * @class JFramebufferTarget
@@ -11,6 +25,7 @@
  * JFramebufferTarget provides an abstraction for offscreen rendering. It supports:
  * - Single-sample and multi-sample framebuffers (MSAA).
  * - Automatic resizing of attachments.
+ * - Multiple color attachments (MRT) with per-attachment formats, all written by default.
  * - Resolving multi-sample buffers to single-sample targets for post-processing.
  *
  * Typical usage:
@@ -36,6 +51,15 @@ public:
      */
     JFramebufferTarget(int width, int height, int samples = 1);
 
+    /**
+     * @brief Construct a render target with several color attachments.
+     * @param width Width of the framebuffer in pixels.
+     * @param height Height of the framebuffer in pixels.
+     * @param colorFormats One entry per color attachment, attachment i is GL_COLOR_ATTACHMENT0 + i.
+     * @param samples Number of samples per pixel.
+     */
+    JFramebufferTarget(int width, int height, std::vector<EColorFormat> colorFormats, int samples = 1);
+
     /**
      * @brief Destroy the render target and release all resources.
      *
@@ -84,8 +108,25 @@ public:
      */
     void ResolveTo(JFramebufferTarget& target) const;
 
-    /// Get the color attachment texture ID.
-    inline GLuint GetTexture() const { return ColorTex; }
+    /**
+     * @brief Copy the depth-stencil buffer into another target of the same size.
+     * @param target Destination render target, may have a different sample count.
+     *
+     * Used to depth-test a pass against geometry that was rendered into another target.
+     */
+    void BlitDepthTo(JFramebufferTarget& target) const;
+
+    /// Get a color attachment texture ID.
+    inline GLuint GetTexture(size_t attachment = 0) const { return ColorTextures[attachment]; }
+
+    /// Format of a color attachment.
+    inline EColorFormat GetFormat(size_t attachment = 0) const { return Formats[attachment]; }
+
+    /// Number of color attachments.
+    inline size_t GetColorAttachmentCount() const { return ColorTextures.size(); }
+
+    /// Get the OpenGL framebuffer object.
+    inline GLuint GetFramebuffer() const { return FBO; }
 
     /// Get the width of the framebuffer.
     inline int GetWidth() const { return Width; }
@@ -97,9 +138,10 @@ public:
     inline int GetSamples() const { return Samples; }
 
 private:
-    GLuint FBO = 0;      ///< OpenGL framebuffer object
-    GLuint ColorTex = 0; ///< Color attachment texture
-    GLuint RBO = 0;      ///< Depth-stencil renderbuffer
+    GLuint FBO = 0;                    ///< OpenGL framebuffer object
+    std::vector<EColorFormat> Formats; ///< Format of each color attachment
+    std::vector<GLuint> ColorTextures; ///< Color attachment textures
+    GLuint RBO = 0;                    ///< Depth-stencil renderbuffer
     int Width;           ///< Framebuffer width in pixels
     int Height;          ///< Framebuffer height in pixels
     int Samples;         ///< Sample count (1 = single-sample)
@@ -0,0 +1,254 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JFrustumCuller.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Core/JCpuProfiler.h"
+#include "Core/JJobSystem.h"
+#include "JModel.h"
+#include "JSoftwareOcclusion.h"
+#include "Scene/JActor.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define JCULL_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define JCULL_SIMD_WIDTH 4
+#else
+    #define JCULL_SIMD_WIDTH 1
+#endif
+
+namespace
+{
+    constexpr size_t kSimdWidth = JCULL_SIMD_WIDTH;
+
+    /// Boxes per job. Below this the whole scene is tested on the calling thread.
+    constexpr size_t kBoxesPerJob = 2048;
+}
+
+void JFrustumCuller::Cull(const glm::mat4& viewProjection, const std::vector<const JActor*>& actors, JJobSystem* jobs)
+{
+    J_PROFILE_SCOPE("Frustum Culling");
+    ++Frame;
+    Stats = FCullingStats();
+    Frustum = FFrustum::FromMatrix(viewProjection);
+
+    // Gather this frame's world bounds into SoA form
+    CenterX.clear(); CenterY.clear(); CenterZ.clear();
+    ExtentX.clear(); ExtentY.clear(); ExtentZ.clear();
+    ActorFirstMesh.resize(actors.size());
+    FrameBounds.resize(actors.size());
+
+    for (size_t i = 0; i < actors.size(); ++i)
+    {
+        ActorFirstMesh[i] = static_cast<uint32_t>(CenterX.size());
+
+        const FActorBounds& bounds = UpdateBounds(*actors[i]);
+        FrameBounds[i] = &bounds;
+        for (const FAABB& box : bounds.MeshBounds)
+        {
+            // Empty meshes get a zero-sized box at the origin, they draw nothing either way
+            const glm::vec3 center = box.IsValid() ? box.GetCenter() : glm::vec3(0.f);
+            const glm::vec3 extent = box.IsValid() ? box.GetExtent() : glm::vec3(0.f);
+            CenterX.push_back(center.x); CenterY.push_back(center.y); CenterZ.push_back(center.z);
+            ExtentX.push_back(extent.x); ExtentY.push_back(extent.y); ExtentZ.push_back(extent.z);
+        }
+    }
+
+    const size_t boxCount = CenterX.size();
+    const size_t paddedCount = (boxCount + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    for (auto* array : { &CenterX, &CenterY, &CenterZ, &ExtentX, &ExtentY, &ExtentZ })
+        array->resize(paddedCount, 0.f);
+    MeshVisible.assign(paddedCount, 1);
+
+    if (bEnabled)
+    {
+        if (jobs && boxCount > kBoxesPerJob)
+        {
+            // kBoxesPerJob is a multiple of every SIMD width, so chunks stay aligned
+            jobs->ParallelFor(paddedCount, kBoxesPerJob, [this](size_t begin, size_t end) { CullRange(begin, end); });
+        }
+        else
+        {
+            CullRange(0, paddedCount);
+        }
+    }
+
+    // Resolve per-actor visibility
+    ActorVisible.assign(actors.size(), 0);
+    for (size_t i = 0; i < actors.size(); ++i)
+    {
+        const size_t first = ActorFirstMesh[i];
+        const size_t last = (i + 1 < actors.size()) ? ActorFirstMesh[i + 1] : boxCount;
+        for (size_t m = first; m < last; ++m)
+        {
+            if (MeshVisible[m])
+            {
+                ActorVisible[i] = 1;
+                ++Stats.VisibleMeshes;
+            }
+        }
+        Stats.VisibleActors += ActorVisible[i];
+    }
+
+    Stats.TestedActors = static_cast<int>(actors.size());
+    Stats.TestedMeshes = static_cast<int>(boxCount);
+
+    // Forget actors that were not submitted this frame (removed or no longer rendered)
+    for (auto it = Cache.begin(); it != Cache.end();)
+    {
+        if (it->second.LastFrame != Frame) it = Cache.erase(it);
+        else ++it;
+    }
+}
+
+void JFrustumCuller::CullOccluded(const JSoftwareOcclusion& occlusion, JJobSystem* jobs)
+{
+    if (!bEnabled) return;
+    J_PROFILE_SCOPE("Occlusion Culling");
+
+    auto test = [this, &occlusion](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!ActorVisible[i]) continue;
+
+            const std::vector<FAABB>& meshBounds = FrameBounds[i]->MeshBounds;
+            uint8_t* visible = MeshVisible.data() + ActorFirstMesh[i];
+            for (size_t m = 0; m < meshBounds.size(); ++m)
+            {
+                if (visible[m] && !occlusion.TestAABB(meshBounds[m]))
+                    visible[m] = 2; // Occluded, counted and cleared below
+            }
+        }
+    };
+
+    // Few actors per job: every test projects 8 corners and walks HiZ texels
+    if (jobs) jobs->ParallelFor(ActorVisible.size(), 64, test);
+    else test(0, ActorVisible.size());
+
+    for (size_t i = 0; i < ActorVisible.size(); ++i)
+    {
+        if (!ActorVisible[i]) continue;
+
+        uint8_t* visible = MeshVisible.data() + ActorFirstMesh[i];
+        bool bAnyVisible = false;
+        for (size_t m = 0; m < FrameBounds[i]->MeshBounds.size(); ++m)
+        {
+            if (visible[m] == 2)
+            {
+                visible[m] = 0;
+                ++Stats.OccludedMeshes;
+                --Stats.VisibleMeshes;
+            }
+            bAnyVisible = bAnyVisible || visible[m] != 0;
+        }
+
+        if (!bAnyVisible)
+        {
+            ActorVisible[i] = 0;
+            ++Stats.OccludedActors;
+            --Stats.VisibleActors;
+        }
+    }
+}
+
+// --------------------- Internal Helpers ---------------------
+JFrustumCuller::FActorBounds& JFrustumCuller::UpdateBounds(const JActor& actor)
+{
+    FActorBounds& bounds = Cache[actor.m_InstanceID];
+    bounds.LastFrame = Frame;
+
+    const bool bChanged = bounds.Model != actor.Model || bounds.MeshBounds.empty() ||
+                          bounds.Position != actor.Position || bounds.Rotation != actor.Rotation ||
+                          bounds.Scale != actor.Scale;
+    if (!bChanged) return bounds;
+
+    bounds.Model = actor.Model;
+    bounds.Position = actor.Position;
+    bounds.Rotation = actor.Rotation;
+    bounds.Scale = actor.Scale;
+    bounds.MeshBounds.clear();
+
+    if (actor.Model)
+    {
+        const glm::mat4 transform = actor.GetModelMatrix();
+        for (const auto& mesh : actor.Model->Meshes)
+            bounds.MeshBounds.push_back(mesh.Bounds.Transform(transform));
+    }
+
+    ++Stats.UpdatedActors;
+    return bounds;
+}
+
+void JFrustumCuller::CullRange(size_t begin, size_t end)
+{
+    const float* cx = CenterX.data();
+    const float* cy = CenterY.data();
+    const float* cz = CenterZ.data();
+    const float* ex = ExtentX.data();
+    const float* ey = ExtentY.data();
+    const float* ez = ExtentZ.data();
+    uint8_t* visible = MeshVisible.data();
+
+    // A box is outside a plane when dot(n, c) + d + dot(|n|, e) < 0
+#if JCULL_SIMD_WIDTH == 8
+    for (size_t i = begin; i < end; i += 8)
+    {
+        const __m256 centerX = _mm256_loadu_ps(cx + i), centerY = _mm256_loadu_ps(cy + i), centerZ = _mm256_loadu_ps(cz + i);
+        const __m256 extentX = _mm256_loadu_ps(ex + i), extentY = _mm256_loadu_ps(ey + i), extentZ = _mm256_loadu_ps(ez + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : Frustum.Planes)
+        {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(plane.x)), _mm256_set1_ps(plane.w));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(centerY, _mm256_set1_ps(plane.y)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(centerZ, _mm256_set1_ps(plane.z)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(extentX, _mm256_set1_ps(std::fabs(plane.x))));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(extentY, _mm256_set1_ps(std::fabs(plane.y))));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(extentZ, _mm256_set1_ps(std::fabs(plane.z))));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        const int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; ++lane)
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+    }
+#elif JCULL_SIMD_WIDTH == 4
+    for (size_t i = begin; i < end; i += 4)
+    {
+        const __m128 centerX = _mm_loadu_ps(cx + i), centerY = _mm_loadu_ps(cy + i), centerZ = _mm_loadu_ps(cz + i);
+        const __m128 extentX = _mm_loadu_ps(ex + i), extentY = _mm_loadu_ps(ey + i), extentZ = _mm_loadu_ps(ez + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : Frustum.Planes)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(distance, _mm_mul_ps(centerY, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(centerZ, _mm_set1_ps(plane.z)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(extentX, _mm_set1_ps(std::fabs(plane.x))));
+            distance = _mm_add_ps(distance, _mm_mul_ps(extentY, _mm_set1_ps(std::fabs(plane.y))));
+            distance = _mm_add_ps(distance, _mm_mul_ps(extentZ, _mm_set1_ps(std::fabs(plane.z))));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; ++lane)
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+    }
+#else
+    for (size_t i = begin; i < end; ++i)
+    {
+        bool bInside = true;
+        for (const auto& plane : Frustum.Planes)
+        {
+            const float distance = cx[i] * plane.x + cy[i] * plane.y + cz[i] * plane.z + plane.w +
+                ex[i] * std::fabs(plane.x) + ey[i] * std::fabs(plane.y) + ez[i] * std::fabs(plane.z);
+            bInside = bInside && distance >= 0.f;
+        }
+        visible[i] = bInside ? 1 : 0;
+    }
+#endif
+}
@@ -0,0 +1,130 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include "../Core/Math/FAABB.h"
+#include "../Core/Math/FFrustum.h"
+
+class JActor;
+class JJobSystem;
+class JModel;
+class JSoftwareOcclusion;
+
+/// Per-frame counters of the last JFrustumCuller::Cull().
+struct FCullingStats
+{
+    int TestedActors = 0;
+    int VisibleActors = 0;
+    int TestedMeshes = 0;
+    int VisibleMeshes = 0;
+    int UpdatedActors = 0; ///< Actors whose world bounds had to be recomputed (moved or new)
+    int OccludedActors = 0; ///< Frustum-visible actors rejected by CullOccluded()
+    int OccludedMeshes = 0; ///< Frustum-visible meshes rejected by CullOccluded()
+
+    /// Fraction of frustum-visible meshes that occlusion culling rejected.
+    inline float GetOcclusionRejectionRate() const
+    {
+        const int candidates = VisibleMeshes + OccludedMeshes;
+        return candidates ? float(OccludedMeshes) / float(candidates) : 0.f;
+    }
+};
+
+/**
+ * @class JFrustumCuller
+ * @brief Rejects actors and individual meshes that lie outside the camera frustum.
+ *
+ * Every JMesh carries an object-space AABB computed at import. The culler keeps the
+ * world-space version of those boxes per actor and only re-transforms them when the
+ * actor's model or transform changes, so static scenes pay nothing but the test itself.
+ *
+ * For the test, the world boxes of all actors submitted this frame are gathered into
+ * structure-of-arrays (center/extent per axis) and tested against the six planes of
+ * projection * view with an SSE kernel, or AVX when the engine is built with JENGINE_ENABLE_AVX,
+ * 4 or 8 boxes at a time. Large scenes are split over the JJobSystem.
+ *
+ * For scenes managed by a JScene, pass the candidates of JScene::QueryActorsInFrustum()
+ * instead of every actor: the scene's AABB tree rejects whole regions in logarithmic time
+ * and this culler then refines the survivors per mesh.
+ *
+ * Typical usage:
+ * @code
+ * Culler.Cull(projection * view, actors, jobs);
+ * for (size_t i = 0; i < actors.size(); ++i)
+ *     if (Culler.IsActorVisible(i))
+ *         Batcher.Submit(*actors[i], Culler.GetMeshVisibility(i));
+ * @endcode
+ */
+class JFrustumCuller {
+public:
+    /**
+     * @brief Cull a frame's actors.
+     * @param viewProjection Camera projection * view.
+     * @param actors Actors to test. Results are indexed the same way.
+     * @param jobs Optional job system; null runs the kernel on the calling thread.
+     */
+    void Cull(const glm::mat4& viewProjection, const std::vector<const JActor*>& actors, JJobSystem* jobs = nullptr);
+
+    /**
+     * @brief Refine the last Cull() against a rasterized occlusion buffer.
+     *
+     * Meshes that passed the frustum test but are hidden behind occluders are marked invisible,
+     * actors left without visible meshes become invisible. Actors flagged as occluders are tested
+     * too: their own depth never hides them, but other occluders may.
+     *
+     * @param occlusion Occlusion buffer, already rasterized for this frame's view.
+     * @param jobs Optional job system; null runs the tests on the calling thread.
+     */
+    void CullOccluded(const JSoftwareOcclusion& occlusion, JJobSystem* jobs = nullptr);
+
+    /// True if at least one mesh of actor i intersects the frustum.
+    inline bool IsActorVisible(size_t actorIndex) const { return ActorVisible[actorIndex] != 0; }
+
+    /// One byte per mesh of actor i's model, non-zero if that mesh is visible.
+    inline const uint8_t* GetMeshVisibility(size_t actorIndex) const
+    {
+        return MeshVisible.data() + ActorFirstMesh[actorIndex];
+    }
+
+    inline const FFrustum& GetFrustum() const { return Frustum; }
+    inline const FCullingStats& GetStats() const { return Stats; }
+
+    /// When disabled everything is reported visible (for debugging and A/B comparisons).
+    inline void SetEnabled(bool bEnable) { bEnabled = bEnable; }
+    inline bool IsEnabled() const { return bEnabled; }
+
+private:
+    /// Cached world bounds of one actor, valid while model and transform are unchanged.
+    struct FActorBounds
+    {
+        const JModel* Model = nullptr;
+        glm::vec3 Position, Rotation, Scale;
+        std::vector<FAABB> MeshBounds;
+        uint64_t LastFrame = 0;
+    };
+
+    bool bEnabled = true;
+    uint64_t Frame = 0;
+    FFrustum Frustum;
+    FCullingStats Stats;
+
+    std::unordered_map<uint64_t, FActorBounds> Cache; ///< By JActor::m_InstanceID, actors move in their vector
+
+    // Structure-of-arrays view of this frame's world bounds, padded to the SIMD width
+    std::vector<float> CenterX, CenterY, CenterZ;
+    std::vector<float> ExtentX, ExtentY, ExtentZ;
+
+    std::vector<const FActorBounds*> FrameBounds; ///< Cache entries of this frame's actors, by actor index
+    std::vector<uint8_t> MeshVisible;
+    std::vector<uint32_t> ActorFirstMesh;
+    std::vector<uint8_t> ActorVisible;
+
+    /// Refresh an actor's cached world bounds if it moved. Returns the up-to-date entry.
+    FActorBounds& UpdateBounds(const JActor& actor);
+
+    /// Test boxes [begin, end) against the frustum. begin must be a multiple of the SIMD width.
+    void CullRange(size_t begin, size_t end);
+};
@@ -0,0 +1,55 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JGLCapabilities.h"
+
+#include <GLFW/glfw3.h>
+#include <cstring>
+#include <iostream>
+
+bool JGLCapabilities::bVerbose = false;
+
+const JGLCapabilities& JGLCapabilities::Get()
+{
+    static JGLCapabilities instance;
+    return instance;
+}
+
+JGLCapabilities::JGLCapabilities()
+{
+    glGetIntegerv(GL_MAJOR_VERSION, &Major);
+    glGetIntegerv(GL_MINOR_VERSION, &Minor);
+
+    if (IsAtLeast(4, 3))
+    {
+        MultiDrawElementsIndirect = reinterpret_cast<PFN_JMultiDrawElementsIndirect>(
+            glfwGetProcAddress("glMultiDrawElementsIndirect"));
+    }
+
+    // Core contexts expose KHR_debug without a suffix
+    if (IsAtLeast(4, 3) || HasExtension("GL_KHR_debug"))
+    {
+        PushDebugGroup = reinterpret_cast<PFN_JPushDebugGroup>(glfwGetProcAddress("glPushDebugGroup"));
+        PopDebugGroup = reinterpret_cast<PFN_JPopDebugGroup>(glfwGetProcAddress("glPopDebugGroup"));
+    }
+
+    if (bVerbose) PrintReport();
+}
+
+void JGLCapabilities::PrintReport() const
+{
+    std::cout << "[JGLCapabilities] OpenGL " << Major << "." << Minor
+              << (HasMultiDrawIndirect() ? " (multi-draw indirect)" : "")
+              << (HasDebugGroups() ? " (debug groups)" : "") << std::endl;
+}
+
+bool JGLCapabilities::HasExtension(const char* name) const
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension && std::strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
@@ -0,0 +1,64 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+
+// Tokens from GL 4.3 that are not part of the 3.3 core loader
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_DEBUG_SOURCE_APPLICATION
+#define GL_DEBUG_SOURCE_APPLICATION 0x824A
+#endif
+
+typedef void (GLAD_API_PTR *PFN_JMultiDrawElementsIndirect)(GLenum mode, GLenum type, const void* indirect,
+                                                             GLsizei drawcount, GLsizei stride);
+typedef void (GLAD_API_PTR *PFN_JPushDebugGroup)(GLenum source, GLuint id, GLsizei length, const GLchar* message);
+typedef void (GLAD_API_PTR *PFN_JPopDebugGroup)();
+
+/**
+ * @class JGLCapabilities
+ * @brief Runtime description of the current GL context and loader for post-3.3 entry points.
+ *
+ * The engine is built against a GL 3.3 core loader, so newer functionality is resolved
+ * manually through GLFW once a context is current. Callers check the Has*() flags and
+ * fall back to 3.3 paths when a feature is missing.
+ */
+class JGLCapabilities {
+public:
+    /// Query the current context. The first call must happen after gladLoadGL().
+    static const JGLCapabilities& Get();
+
+    /// Print the version and features found when the context is first queried. Off by default.
+    static inline void SetVerbose(bool bEnable) { bVerbose = bEnable; }
+
+    /// Print the version and features found to std::cout.
+    void PrintReport() const;
+
+    inline int GetMajorVersion() const { return Major; }
+    inline int GetMinorVersion() const { return Minor; }
+
+    /// True if the context is at least version major.minor.
+    inline bool IsAtLeast(int major, int minor) const { return Major > major || (Major == major && Minor >= minor); }
+
+    /// glMultiDrawElementsIndirect with baseInstance support (GL 4.3).
+    inline bool HasMultiDrawIndirect() const { return MultiDrawElementsIndirect != nullptr; }
+
+    /// glPushDebugGroup / glPopDebugGroup (GL 4.3 or KHR_debug), shown by RenderDoc and Nsight.
+    inline bool HasDebugGroups() const { return PushDebugGroup != nullptr && PopDebugGroup != nullptr; }
+
+    PFN_JMultiDrawElementsIndirect MultiDrawElementsIndirect = nullptr;
+    PFN_JPushDebugGroup PushDebugGroup = nullptr;
+    PFN_JPopDebugGroup PopDebugGroup = nullptr;
+
+private:
+    JGLCapabilities();
+
+    static bool bVerbose;
+
+    bool HasExtension(const char* name) const;
+
+    int Major = 3;
+    int Minor = 3;
+};
@@ -0,0 +1,324 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JGeometryPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <glm/glm.hpp>
+#include "JMesh.h"
+#include "JRenderStats.h"
+
+namespace
+{
+    constexpr size_t kInitialVertexCapacity = 1 << 16;
+    constexpr size_t kInitialIndexCapacity = 1 << 18;
+
+    /// Compact once more than half of the free space is not part of the largest hole.
+    constexpr float kDefragmentThreshold = 0.5f;
+
+    std::shared_ptr<JGeometryPool> (&GetPools())[static_cast<size_t>(EVertexLayout::Count)]
+    {
+        static std::shared_ptr<JGeometryPool> pools[static_cast<size_t>(EVertexLayout::Count)];
+        return pools;
+    }
+}
+
+JGeometryPool& JGeometryPool::Get(EVertexLayout layout)
+{
+    return *GetShared(layout);
+}
+
+std::shared_ptr<JGeometryPool> JGeometryPool::GetShared(EVertexLayout layout)
+{
+    auto& pool = GetPools()[static_cast<size_t>(layout)];
+    if (!pool)
+        pool.reset(new JGeometryPool(layout));
+    return pool;
+}
+
+void JGeometryPool::ShutdownAll()
+{
+    for (auto& pool : GetPools())
+        if (pool) pool->Shutdown();
+}
+
+JGeometryPool::JGeometryPool(EVertexLayout layout)
+    : Layout(layout), VertexStride(sizeof(S_Vertex)),
+      VertexAllocator(kInitialVertexCapacity), IndexAllocator(kInitialIndexCapacity)
+{
+    glGenVertexArrays(1, &VAO);
+    glGenVertexArrays(1, &PositionVAO);
+
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, kInitialVertexCapacity * VertexStride, nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &PositionVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, PositionVBO);
+    glBufferData(GL_ARRAY_BUFFER, kInitialVertexCapacity * sizeof(glm::vec3), nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ARRAY_BUFFER, kInitialIndexCapacity * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    SetupVertexArray();
+}
+
+JGeometryPool::~JGeometryPool()
+{
+    Shutdown();
+}
+
+void JGeometryPool::Shutdown()
+{
+    if (EBO) glDeleteBuffers(1, &EBO);
+    if (VBO) glDeleteBuffers(1, &VBO);
+    if (PositionVBO) glDeleteBuffers(1, &PositionVBO);
+    if (VAO) glDeleteVertexArrays(1, &VAO);
+    if (PositionVAO) glDeleteVertexArrays(1, &PositionVAO);
+    EBO = VBO = PositionVBO = VAO = PositionVAO = 0;
+}
+
+JGeometryPool::Handle JGeometryPool::Allocate(const S_Vertex* vertices, size_t vertexCount,
+                                              const GLuint* indices, size_t indexCount)
+{
+    if (vertexCount == 0 || indexCount == 0 || !VBO) return InvalidHandle;
+
+    EnsureCapacity(vertexCount, indexCount);
+
+    FSlot slot;
+    slot.bLive = true;
+    slot.Range.BaseVertex = static_cast<GLint>(VertexAllocator.Allocate(vertexCount));
+    slot.Range.VertexCount = static_cast<GLuint>(vertexCount);
+    slot.Range.FirstIndex = static_cast<GLuint>(IndexAllocator.Allocate(indexCount));
+    slot.Range.IndexCount = static_cast<GLuint>(indexCount);
+
+    // Upload through the copy targets so the VAO's element buffer binding is left alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, VBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, slot.Range.BaseVertex * VertexStride, vertexCount * VertexStride, vertices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, slot.Range.FirstIndex * sizeof(GLuint), indexCount * sizeof(GLuint), indices);
+    JRenderStats::CountUpload(vertexCount * VertexStride + indexCount * sizeof(GLuint));
+
+    // Position-only copy for depth passes
+    std::vector<glm::vec3> positions(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+        positions[i] = vertices[i].Position;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, PositionVBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, slot.Range.BaseVertex * sizeof(glm::vec3), vertexCount * sizeof(glm::vec3),
+        positions.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    JRenderStats::CountUpload(vertexCount * sizeof(glm::vec3));
+
+    Handle handle;
+    if (!FreeSlots.empty())
+    {
+        handle = FreeSlots.back();
+        FreeSlots.pop_back();
+        Slots[handle] = slot;
+    }
+    else
+    {
+        handle = static_cast<Handle>(Slots.size());
+        Slots.push_back(slot);
+    }
+    return handle;
+}
+
+void JGeometryPool::Free(Handle handle)
+{
+    if (handle == InvalidHandle || handle >= Slots.size() || !Slots[handle].bLive) return;
+
+    FSlot& slot = Slots[handle];
+    VertexAllocator.Free(slot.Range.BaseVertex, slot.Range.VertexCount);
+    IndexAllocator.Free(slot.Range.FirstIndex, slot.Range.IndexCount);
+
+    slot = FSlot();
+    FreeSlots.push_back(handle);
+}
+
+void JGeometryPool::DefragmentIfNeeded()
+{
+    if (VertexAllocator.GetFragmentation() > kDefragmentThreshold ||
+        IndexAllocator.GetFragmentation() > kDefragmentThreshold)
+        Defragment();
+}
+
+void JGeometryPool::Defragment()
+{
+    if (!VBO) return; // Shut down
+
+    const size_t vertexCapacity = VertexAllocator.GetCapacity();
+    const size_t indexCapacity = IndexAllocator.GetCapacity();
+
+    GLuint newVBO = 0, newEBO = 0, newPositionVBO = 0;
+    glGenBuffers(1, &newVBO);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newVBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, vertexCapacity * VertexStride, nullptr, GL_STATIC_DRAW);
+    glGenBuffers(1, &newPositionVBO);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newPositionVBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, vertexCapacity * sizeof(glm::vec3), nullptr, GL_STATIC_DRAW);
+    glGenBuffers(1, &newEBO);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newEBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, indexCapacity * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+
+    // Pack live vertex ranges in their current order so copies stay mostly sequential
+    std::vector<Handle> live;
+    live.reserve(Slots.size());
+    for (Handle i = 0; i < Slots.size(); ++i)
+        if (Slots[i].bLive) live.push_back(i);
+
+    std::sort(live.begin(), live.end(), [this](Handle a, Handle b)
+        { return Slots[a].Range.BaseVertex < Slots[b].Range.BaseVertex; });
+
+    size_t vertexCursor = 0;
+    size_t indexCursor = 0;
+    for (Handle handle : live)
+    {
+        FGeometryRange& range = Slots[handle].Range;
+
+        glBindBuffer(GL_COPY_READ_BUFFER, VBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, newVBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            range.BaseVertex * VertexStride, vertexCursor * VertexStride, range.VertexCount * VertexStride);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, PositionVBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, newPositionVBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.BaseVertex * sizeof(glm::vec3),
+            vertexCursor * sizeof(glm::vec3), range.VertexCount * sizeof(glm::vec3));
+
+        glBindBuffer(GL_COPY_READ_BUFFER, EBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, newEBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            range.FirstIndex * sizeof(GLuint), indexCursor * sizeof(GLuint), range.IndexCount * sizeof(GLuint));
+
+        range.BaseVertex = static_cast<GLint>(vertexCursor);
+        range.FirstIndex = static_cast<GLuint>(indexCursor);
+        vertexCursor += range.VertexCount;
+        indexCursor += range.IndexCount;
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+    glDeleteBuffers(1, &PositionVBO);
+    VBO = newVBO;
+    EBO = newEBO;
+    PositionVBO = newPositionVBO;
+
+    VertexAllocator.Reset(vertexCapacity, vertexCursor);
+    IndexAllocator.Reset(indexCapacity, indexCursor);
+
+    SetupVertexArray();
+}
+
+void JGeometryPool::Bind(EVertexStream stream) const
+{
+    ActiveStream = stream;
+    glBindVertexArray(stream == EVertexStream::PositionOnly ? PositionVAO : VAO);
+}
+
+void JGeometryPool::SetInstanceBuffer(GLuint instanceVBO, size_t byteOffset) const
+{
+    glBindVertexArray(ActiveStream == EVertexStream::PositionOnly ? PositionVAO : VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+    // A mat4 attribute is four vec4 columns in consecutive locations
+    for (GLuint i = 0; i < 4; i++)
+    {
+        glEnableVertexAttribArray(INSTANCE_MATRIX_LOCATION + i);
+        glVertexAttribPointer(INSTANCE_MATRIX_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+            (void*)(byteOffset + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(INSTANCE_MATRIX_LOCATION + i, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// --------------------- Internal Helpers ---------------------
+GLuint JGeometryPool::GrowBuffer(GLuint buffer, size_t oldBytes, size_t newBytes)
+{
+    GLuint grown = 0;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+    return grown;
+}
+
+void JGeometryPool::EnsureCapacity(size_t vertexCount, size_t indexCount)
+{
+    bool bGrown = false;
+
+    if (VertexAllocator.GetLargestFreeBlock() < vertexCount)
+    {
+        const size_t oldCapacity = VertexAllocator.GetCapacity();
+        const size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + vertexCount);
+        VBO = GrowBuffer(VBO, oldCapacity * VertexStride, newCapacity * VertexStride);
+        PositionVBO = GrowBuffer(PositionVBO, oldCapacity * sizeof(glm::vec3), newCapacity * sizeof(glm::vec3));
+        VertexAllocator.Grow(newCapacity);
+        bGrown = true;
+    }
+
+    if (IndexAllocator.GetLargestFreeBlock() < indexCount)
+    {
+        const size_t oldCapacity = IndexAllocator.GetCapacity();
+        const size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + indexCount);
+        EBO = GrowBuffer(EBO, oldCapacity * sizeof(GLuint), newCapacity * sizeof(GLuint));
+        IndexAllocator.Grow(newCapacity);
+        bGrown = true;
+    }
+
+    // The VAO still references the deleted buffers
+    if (bGrown) SetupVertexArray();
+}
+
+void JGeometryPool::SetupVertexArray()
+{
+    assert(Layout == EVertexLayout::Standard);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    // Vertex positions
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)0);
+    // Vertex normals
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, Normal));
+    // Vertex texture coords
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, TexCoords));
+    // Vertex tangent
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, Tangent));
+    // Vertex bitangent
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, Bitangent));
+    // IDs
+    glEnableVertexAttribArray(5);
+    glVertexAttribIPointer(5, 4, GL_INT, sizeof(S_Vertex), (void*)offsetof(S_Vertex, M_BoneIDs));
+    // Weights
+    glEnableVertexAttribArray(6);
+    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, M_Weights));
+
+    // Position-only stream: same indices and base vertices, 12-byte vertices
+    glBindVertexArray(PositionVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, PositionVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,201 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../Core/JFreeListAllocator.h"
+
+struct S_Vertex;
+
+/// Vertex formats that get their own shared buffers.
+enum class EVertexLayout
+{
+    Standard, ///< S_Vertex: position, normal, uv, tangent, bitangent, bone ids, bone weights
+    Count
+};
+
+/// Vertex attribute sets a pool can be drawn with.
+enum class EVertexStream
+{
+    Full,        ///< Every attribute of the layout
+    PositionOnly ///< Tightly packed positions only, for depth-only passes (shadows, pre-pass)
+};
+
+/**
+ * @struct FGeometryRange
+ * @brief Location of one mesh inside a JGeometryPool.
+ *
+ * Indices are stored mesh-local, so a range is drawn with
+ * glDrawElementsBaseVertex(..., FirstIndex, BaseVertex) from the pool's shared VAO.
+ */
+struct FGeometryRange
+{
+    GLint BaseVertex = 0;   ///< First vertex of the mesh in the shared vertex buffer
+    GLuint VertexCount = 0; ///< Number of vertices
+    GLuint FirstIndex = 0;  ///< First index of the mesh in the shared index buffer
+    GLuint IndexCount = 0;  ///< Number of indices
+
+    /// Byte offset of FirstIndex, as expected by the glDrawElements* family.
+    inline const void* GetIndexOffset() const
+    {
+        return reinterpret_cast<const void*>(static_cast<uintptr_t>(FirstIndex) * sizeof(GLuint));
+    }
+};
+
+/**
+ * @class JGeometryPool
+ * @brief Global geometry arena: one large vertex and index buffer per vertex layout.
+ *
+ * Instead of every JMesh owning a VAO, VBO and EBO, meshes are sub-allocated from shared
+ * buffers with a best-fit free list (JFreeListAllocator). A mesh is then just an
+ * FGeometryRange, and all meshes of a layout are drawn from a single VAO, which removes
+ * VAO switches between meshes and makes merged submission (multi-draw) possible.
+ *
+ * Buffers grow geometrically when full. When meshes are released the freed ranges are
+ * coalesced, and DefragmentIfNeeded() compacts all live ranges to the front of the
+ * buffers once the free space becomes too scattered. Handles stay valid across growth
+ * and compaction, only the ranges they resolve to move.
+ *
+ * Positions are additionally kept in a tightly packed vec3 buffer with its own VAO
+ * (EVertexStream::PositionOnly), so depth-only passes fetch 12 bytes per vertex instead of
+ * the whole interleaved vertex. Both streams share the index buffer and the vertex ranges.
+ *
+ * Example usage:
+ * @code
+ * auto& pool = JGeometryPool::Get();
+ * auto handle = pool.Allocate(vertices.data(), vertices.size(), indices.data(), indices.size());
+ * pool.Bind();
+ * const FGeometryRange& range = pool.GetRange(handle);
+ * glDrawElementsBaseVertex(GL_TRIANGLES, range.IndexCount, GL_UNSIGNED_INT, range.GetIndexOffset(), range.BaseVertex);
+ * @endcode
+ */
+class JGeometryPool {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = ~static_cast<Handle>(0);
+
+    /**
+     * @brief Access the pool for a vertex layout. Pools are created lazily on first use,
+     *        so a GL context must be current.
+     */
+    static JGeometryPool& Get(EVertexLayout layout = EVertexLayout::Standard);
+
+    /**
+     * @brief Shared ownership of a pool, for owners of allocations that may be destroyed during
+     *        static destruction (e.g. a JModel held by a singleton), after the registry let go.
+     */
+    static std::shared_ptr<JGeometryPool> GetShared(EVertexLayout layout = EVertexLayout::Standard);
+
+    /**
+     * @brief Delete the GL objects of every pool created so far. Call while the context is still
+     *        current: the pools live until static destruction, after the context is gone.
+     */
+    static void ShutdownAll();
+
+    ~JGeometryPool();
+
+    JGeometryPool(const JGeometryPool&) = delete;
+    JGeometryPool& operator=(const JGeometryPool&) = delete;
+
+    /**
+     * @brief Upload a mesh into the shared buffers.
+     * @param vertices Vertex data in this pool's layout.
+     * @param vertexCount Number of vertices.
+     * @param indices Mesh-local indices (0 = first vertex of this mesh).
+     * @param indexCount Number of indices.
+     * @return Handle used to resolve the mesh's range, or InvalidHandle on empty input.
+     */
+    Handle Allocate(const S_Vertex* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount);
+
+    /**
+     * @brief Release a mesh's ranges. The handle becomes invalid.
+     */
+    void Free(Handle handle);
+
+    /**
+     * @brief Compact live ranges if the free space is fragmented enough to be worth it.
+     *
+     * Call after unloading a batch of meshes (e.g. when a JModel is destroyed).
+     */
+    void DefragmentIfNeeded();
+
+    /**
+     * @brief Pack all live ranges to the front of the buffers unconditionally.
+     *
+     * Copies are done GPU-side with glCopyBufferSubData into freshly allocated buffers.
+     */
+    void Defragment();
+
+    /**
+     * @brief Delete the shared buffers and VAOs. Free() keeps working for meshes released later,
+     *        everything touching GL does nothing.
+     */
+    void Shutdown();
+
+    /// Resolve a handle to its current range.
+    inline const FGeometryRange& GetRange(Handle handle) const { return Slots[handle].Range; }
+
+    /**
+     * @brief Bind the shared VAO of a stream (vertex buffer, index buffer and attribute layout).
+     * @param stream Full attributes or positions only. Also selects the VAO SetInstanceBuffer() configures.
+     */
+    void Bind(EVertexStream stream = EVertexStream::Full) const;
+
+    /**
+     * @brief Point the per-instance model matrix attribute (INSTANCE_MATRIX_LOCATION) of the
+     *        VAO of the last bound stream at a slice of an instance buffer. Leaves that VAO bound.
+     * @param instanceVBO Buffer holding one mat4 per instance.
+     * @param byteOffset Byte offset of the first instance to read.
+     */
+    void SetInstanceBuffer(GLuint instanceVBO, size_t byteOffset) const;
+
+    inline GLuint GetVertexArray() const { return VAO; }
+    inline GLuint GetVertexBuffer() const { return VBO; }
+    inline GLuint GetIndexBuffer() const { return EBO; }
+
+    /// Vertices currently allocated.
+    inline size_t GetUsedVertices() const { return VertexAllocator.GetUsed(); }
+
+    /// Indices currently allocated.
+    inline size_t GetUsedIndices() const { return IndexAllocator.GetUsed(); }
+
+    /// Number of live meshes.
+    inline size_t GetLiveAllocations() const { return Slots.size() - FreeSlots.size(); }
+
+private:
+    explicit JGeometryPool(EVertexLayout layout);
+
+    struct FSlot
+    {
+        FGeometryRange Range;
+        bool bLive = false;
+    };
+
+    EVertexLayout Layout;
+    size_t VertexStride;
+
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLuint EBO = 0;
+    GLuint PositionVAO = 0; ///< VAO of the position-only stream
+    GLuint PositionVBO = 0; ///< Packed vec3 positions, indexed like VBO
+
+    mutable EVertexStream ActiveStream = EVertexStream::Full;
+
+    JFreeListAllocator VertexAllocator;
+    JFreeListAllocator IndexAllocator;
+
+    std::vector<FSlot> Slots;
+    std::vector<Handle> FreeSlots;
+
+    /// Reallocate a buffer with a larger capacity, preserving its contents.
+    static GLuint GrowBuffer(GLuint buffer, size_t oldBytes, size_t newBytes);
+
+    void EnsureCapacity(size_t vertexCount, size_t indexCount);
+
+    /// (Re)attach VBO/EBO and the vertex layout to the shared VAOs.
+    void SetupVertexArray();
+};
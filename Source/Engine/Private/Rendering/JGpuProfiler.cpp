@@ -0,0 +1,207 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JGpuProfiler.h"
+
+#include "JGLCapabilities.h"
+#include "JRenderStats.h"
+
+#include <algorithm>
+#include <cstring>
+
+JGpuProfiler::JGpuProfiler() = default;
+
+JGpuProfiler::~JGpuProfiler()
+{
+    for (FFrame& frame : Frames)
+    {
+        if (!frame.Queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+    }
+}
+
+void JGpuProfiler::BeginFrame()
+{
+    // A pass left open by the previous frame would unbalance the debug group stack
+    while (!OpenPasses.empty())
+        EndPass();
+
+    if (bRecording)
+    {
+        Frames[Head].bPending = Frames[Head].LastEnd >= 0;
+        bRecording = false;
+    }
+
+    // Oldest frames first, the GPU finishes them in order
+    for (int i = 1; i <= FrameLatency; ++i)
+    {
+        FFrame& frame = Frames[(Head + i) % FrameLatency];
+        if (!frame.bPending) continue;
+
+        // Timestamps complete in submission order, the last one being available covers the frame.
+        // That's the end of the last pass to end (an outer one), not of the last pass to begin
+        GLint available = 0;
+        glGetQueryObjectiv(frame.Queries[frame.LastEnd], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        ReadFrame(frame);
+    }
+
+    Head = (Head + 1) % FrameLatency;
+    FFrame& frame = Frames[Head];
+
+    // Still in flight after FrameLatency frames: skip timing rather than wait, and keep its
+    // passes for the readback once it lands
+    if (frame.bPending) return;
+    bRecording = bEnabled;
+    frame.Timed.clear();
+    frame.LastEnd = -1;
+}
+
+void JGpuProfiler::BeginPass(const char* name)
+{
+    JRenderStats::Get().BeginPass(name);
+
+    FOpenPass open;
+
+    const JGLCapabilities& caps = JGLCapabilities::Get();
+    if (caps.HasDebugGroups())
+    {
+        caps.PushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+        open.bDebugGroup = true;
+    }
+
+    FFrame& frame = Frames[Head];
+    if (bRecording && frame.Timed.size() < MaxPassesPerFrame)
+    {
+        const int begin = static_cast<int>(frame.Timed.size()) * 2;
+        if (frame.Queries.size() < static_cast<size_t>(begin + 2))
+        {
+            frame.Queries.resize(begin + 2);
+            glGenQueries(2, &frame.Queries[begin]);
+        }
+
+        FTimedPass timed;
+        timed.Stats = FindOrAddPass(name);
+        timed.Begin = begin;
+        glQueryCounter(frame.Queries[begin], GL_TIMESTAMP);
+
+        open.Timed = static_cast<int>(frame.Timed.size());
+        frame.Timed.push_back(timed);
+    }
+
+    OpenPasses.push_back(open);
+}
+
+void JGpuProfiler::EndPass()
+{
+    if (OpenPasses.empty()) return;
+    const FOpenPass open = OpenPasses.back();
+    OpenPasses.pop_back();
+
+    if (open.Timed >= 0)
+    {
+        FFrame& frame = Frames[Head];
+        frame.LastEnd = frame.Timed[open.Timed].Begin + 1;
+        glQueryCounter(frame.Queries[frame.LastEnd], GL_TIMESTAMP);
+    }
+    if (open.bDebugGroup)
+        JGLCapabilities::Get().PopDebugGroup();
+
+    JRenderStats::Get().EndPass();
+}
+
+const FGpuPassStats* JGpuProfiler::FindPass(const std::string& name) const
+{
+    for (const FGpuPassStats& pass : Passes)
+    {
+        if (pass.Name == name) return &pass;
+    }
+    return nullptr;
+}
+
+float JGpuProfiler::GetTotalMs() const
+{
+    float total = 0.f;
+    for (const FGpuPassStats& pass : Passes)
+    {
+        if (pass.Depth == 0) total += pass.AverageMs;
+    }
+    return total;
+}
+
+int JGpuProfiler::GetPendingFrames() const
+{
+    int pending = 0;
+    for (const FFrame& frame : Frames)
+        pending += frame.bPending ? 1 : 0;
+    return pending;
+}
+
+void JGpuProfiler::ResetPeaks()
+{
+    for (FGpuPassStats& pass : Passes)
+        pass.PeakMs = 0.f;
+}
+
+// --------------------- Readback ---------------------
+int JGpuProfiler::FindOrAddPass(const char* name)
+{
+    for (size_t i = 0; i < Passes.size(); ++i)
+    {
+        if (std::strcmp(Passes[i].Name.c_str(), name) == 0) return static_cast<int>(i);
+    }
+
+    FGpuPassStats pass;
+    pass.Name = name;
+    pass.Depth = static_cast<int>(OpenPasses.size());
+    pass.History.reserve(HistorySize);
+    Passes.push_back(std::move(pass));
+    return static_cast<int>(Passes.size() - 1);
+}
+
+void JGpuProfiler::ReadFrame(FFrame& frame)
+{
+    FrameSums.assign(Passes.size(), 0.0);
+    FrameSeen.assign(Passes.size(), false);
+
+    for (const FTimedPass& timed : frame.Timed)
+    {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.Queries[timed.Begin], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.Queries[timed.Begin + 1], GL_QUERY_RESULT, &end);
+        FrameSums[timed.Stats] += end > begin ? static_cast<double>(end - begin) * 1e-6 : 0.0;
+        FrameSeen[timed.Stats] = true;
+    }
+
+    for (size_t i = 0; i < Passes.size(); ++i)
+    {
+        if (FrameSeen[i]) AddSample(Passes[i], static_cast<float>(FrameSums[i]));
+    }
+    frame.bPending = false;
+}
+
+void JGpuProfiler::AddSample(FGpuPassStats& pass, float ms)
+{
+    if (pass.History.size() < HistorySize)
+    {
+        pass.History.push_back(ms);
+    }
+    else
+    {
+        pass.History[pass.HistoryHead] = ms;
+        pass.HistoryHead = (pass.HistoryHead + 1) % HistorySize;
+    }
+
+    float sum = 0.f;
+    pass.MaxMs = 0.f;
+    for (float sample : pass.History)
+    {
+        sum += sample;
+        pass.MaxMs = std::max(pass.MaxMs, sample);
+    }
+    pass.LastMs = ms;
+    ++pass.SampleCount;
+    pass.TotalMs += ms;
+    pass.PeakMs = std::max(pass.PeakMs, ms);
+    pass.AverageMs = sum / static_cast<float>(pass.History.size());
+}
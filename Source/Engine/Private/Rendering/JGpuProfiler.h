@@ -0,0 +1,155 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <glad/gl.h>
+#include <string>
+#include <vector>
+
+/// Rolling GPU timing of one named pass.
+struct FGpuPassStats
+{
+    std::string Name;
+    int Depth = 0;            ///< Nesting level of the pass' first occurrence
+    float LastMs = 0.f;       ///< Latest frame, every occurrence of the name summed
+    float AverageMs = 0.f;    ///< Mean of History
+    float MaxMs = 0.f;        ///< Peak of History
+    std::vector<float> History; ///< Last HistorySize samples, oldest at HistoryHead once full
+    int HistoryHead = 0;
+    uint64_t SampleCount = 0; ///< Samples since the pass was first seen
+    double TotalMs = 0.0;     ///< Sum of those samples, for means over long runs
+    float PeakMs = 0.f;       ///< Largest of those samples since the last ResetPeaks()
+};
+
+/**
+ * @class JGpuProfiler
+ * @brief Measures the GPU time of named passes with timestamp queries, without stalling.
+ *
+ * BeginPass() and EndPass() bracket a pass with GL_TIMESTAMP queries (glQueryCounter), which
+ * unlike GL_TIME_ELAPSED may nest. Queries are recorded per frame in a ring of FrameLatency
+ * frames; BeginFrame() reads back the frames whose last query is available and never waits
+ * on one that isn't. A frame whose slot is still in flight is simply not timed.
+ *
+ * Every occurrence of a name in a frame adds up to one sample, so an effect split into
+ * several graph passes reports its total. Each pass keeps the last HistorySize samples,
+ * their mean and peak.
+ *
+ * When the context supports KHR_debug (see JGLCapabilities), each pass is also a debug group,
+ * so frame captures in RenderDoc or Nsight show the same hierarchy. Passes are also forwarded
+ * to JRenderStats for its per-pass counters, enabled or not.
+ *
+ * Typical usage (JRenderer advances the frame in BeginScene()):
+ * @code
+ * Profiler.BeginFrame();
+ * {
+ *     JGpuScope scope(&Profiler, "Scene");
+ *     // ... draw
+ * }
+ * for (const FGpuPassStats& pass : Profiler.GetPasses())
+ *     std::cout << pass.Name << ": " << pass.AverageMs << " ms\n";
+ * @endcode
+ */
+class JGpuProfiler {
+public:
+    /// Frames of queries in flight before a frame's slot is reused.
+    static constexpr int FrameLatency = 4;
+
+    /// Samples in the rolling average of a pass.
+    static constexpr int HistorySize = 120;
+
+    /// Timed passes per frame, further passes only get their debug group.
+    static constexpr int MaxPassesPerFrame = 256;
+
+    JGpuProfiler();
+    ~JGpuProfiler();
+
+    JGpuProfiler(const JGpuProfiler&) = delete;
+    JGpuProfiler& operator=(const JGpuProfiler&) = delete;
+
+    /** @brief Close the previous frame, read back finished ones and start recording this one. */
+    void BeginFrame();
+
+    /** @brief Start a pass, nested in the open one if any. name is copied only when first seen. */
+    void BeginPass(const char* name);
+
+    /** @brief End the innermost open pass. */
+    void EndPass();
+
+    /** @brief When disabled no queries are issued, debug groups still are. */
+    inline void SetEnabled(bool bEnable) { bEnabled = bEnable; }
+    inline bool IsEnabled() const { return bEnabled; }
+
+    /// Every pass seen so far, in order of first appearance.
+    inline const std::vector<FGpuPassStats>& GetPasses() const { return Passes; }
+
+    /// Pass of that name, null if it never ran.
+    const FGpuPassStats* FindPass(const std::string& name) const;
+
+    /// Sum of the average times of the top-level passes.
+    float GetTotalMs() const;
+
+    /// Frames recorded but not read back yet.
+    int GetPendingFrames() const;
+
+    /// Restart the run-wide peak of every pass, e.g. once a warmup is over.
+    void ResetPeaks();
+
+private:
+    struct FTimedPass
+    {
+        int Stats = 0;    ///< Index into Passes
+        int Begin = 0;    ///< Index of the begin query in the frame's Queries, the end one follows
+    };
+
+    struct FFrame
+    {
+        std::vector<GLuint> Queries;
+        std::vector<FTimedPass> Timed;
+        int LastEnd = -1;         ///< End query issued last, the latest timestamp of the frame
+        bool bPending = false;
+    };
+
+    /// Pass opened by BeginPass(), Timed is -1 if it got no queries.
+    struct FOpenPass
+    {
+        int Timed = -1;
+        bool bDebugGroup = false;
+    };
+
+    FFrame Frames[FrameLatency];
+    int Head = 0;             ///< Slot of the frame being recorded
+    bool bRecording = false;
+    bool bEnabled = true;
+
+    std::vector<FOpenPass> OpenPasses;
+    std::vector<FGpuPassStats> Passes;
+    std::vector<double> FrameSums; ///< Scratch, per pass of a frame being read back
+    std::vector<bool> FrameSeen;
+
+    int FindOrAddPass(const char* name);
+    void ReadFrame(FFrame& frame);
+    static void AddSample(FGpuPassStats& pass, float ms);
+};
+
+/**
+ * @class JGpuScope
+ * @brief Times the enclosing scope as a pass of a JGpuProfiler, which may be null.
+ */
+class JGpuScope {
+public:
+    JGpuScope(JGpuProfiler* profiler, const char* name) : Profiler(profiler)
+    {
+        if (Profiler) Profiler->BeginPass(name);
+    }
+    ~JGpuScope()
+    {
+        if (Profiler) Profiler->EndPass();
+    }
+
+    JGpuScope(const JGpuScope&) = delete;
+    JGpuScope& operator=(const JGpuScope&) = delete;
+
+private:
+    JGpuProfiler* Profiler;
+};
@@ -0,0 +1,208 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JInstanceBatcher.h"
+
+#include <algorithm>
+
+#include "Core/JCpuProfiler.h"
+#include "JGeometryPool.h"
+#include "JModel.h"
+#include "JRenderStats.h"
+#include "JShader.h"
+#include "Scene/JActor.h"
+
+JInstanceBatcher::JInstanceBatcher()
+{
+    glGenBuffers(1, &InstanceVBO);
+}
+
+JInstanceBatcher::~JInstanceBatcher()
+{
+    Shutdown();
+}
+
+void JInstanceBatcher::Shutdown()
+{
+    if (InstanceVBO) glDeleteBuffers(1, &InstanceVBO);
+    InstanceVBO = 0;
+    InstanceCapacity = 0;
+}
+
+void JInstanceBatcher::Begin()
+{
+    // A group nobody submitted to since the last Begin() belongs to a model or config no longer drawn
+    Groups.erase(std::remove_if(Groups.begin(), Groups.end(),
+        [](const FInstanceGroup& group) { return group.Transforms.empty(); }), Groups.end());
+
+    for (auto& group : Groups)
+    {
+        group.Transforms.clear();
+        group.MeshMasks.clear();
+    }
+}
+
+bool JInstanceBatcher::Submit(const JActor& actor, const uint8_t* meshVisibility)
+{
+    if (!actor.Model) return false;
+
+    switch (Pass)
+    {
+        case EBatchPass::Opaque:
+            if (actor.Config.bIsTransparent || actor.Config.bDrawOutline) return false;
+            break;
+        case EBatchPass::Transparent:
+            if (!actor.Config.bIsTransparent || actor.Config.bDrawOutline) return false;
+            break;
+        case EBatchPass::ShadowCaster:
+            if (actor.Config.bIsTransparent) return false;
+            break;
+    }
+
+    FInstanceGroup& group = FindOrAddGroup(actor);
+    group.Transforms.push_back(actor.GetModelMatrix());
+
+    const size_t meshCount = actor.Model->Meshes.size();
+    if (meshVisibility)
+        group.MeshMasks.insert(group.MeshMasks.end(), meshVisibility, meshVisibility + meshCount);
+    else
+        group.MeshMasks.insert(group.MeshMasks.end(), meshCount, 1);
+    return true;
+}
+
+void JInstanceBatcher::Flush(JShader& shader, EVertexStream stream)
+{
+    J_PROFILE_SCOPE("Batch Submission");
+    const bool bDepthOnly = stream == EVertexStream::PositionOnly;
+
+    DrawCount = 0;
+    InstanceCount = 0;
+
+    // Emit one instanced command per visible mesh and sort them into material buckets.
+    // Buckets are rebuilt every frame (meshes may have been unloaded) but their storage is reused.
+    BucketLookup.clear();
+    ActiveBuckets = 0;
+    Staging.clear();
+
+    for (const auto& group : Groups)
+    {
+        const size_t instanceCount = group.Transforms.size();
+        if (instanceCount == 0) continue;
+
+        const size_t meshCount = group.Model->Meshes.size();
+        PreviousInstances.clear();
+        GLuint sliceFirst = 0;
+
+        for (size_t m = 0; m < meshCount; ++m)
+        {
+            JMesh& mesh = group.Model->Meshes[m];
+            if (mesh.Geometry == JGeometryPool::InvalidHandle) continue;
+
+            VisibleInstances.clear();
+            for (size_t i = 0; i < instanceCount; ++i)
+                if (group.MeshMasks[i * meshCount + m]) VisibleInstances.push_back(static_cast<uint32_t>(i));
+
+            if (VisibleInstances.empty()) continue;
+
+            // Pack the transforms of this visibility pattern unless the previous mesh already did
+            if (VisibleInstances != PreviousInstances)
+            {
+                sliceFirst = static_cast<GLuint>(Staging.size());
+                for (uint32_t i : VisibleInstances)
+                    Staging.push_back(group.Transforms[i]);
+                PreviousInstances.swap(VisibleInstances);
+            }
+
+            FindOrAddBucket(group.Model, mesh, group.bBackCulling, bDepthOnly).Commands.push_back(
+                FDrawElementsIndirectCommand::FromRange(mesh.GetGeometryRange(), sliceFirst,
+                    static_cast<GLuint>(PreviousInstances.size())));
+            ++DrawCount;
+        }
+
+        InstanceCount += static_cast<int>(instanceCount);
+    }
+
+    if (Staging.empty())
+    {
+        PassCommands.clear();
+        Submitter.Upload(PassCommands);
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, InstanceVBO);
+    if (Staging.size() > InstanceCapacity)
+    {
+        // Grow geometrically to avoid reallocating every time a few actors are added
+        InstanceCapacity = std::max(Staging.size(), InstanceCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, InstanceCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, Staging.size() * sizeof(glm::mat4), Staging.data());
+    JRenderStats::CountUpload(Staging.size() * sizeof(glm::mat4));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Upload the whole pass at once, each bucket is a contiguous slice
+    PassCommands.clear();
+    for (size_t i = 0; i < ActiveBuckets; ++i)
+        PassCommands.insert(PassCommands.end(), Buckets[i].Commands.begin(), Buckets[i].Commands.end());
+    Submitter.Upload(PassCommands);
+
+    shader.Use();
+    JGeometryPool::Get().Bind(stream);
+
+    size_t firstCommand = 0;
+    for (size_t i = 0; i < ActiveBuckets; ++i)
+    {
+        const FMaterialBucket& bucket = Buckets[i];
+
+        if (bucket.bBackCulling)
+        {
+            glEnable(GL_CULL_FACE);
+            glCullFace(GL_BACK);
+        }
+
+        if (!bDepthOnly)
+            bucket.Mesh->BindTextures(shader);
+        Submitter.Draw(firstCommand, bucket.Commands.size(), InstanceVBO);
+        firstCommand += bucket.Commands.size();
+
+        glDisable(GL_CULL_FACE);
+    }
+
+    glBindVertexArray(0);
+}
+
+// --------------------- Internal Helpers ---------------------
+JInstanceBatcher::FInstanceGroup& JInstanceBatcher::FindOrAddGroup(const JActor& actor)
+{
+    for (auto& group : Groups)
+    {
+        if (group.Model == actor.Model && group.bBackCulling == actor.Config.bBackCulling)
+            return group;
+    }
+
+    FInstanceGroup group;
+    group.Model = actor.Model;
+    group.bBackCulling = actor.Config.bBackCulling;
+    Groups.push_back(std::move(group));
+    return Groups.back();
+}
+
+JInstanceBatcher::FMaterialBucket& JInstanceBatcher::FindOrAddBucket(const JModel* model, JMesh& mesh, bool bBackCulling,
+    bool bIgnoreMaterial)
+{
+    // Without materials only the culling state splits buckets
+    const FMaterialKey key = bIgnoreMaterial ? FMaterialKey{ nullptr, 0, bBackCulling }
+                                             : FMaterialKey{ model, mesh.MaterialIndex, bBackCulling };
+    auto it = BucketLookup.find(key);
+    if (it != BucketLookup.end())
+        return Buckets[it->second];
+
+    if (ActiveBuckets == Buckets.size())
+        Buckets.emplace_back();
+
+    FMaterialBucket& bucket = Buckets[ActiveBuckets];
+    bucket.Mesh = &mesh;
+    bucket.bBackCulling = bBackCulling;
+    bucket.Commands.clear();
+    BucketLookup.emplace(key, ActiveBuckets++);
+    return bucket;
+}
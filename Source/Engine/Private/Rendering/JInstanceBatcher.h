@@ -0,0 +1,174 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include "JDrawSubmitter.h"
+#include "JGeometryPool.h"
+
+class JActor;
+class JMesh;
+class JModel;
+class JShader;
+
+/// Which actors a JInstanceBatcher accepts.
+enum class EBatchPass : uint8_t
+{
+    Opaque,      ///< Opaque, non-outlined actors
+    Transparent, ///< Transparent, non-outlined actors (order-independent transparency)
+    ShadowCaster ///< Every opaque actor, outlined or not, drawn depth-only
+};
+
+/**
+ * @class JInstanceBatcher
+ * @brief Groups actors that share a JModel and render config into hardware-instanced draws.
+ *
+ * Every actor submitted between Begin() and Flush() is bucketed by (model, culling state).
+ * Wireframe is a global polygon mode set by the caller, so it doesn't split groups.
+ * On Flush() the model matrices of each bucket are uploaded into a single per-instance
+ * attribute buffer and each mesh of the model becomes one instanced draw command,
+ * so N actors of the same model cost one draw per mesh instead of N.
+ *
+ * Commands are then regrouped by material (same source material and culling state means
+ * same textures and GL state) and each material bucket is handed to a JDrawSubmitter,
+ * which issues the whole bucket as a multi-draw. A pass therefore costs roughly one
+ * submission per material rather than one per mesh.
+ *
+ * When a mesh visibility mask is passed to Submit() (see JFrustumCuller), each mesh only
+ * draws the instances it is visible in. Meshes whose visible instance list matches the
+ * previous mesh of the model share its slice of the instance buffer, so the common
+ * all-visible case still uploads every transform exactly once.
+ *
+ * Only actors that can be drawn in a single pass are accepted: transparent actors need
+ * back-to-front ordering and outlined actors need the multi-pass DrawConfig() path.
+ * A batcher switched to another pass (SetPass()) accepts transparent actors only, for
+ * order-independent transparency where draw order does not matter, or every opaque actor
+ * for depth-only shadow passes. Depth-only flushes (EVertexStream::PositionOnly) skip
+ * materials entirely, so a whole pass collapses into one bucket per culling state.
+ *
+ * Typical usage:
+ * @code
+ * Batcher.Begin();
+ * for (auto& actor : actors)
+ *     if (!Batcher.Submit(actor)) actor.DrawConfig(shader, outlineShader);
+ * Batcher.Flush(instancedShader);
+ * @endcode
+ *
+ * The shader passed to Flush() must read the instance matrix from
+ * INSTANCE_MATRIX_LOCATION (see ModelLoadingInstanced.vert).
+ */
+class JInstanceBatcher {
+public:
+    JInstanceBatcher();
+    ~JInstanceBatcher();
+
+    /** @brief Delete the instance buffer, while the GL context is still current. */
+    void Shutdown();
+
+    JInstanceBatcher(const JInstanceBatcher&) = delete;
+    JInstanceBatcher& operator=(const JInstanceBatcher&) = delete;
+
+    /**
+     * @brief Start a new frame. Clears collected instances but keeps group storage alive.
+     *
+     * Groups that received no actor since the previous Begin() are dropped.
+     */
+    void Begin();
+
+    /**
+     * @brief Queue an actor for instanced drawing.
+     * @param actor Actor to batch.
+     * @param meshVisibility Optional, one byte per mesh of the actor's model; zero skips the mesh.
+     * @return false if the actor cannot be instanced (wrong pass, outlined or has no model)
+     *         and must be drawn through the regular path.
+     */
+    bool Submit(const JActor& actor, const uint8_t* meshVisibility = nullptr);
+
+    /**
+     * @brief Upload all collected instance matrices and issue the instanced draws.
+     * @param shader Instancing-aware shader used for every group.
+     * @param stream Vertex stream to draw from. PositionOnly ignores materials and binds no textures.
+     */
+    void Flush(JShader& shader, EVertexStream stream = EVertexStream::Full);
+
+    /** @brief Select which actors Submit() accepts. */
+    inline void SetPass(EBatchPass pass) { Pass = pass; }
+
+    /// Number of draw commands (mesh x group) generated by the last Flush().
+    inline int GetDrawCount() const { return DrawCount; }
+
+    /// Number of GL draw calls the submitter needed for the last Flush().
+    inline int GetSubmitCallCount() const { return Submitter.GetCallCount(); }
+
+    /// Access to the submission backend (e.g. to force the GL 3.3 path).
+    inline JDrawSubmitter& GetSubmitter() { return Submitter; }
+
+    /// Number of actors drawn by the last Flush().
+    inline int GetInstanceCount() const { return InstanceCount; }
+
+private:
+    struct FInstanceGroup
+    {
+        JModel* Model = nullptr;
+        bool bBackCulling = false;
+        std::vector<glm::mat4> Transforms; ///< Model matrices collected this frame
+        std::vector<uint8_t> MeshMasks;    ///< Transforms.size() x mesh count visibility flags
+    };
+
+    /// Meshes that can be drawn with the same textures and state
+    struct FMaterialBucket
+    {
+        JMesh* Mesh = nullptr; ///< Any mesh of the bucket, used to bind the material textures
+        bool bBackCulling = false;
+        std::vector<FDrawElementsIndirectCommand> Commands;
+    };
+
+    struct FMaterialKey
+    {
+        const JModel* Model;
+        unsigned int MaterialIndex;
+        bool bBackCulling;
+
+        bool operator==(const FMaterialKey& other) const
+        {
+            return Model == other.Model && MaterialIndex == other.MaterialIndex && bBackCulling == other.bBackCulling;
+        }
+    };
+
+    struct FMaterialKeyHash
+    {
+        size_t operator()(const FMaterialKey& key) const
+        {
+            return std::hash<const void*>()(key.Model) ^ (static_cast<size_t>(key.MaterialIndex) << 1) ^ key.bBackCulling;
+        }
+    };
+
+    std::vector<FInstanceGroup> Groups; ///< Persistent across frames to avoid reallocations, idle ones are evicted
+    std::vector<glm::mat4> Staging;     ///< Contiguous copy of all transforms for one upload
+
+    // Scratch lists of visible instances while building a group's per-mesh slices
+    std::vector<uint32_t> VisibleInstances;
+    std::vector<uint32_t> PreviousInstances;
+
+    std::vector<FMaterialBucket> Buckets; ///< Only the first ActiveBuckets are in use this frame
+    size_t ActiveBuckets = 0;
+    std::unordered_map<FMaterialKey, size_t, FMaterialKeyHash> BucketLookup;
+    std::vector<FDrawElementsIndirectCommand> PassCommands; ///< All buckets' commands, back to back
+
+    JDrawSubmitter Submitter;
+
+    GLuint InstanceVBO = 0;      ///< Per-instance attribute buffer
+    size_t InstanceCapacity = 0; ///< Capacity of InstanceVBO in matrices
+
+    EBatchPass Pass = EBatchPass::Opaque;
+
+    int DrawCount = 0;
+    int InstanceCount = 0;
+
+    FInstanceGroup& FindOrAddGroup(const JActor& actor);
+    FMaterialBucket& FindOrAddBucket(const JModel* model, JMesh& mesh, bool bBackCulling, bool bIgnoreMaterial);
+};
@@ -5,16 +5,55 @@
 #include <glad/gl.h>
 #include <string>
 #include "JShader.h"
+#include "JRenderStats.h"
 
 JMesh::JMesh(vector<S_Vertex> Vertices, vector<unsigned int> Indices, vector<S_Texture> Textures)
 {
     this->Vertices = Vertices;
     this->Indices = Indices;
     this->Textures = Textures;
+
+    for (const auto& vertex : this->Vertices)
+        Bounds.Expand(vertex.Position);
+
     SetupMesh();
 }
 
 void JMesh::Draw(JShader &Shader)
+{
+    BindTextures(Shader);
+
+    // Draw mesh from the shared pool VAO
+    const FGeometryRange& range = GetGeometryRange();
+    JGeometryPool::Get().Bind();
+    glDrawElementsBaseVertex(GL_TRIANGLES, range.IndexCount, GL_UNSIGNED_INT, range.GetIndexOffset(), range.BaseVertex);
+    JRenderStats::CountDraw(range.IndexCount / 3);
+}
+
+void JMesh::DrawInstanced(JShader &Shader, unsigned int InstanceVBO, size_t InstanceOffset, int InstanceCount)
+{
+    BindTextures(Shader);
+
+    const FGeometryRange& range = GetGeometryRange();
+    JGeometryPool::Get().SetInstanceBuffer(InstanceVBO, InstanceOffset);
+
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.IndexCount, GL_UNSIGNED_INT, range.GetIndexOffset(),
+        InstanceCount, range.BaseVertex);
+    JRenderStats::CountDraw(range.IndexCount / 3, InstanceCount);
+}
+
+void JMesh::Release(JGeometryPool& Pool)
+{
+    Pool.Free(Geometry);
+    Geometry = JGeometryPool::InvalidHandle;
+}
+
+const FGeometryRange& JMesh::GetGeometryRange() const
+{
+    return JGeometryPool::Get().GetRange(Geometry);
+}
+
+void JMesh::BindTextures(JShader &Shader)
 {
     unsigned int diffuseNr = 1;
     unsigned int specularNr = 1;
@@ -37,52 +76,13 @@ void JMesh::Draw(JShader &Shader)
 
         Shader.SetInt(name + number, i);
         glBindTexture(GL_TEXTURE_2D, Textures[i].ID);
+        JRenderStats::CountTextureBind();
     }
     glActiveTexture(GL_TEXTURE0);
-
-    // Draw mesh
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(Indices.size()), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
 }
 
 void JMesh::SetupMesh()
 {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    glBufferData(GL_ARRAY_BUFFER, Vertices.size() * sizeof(S_Vertex), &Vertices[0], GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size() * sizeof(unsigned int),
-            &Indices[0], GL_STATIC_DRAW);
-
-    // Vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)0);
-    // Vertex normals
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, Normal));
-    // Vertex texture coords
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, TexCoords));
-    // Vertex tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, Tangent));
-    // Vertex bitangent
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, Bitangent));
-    // IDs
-    glEnableVertexAttribArray(5);
-    glVertexAttribIPointer(5, 4, GL_INT, sizeof(S_Vertex), (void*)offsetof(S_Vertex, M_BoneIDs));
-
-    // Weights
-    glEnableVertexAttribArray(6);
-    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(S_Vertex), (void*)offsetof(S_Vertex, M_Weights));
-
-    glBindVertexArray(0);
+    // Sub-allocate from the shared vertex/index buffers instead of owning a VAO/VBO/EBO
+    Geometry = JGeometryPool::Get().Allocate(Vertices.data(), Vertices.size(), Indices.data(), Indices.size());
 }
@@ -4,8 +4,11 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
+#include "JGeometryPool.h"
+#include "../Core/Math/FAABB.h"
 
 #define MAX_BONE_INFLUENCE 4
+#define INSTANCE_MATRIX_LOCATION 7 // mat4 per-instance attribute, occupies locations 7-10
 
 using namespace std;
 using namespace glm;
@@ -34,14 +37,21 @@ public:
     vector<S_Vertex> Vertices;
     vector<unsigned int> Indices;
     vector<S_Texture> Textures;
-    unsigned int VAO;
+    JGeometryPool::Handle Geometry = JGeometryPool::InvalidHandle; // Range inside the shared geometry pool
+    unsigned int MaterialIndex = 0; // Source material, meshes of a model with the same index share textures
+    FAABB Bounds; // Object-space bounds, computed once at import
 
     JMesh(vector<S_Vertex> Vertices, vector<unsigned int> Indices, vector<S_Texture> Textures);
 
     void Draw(class JShader &Shader);
+    // Draws InstanceCount copies, reading one mat4 per instance from InstanceVBO at InstanceOffset (bytes)
+    void DrawInstanced(class JShader &Shader, unsigned int InstanceVBO, size_t InstanceOffset, int InstanceCount);
+    // Returns the mesh's geometry to Pool. Meshes are copied around by value, so the owner (JModel) calls this once.
+    void Release(JGeometryPool& Pool);
 
-private:
-    unsigned int VBO, EBO;
+    const FGeometryRange& GetGeometryRange() const;
+    void BindTextures(class JShader &Shader);
 
+private:
     void SetupMesh();
 };
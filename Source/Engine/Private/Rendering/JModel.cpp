@@ -3,34 +3,41 @@
 #include "JModel.h"
 
 #include "JShader.h"
+#include "Core/JCpuProfiler.h"
 #include <iostream>
 #include <stb/stb_image.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
-JModel::JModel(string Path)
+JModel::JModel(string Path) : GeometryPool(JGeometryPool::GetShared())
 {
     LoadModel(Path); // Load the model at construction
 }
 
+JModel::~JModel()
+{
+    // Meshes share the global geometry pool, give their ranges back and compact if it got too sparse.
+    // Our own reference keeps the pool alive when this runs during static destruction
+    for(auto& mesh : Meshes)
+        mesh.Release(*GeometryPool);
+    GeometryPool->DefragmentIfNeeded();
+}
+
 void JModel::Draw(JShader &Shader)
 {
-    // Draw all meshes
+    // Draw all meshes, they all live in the same pool VAO
     for(unsigned int i = 0; i < Meshes.size(); i++)
         Meshes[i].Draw(Shader);
+    glBindVertexArray(0);
 }
 
 void JModel::LoadModel(string Path)
 {
+    J_PROFILE_SCOPE("Model Loading");
     Assimp::Importer Import;
     const aiScene* Scene = Import.ReadFile(
-        (string(ENGINE_DIRECTORY) + "/Assets/Meshes/" + Path).c_str(),
-        aiProcess_Triangulate |        // Ensure triangles
-        aiProcess_FlipUVs |            // Flip UVs for OpenGL
-        aiProcess_GenSmoothNormals |   // Generate normals if missing
-        aiProcess_CalcTangentSpace     // Generate tangents/bitangents if missing
-    );
+        (string(ENGINE_DIRECTORY) + "/Assets/Meshes/" + Path).c_str(), ImportFlags);
 
     // Check for errors
     if(!Scene || Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !Scene->mRootNode)
@@ -42,6 +49,9 @@ void JModel::LoadModel(string Path)
     // Extract directory path
     Directory = Path.substr(0, Path.find_last_of('/'));
     ProcessNode(Scene->mRootNode, Scene);
+
+    for (const auto& mesh : Meshes)
+        Bounds.Expand(mesh.Bounds);
 }
 
 void JModel::ProcessNode(aiNode *Node, const aiScene *Scene)
@@ -65,6 +75,36 @@ JMesh JModel::ProcessMesh(aiMesh *Mesh, const aiScene *Scene)
     std::vector<S_Vertex> vertices;
     std::vector<unsigned int> indices;
     std::vector<S_Texture> textures;
+    ConvertMesh(Mesh, vertices, indices);
+
+    // Process material
+    if(Mesh->mMaterialIndex >= 0)
+    {
+        aiMaterial* material = Scene->mMaterials[Mesh->mMaterialIndex];
+
+        // Load diffuse, specular, normal, height maps
+        auto DiffuseMaps  = LoadMaterialTextures(material, aiTextureType_DIFFUSE,  "texture_diffuse", Scene);
+        auto SpecularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", Scene);
+        auto NormalMaps   = LoadMaterialTextures(material, aiTextureType_HEIGHT,   "texture_normal", Scene);
+        auto HeightMaps   = LoadMaterialTextures(material, aiTextureType_AMBIENT,  "texture_height", Scene);
+
+        textures.insert(textures.end(), DiffuseMaps.begin(), DiffuseMaps.end());
+        textures.insert(textures.end(), SpecularMaps.begin(), SpecularMaps.end());
+        textures.insert(textures.end(), NormalMaps.begin(), NormalMaps.end());
+        textures.insert(textures.end(), HeightMaps.begin(), HeightMaps.end());
+    }
+
+    JMesh result(vertices, indices, textures);
+    result.MaterialIndex = Mesh->mMaterialIndex;
+    return result;
+}
+
+void JModel::ConvertMesh(const aiMesh *Mesh, std::vector<S_Vertex> &OutVertices, std::vector<unsigned int> &OutIndices)
+{
+    OutVertices.clear();
+    OutIndices.clear();
+    OutVertices.reserve(Mesh->mNumVertices);
+    OutIndices.reserve(static_cast<size_t>(Mesh->mNumFaces) * 3); // Triangulated on import
 
     // Walk through each vertex
     for(unsigned int i = 0; i < Mesh->mNumVertices; i++)
@@ -88,7 +128,7 @@ JMesh JModel::ProcessMesh(aiMesh *Mesh, const aiScene *Scene)
         else
             Vertex.Tangent = Vertex.Bitangent = glm::vec3(0.0f);
 
-        vertices.push_back(Vertex);
+        OutVertices.push_back(Vertex);
     }
 
     // Process indices
@@ -96,27 +136,8 @@ JMesh JModel::ProcessMesh(aiMesh *Mesh, const aiScene *Scene)
     {
         const aiFace& face = Mesh->mFaces[i];
         for(unsigned int j = 0; j < face.mNumIndices; j++)
-            indices.push_back(face.mIndices[j]);
+            OutIndices.push_back(face.mIndices[j]);
     }
-
-    // Process material
-    if(Mesh->mMaterialIndex >= 0)
-    {
-        aiMaterial* material = Scene->mMaterials[Mesh->mMaterialIndex];
-
-        // Load diffuse, specular, normal, height maps
-        auto DiffuseMaps  = LoadMaterialTextures(material, aiTextureType_DIFFUSE,  "texture_diffuse", Scene);
-        auto SpecularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", Scene);
-        auto NormalMaps   = LoadMaterialTextures(material, aiTextureType_HEIGHT,   "texture_normal", Scene);
-        auto HeightMaps   = LoadMaterialTextures(material, aiTextureType_AMBIENT,  "texture_height", Scene);
-
-        textures.insert(textures.end(), DiffuseMaps.begin(), DiffuseMaps.end());
-        textures.insert(textures.end(), SpecularMaps.begin(), SpecularMaps.end());
-        textures.insert(textures.end(), NormalMaps.begin(), NormalMaps.end());
-        textures.insert(textures.end(), HeightMaps.begin(), HeightMaps.end());
-    }
-
-    return JMesh(vertices, indices, textures);
 }
 
 std::vector<S_Texture> JModel::LoadMaterialTextures(aiMaterial* Mat, aiTextureType Type, std::string TypeName, const aiScene* Scene)
@@ -1,11 +1,13 @@
 // Copyright (c) 2025. JesseTheCatLover. All Rights Reserved.
 
 #pragma once
+#include <memory>
 #include <vector>
 #include <string>
 #include "JMesh.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
+#include <assimp/postprocess.h>
 
 using namespace std;
 
@@ -13,14 +15,31 @@ class JModel
 {
 public:
     JModel(string Path);
+    ~JModel();
+
+    JModel(const JModel&) = delete;
+    JModel& operator=(const JModel&) = delete;
 
     vector<S_Texture> TexturesLoaded;
     vector<JMesh> Meshes;
     string Directory;
+    FAABB Bounds; // Union of all mesh bounds, in model space
 
     void Draw(class JShader &Shader);
 
+    // Post-processing asked of Assimp when importing a model
+    static constexpr unsigned int ImportFlags =
+        aiProcess_Triangulate |        // Ensure triangles
+        aiProcess_FlipUVs |            // Flip UVs for OpenGL
+        aiProcess_GenSmoothNormals |   // Generate normals if missing
+        aiProcess_CalcTangentSpace;    // Generate tangents/bitangents if missing
+
+    // Convert an imported mesh to engine vertices and indices, no GL involved
+    static void ConvertMesh(const aiMesh* Mesh, vector<S_Vertex>& OutVertices, vector<unsigned int>& OutIndices);
+
 private:
+    shared_ptr<JGeometryPool> GeometryPool; // Pool the meshes live in, outlives them whatever the destruction order
+
     void LoadModel(string Path);
     void ProcessNode(aiNode* Node, const aiScene* Scene);
     class JMesh ProcessMesh(aiMesh* Mesh, const aiScene* Scene);
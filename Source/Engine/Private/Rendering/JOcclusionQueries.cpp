@@ -0,0 +1,218 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JOcclusionQueries.h"
+
+#include "JRenderStats.h"
+#include "JShader.h"
+#include "Scene/JActor.h"
+
+namespace
+{
+    /// Boxes are grown slightly so coplanar surfaces don't occlude their own bounds.
+    constexpr float kBoxInflation = 0.01f;
+}
+
+JOcclusionQueries::JOcclusionQueries()
+{
+    BoxShader = std::make_unique<JShader>("OcclusionBox", "OcclusionBox");
+    BoxShader->LinkUniformBlock("CameraData", 0);
+
+    const float vertices[] = {
+        -0.5f, -0.5f, -0.5f,   0.5f, -0.5f, -0.5f,   0.5f, 0.5f, -0.5f,   -0.5f, 0.5f, -0.5f,
+        -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f,   0.5f, 0.5f,  0.5f,   -0.5f, 0.5f,  0.5f,
+    };
+    const GLubyte indices[] = {
+        0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   // back, front
+        0, 4, 7, 0, 7, 3,   1, 2, 6, 1, 6, 5,   // left, right
+        0, 1, 5, 0, 5, 4,   3, 7, 6, 3, 6, 2,   // bottom, top
+    };
+
+    glGenVertexArrays(1, &BoxVAO);
+    glGenBuffers(1, &BoxVBO);
+    glGenBuffers(1, &BoxEBO);
+
+    glBindVertexArray(BoxVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, BoxVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, BoxEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+JOcclusionQueries::~JOcclusionQueries()
+{
+    ReleaseAll();
+    if (BoxEBO) glDeleteBuffers(1, &BoxEBO);
+    if (BoxVBO) glDeleteBuffers(1, &BoxVBO);
+    if (BoxVAO) glDeleteVertexArrays(1, &BoxVAO);
+}
+
+void JOcclusionQueries::SetEnabled(bool bEnable)
+{
+    if (bEnabled == bEnable) return;
+    bEnabled = bEnable;
+
+    // Start from a clean slate either way, old results describe another frame
+    ReleaseAll();
+}
+
+void JOcclusionQueries::BeginFrame()
+{
+    ++Frame;
+    Stats = FOcclusionQueryStats();
+    if (!bEnabled) return;
+
+    for (auto& [id, state] : States)
+    {
+        if (state.VisibleHold > 0) --state.VisibleHold;
+        if (!state.bPending) continue;
+
+        // Never block: results that are not ready stay in flight until a later frame
+        GLuint available = 0;
+        glGetQueryObjectuiv(state.Query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            ++Stats.PendingQueries;
+            continue;
+        }
+
+        GLuint anySamples = 0;
+        glGetQueryObjectuiv(state.Query, GL_QUERY_RESULT, &anySamples);
+        state.bPending = false;
+        ++Stats.ResolvedQueries;
+
+        if (anySamples)
+        {
+            state.VisibleHold = VisibleHoldFrames;
+            state.HiddenStreak = 0;
+        }
+        else
+        {
+            ++state.HiddenStreak;
+        }
+    }
+}
+
+void JOcclusionQueries::EndFrame()
+{
+    for (auto it = States.begin(); it != States.end();)
+    {
+        // Not a candidate this frame (removed, culled or no longer drawn). Deleting a query that is
+        // still in flight is allowed, GL discards the result
+        if (it->second.LastFrame != Frame)
+        {
+            glDeleteQueries(1, &it->second.Query);
+            it = States.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+JOcclusionQueries::EState JOcclusionQueries::GetState(const JActor& actor) const
+{
+    if (!bEnabled) return EState::Visible;
+
+    auto it = States.find(actor.m_InstanceID);
+    if (it == States.end()) return EState::Visible;
+
+    const FQueryState& state = it->second;
+    if (state.VisibleHold > 0) return EState::Visible;
+    if (state.HiddenStreak >= HiddenFramesToCull) return EState::Hidden;
+    return EState::Uncertain;
+}
+
+bool JOcclusionQueries::ShouldSubmit(const JActor& actor)
+{
+    if (GetState(actor) != EState::Hidden) return true;
+
+    ++Stats.RejectedDraws;
+    return false;
+}
+
+bool JOcclusionQueries::BeginConditionalDraw(const JActor& actor)
+{
+    if (GetState(actor) != EState::Uncertain) return false;
+
+    const FQueryState& state = States.find(actor.m_InstanceID)->second;
+    if (!state.bIssued) return false;
+
+    glBeginConditionalRender(state.Query, GL_QUERY_NO_WAIT);
+    ++Stats.ConditionalDraws;
+    return true;
+}
+
+void JOcclusionQueries::EndConditionalDraw()
+{
+    glEndConditionalRender();
+}
+
+void JOcclusionQueries::IssueQueries(const std::vector<const JActor*>& actors, const glm::vec3& cameraPosition)
+{
+    if (!bEnabled || actors.empty()) return;
+
+    // Test against the depth buffer without touching it
+    GLboolean depthMask = GL_TRUE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+
+    BoxShader->Use();
+    glBindVertexArray(BoxVAO);
+
+    for (const JActor* actor : actors)
+    {
+        FQueryState& state = States[actor->m_InstanceID];
+        state.LastFrame = Frame;
+        if (state.bPending) continue;
+
+        if (!state.Query) glGenQueries(1, &state.Query);
+
+        const FAABB bounds = actor->GetWorldBounds();
+        const glm::vec3 inflation = (bounds.Max - bounds.Min) * kBoxInflation + glm::vec3(kBoxInflation);
+        const glm::vec3 boxMin = bounds.Min - inflation;
+        const glm::vec3 boxMax = bounds.Max + inflation;
+
+        // From inside the box its faces are clipped away and the query would wrongly report hidden
+        const bool bCameraInside = cameraPosition.x >= boxMin.x && cameraPosition.y >= boxMin.y &&
+                                   cameraPosition.z >= boxMin.z && cameraPosition.x <= boxMax.x &&
+                                   cameraPosition.y <= boxMax.y && cameraPosition.z <= boxMax.z;
+        if (bCameraInside)
+        {
+            state.VisibleHold = VisibleHoldFrames;
+            state.HiddenStreak = 0;
+            continue;
+        }
+
+        BoxShader->SetVec3("u_BoxCenter", (boxMin + boxMax) * 0.5f);
+        BoxShader->SetVec3("u_BoxSize", boxMax - boxMin);
+
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, state.Query);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_BYTE, (void*)0);
+        JRenderStats::CountDraw(12);
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+
+        state.bIssued = true;
+        state.bPending = true;
+        ++Stats.IssuedQueries;
+    }
+
+    glBindVertexArray(0);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(depthMask);
+}
+
+// --------------------- Internal Helpers ---------------------
+void JOcclusionQueries::ReleaseAll()
+{
+    for (auto& [id, state] : States)
+        if (state.Query) glDeleteQueries(1, &state.Query);
+    States.clear();
+}
@@ -0,0 +1,122 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class JActor;
+class JShader;
+
+/// Per-frame counters of JOcclusionQueries.
+struct FOcclusionQueryStats
+{
+    int IssuedQueries = 0;    ///< Bounding-box queries issued this frame
+    int ResolvedQueries = 0;  ///< Results read back at the start of this frame
+    int PendingQueries = 0;   ///< Results not available yet (left in flight, never waited on)
+    int RejectedDraws = 0;    ///< Actors skipped on the CPU because they stayed hidden
+    int ConditionalDraws = 0; ///< Draws left to the GPU under conditional rendering
+};
+
+/**
+ * @class JOcclusionQueries
+ * @brief Hardware occlusion culling with GL_ANY_SAMPLES_PASSED queries on actor bounds.
+ *
+ * After the opaque pass, IssueQueries() rasterizes the world bounding box of every candidate
+ * actor against the scene depth (no color or depth writes) inside an occlusion query. Results
+ * are only read at the next BeginFrame(), and only if already available, so the CPU never
+ * waits on the GPU: a result arrives one (or more) frames late.
+ *
+ * Each actor then moves between three states, with hysteresis so that noisy results near
+ * silhouettes don't make it flicker:
+ * - Visible: a query passed recently. Drawn normally for VisibleHoldFrames frames.
+ * - Uncertain: no recent visible result. Drawn inside glBeginConditionalRender(GL_QUERY_NO_WAIT)
+ *   on its last query, so the GPU skips it if that query saw no samples and draws it otherwise.
+ * - Hidden: HiddenFramesToCull consecutive hidden results. Not submitted at all, only queried.
+ *
+ * Actors drawn through hardware instancing can't be conditionally rendered individually, they
+ * only benefit from the Hidden state.
+ */
+class JOcclusionQueries {
+public:
+    enum class EState : uint8_t { Visible, Uncertain, Hidden };
+
+    /// Frames an actor keeps being drawn unconditionally after a visible result.
+    static constexpr int VisibleHoldFrames = 4;
+
+    /// Consecutive hidden results before an actor is skipped on the CPU.
+    static constexpr int HiddenFramesToCull = 3;
+
+    JOcclusionQueries();
+    ~JOcclusionQueries();
+
+    JOcclusionQueries(const JOcclusionQueries&) = delete;
+    JOcclusionQueries& operator=(const JOcclusionQueries&) = delete;
+
+    /** @brief Collect the results that became available since last frame. Called by JRenderer::BeginScene(). */
+    void BeginFrame();
+
+    /** @brief Release queries of actors that were not candidates this frame. Called by JRenderer::EndScene(). */
+    void EndFrame();
+
+    /// Current state of an actor. Unknown actors are Visible.
+    EState GetState(const JActor& actor) const;
+
+    /**
+     * @brief Decide whether an actor should be submitted this frame. Counts CPU rejections.
+     * @return false if the actor is Hidden.
+     */
+    bool ShouldSubmit(const JActor& actor);
+
+    /**
+     * @brief Wrap the actor's following draws in conditional rendering if its state is Uncertain.
+     * @return true if conditional rendering was started; pair with EndConditionalDraw().
+     */
+    bool BeginConditionalDraw(const JActor& actor);
+    void EndConditionalDraw();
+
+    /**
+     * @brief Issue bounding-box queries for the given actors against the current depth buffer.
+     *
+     * Must run after the opaque geometry with the CameraData uniform block bound. Actors whose
+     * previous query is still in flight are skipped, as are actors whose box contains the camera.
+     *
+     * @param actors Query candidates (typically the frustum-visible opaque actors, hidden ones included).
+     * @param cameraPosition World-space camera position.
+     */
+    void IssueQueries(const std::vector<const JActor*>& actors, const glm::vec3& cameraPosition);
+
+    inline const FOcclusionQueryStats& GetStats() const { return Stats; }
+
+    /// When disabled every actor reports Visible and no queries are issued.
+    void SetEnabled(bool bEnable);
+    inline bool IsEnabled() const { return bEnabled; }
+
+private:
+    struct FQueryState
+    {
+        GLuint Query = 0;
+        bool bIssued = false;  ///< Query has been used at least once (required for conditional rendering)
+        bool bPending = false; ///< Result not read back yet
+        int VisibleHold = VisibleHoldFrames;
+        int HiddenStreak = 0;
+        uint64_t LastFrame = 0;
+    };
+
+    bool bEnabled = true;
+    uint64_t Frame = 0;
+    FOcclusionQueryStats Stats;
+
+    std::unordered_map<uint64_t, FQueryState> States; ///< By JActor::m_InstanceID, actors move in their vector
+
+    std::unique_ptr<JShader> BoxShader;
+    GLuint BoxVAO = 0;
+    GLuint BoxVBO = 0;
+    GLuint BoxEBO = 0;
+
+    void ReleaseAll();
+};
@@ -0,0 +1,134 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JOutlineRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glad/gl.h>
+#include "JFramebufferTarget.h"
+#include "JPostProcessor.h"
+
+namespace
+{
+    /// Resolution of the jump-flood targets relative to the scene.
+    constexpr float kFloodScale = 0.5f;
+}
+
+JOutlineRenderer::JOutlineRenderer(int width, int height)
+    : ScreenWidth(width), ScreenHeight(height)
+{
+    MaskPass = std::make_unique<JPostProcessor>("PostProcess", "Outline/OutlineMask");
+    SeedPass = std::make_unique<JPostProcessor>("PostProcess", "Outline/JumpFloodSeed");
+    FloodPass = std::make_unique<JPostProcessor>("PostProcess", "Outline/JumpFlood");
+    CompositePass = std::make_unique<JPostProcessor>("PostProcess", "Outline/OutlineComposite");
+    CompositePass->GetShader().Use();
+    CompositePass->GetShader().SetInt("seedTexture", 1);
+
+    CreateTargets();
+}
+
+JOutlineRenderer::~JOutlineRenderer() = default;
+
+void JOutlineRenderer::BeginMark()
+{
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_ALWAYS, StencilRef, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE); // tag where the actor passes the depth test
+    glStencilMask(0xFF);
+    ++MarkedDraws;
+}
+
+void JOutlineRenderer::EndMark()
+{
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glDisable(GL_STENCIL_TEST);
+}
+
+void JOutlineRenderer::Apply(JFramebufferTarget& sceneTarget)
+{
+    FloodPasses = 0;
+    const int markedDraws = MarkedDraws;
+    MarkedDraws = 0; // Marks are per frame, even when this one draws nothing
+    if (markedDraws == 0 || Width <= 0.f) return;
+
+    // Stencil can't be sampled in GL 3.3, so turn the tagged pixels into a mask texture
+    sceneTarget.BlitDepthTo(*MaskTarget);
+    MaskTarget->Bind();
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_EQUAL, StencilRef, 0xFF);
+    glStencilMask(0x00);
+    glDisable(GL_BLEND);
+    MaskPass->Apply(0, MaskTarget->GetWidth(), MaskTarget->GetHeight());
+    glStencilMask(0xFF);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glDisable(GL_STENCIL_TEST);
+
+    // Seed: every reduced-resolution texel touching the mask stores its own position
+    const int floodWidth = FloodTargets[0]->GetWidth();
+    const int floodHeight = FloodTargets[0]->GetHeight();
+    FloodTargets[0]->Bind();
+    SeedPass->Apply(MaskTarget->GetTexture(), floodWidth, floodHeight);
+
+    // Only distances up to the outline width matter, so start at the power of two above it
+    const int maxDistance = std::max(1, static_cast<int>(std::ceil(Width * kFloodScale)));
+    int step = 1;
+    while (step < maxDistance) step <<= 1;
+
+    int source = 0;
+    for (; step >= 1; step >>= 1)
+    {
+        FloodTargets[1 - source]->Bind();
+        FloodPass->GetShader().Use();
+        FloodPass->GetShader().SetInt("u_Step", step);
+        FloodPass->Apply(FloodTargets[source]->GetTexture(), floodWidth, floodHeight);
+        source = 1 - source;
+        ++FloodPasses;
+    }
+
+    // Composite over the scene
+    sceneTarget.Bind();
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    JShader& composite = CompositePass->GetShader();
+    composite.Use();
+    composite.SetFloat("u_Scale", kFloodScale);
+    composite.SetFloat("u_Width", Width);
+    composite.SetVec3("u_Color", Color);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, FloodTargets[source]->GetTexture());
+    glActiveTexture(GL_TEXTURE0);
+
+    CompositePass->Apply(MaskTarget->GetTexture(), sceneTarget.GetWidth(), sceneTarget.GetHeight());
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void JOutlineRenderer::Resize(int newWidth, int newHeight)
+{
+    if (newWidth == ScreenWidth && newHeight == ScreenHeight) return;
+
+    ScreenWidth = newWidth;
+    ScreenHeight = newHeight;
+    CreateTargets();
+}
+
+// --------------------- Internal Helpers ---------------------
+void JOutlineRenderer::CreateTargets()
+{
+    const int floodWidth = std::max(1, static_cast<int>(ScreenWidth * kFloodScale));
+    const int floodHeight = std::max(1, static_cast<int>(ScreenHeight * kFloodScale));
+
+    MaskTarget = std::make_unique<JFramebufferTarget>(ScreenWidth, ScreenHeight,
+        std::vector<EColorFormat>{ EColorFormat::R8 }, 1);
+    for (auto& target : FloodTargets)
+        target = std::make_unique<JFramebufferTarget>(floodWidth, floodHeight,
+            std::vector<EColorFormat>{ EColorFormat::RG16F }, 1);
+}
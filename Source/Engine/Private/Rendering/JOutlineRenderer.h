@@ -0,0 +1,92 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+
+class JFramebufferTarget;
+class JPostProcessor;
+
+/**
+ * @class JOutlineRenderer
+ * @brief Screen-space outlines built with a jump-flood distance pass.
+ *
+ * Outlined actors are drawn once, in their normal pass, between BeginMark() and EndMark(),
+ * which only tags their pixels in the scene's stencil buffer. Apply() then:
+ * 1. copies the scene depth-stencil into a single-sample mask target and turns the tagged
+ *    stencil into a mask texture with one fullscreen quad,
+ * 2. seeds a reduced-resolution jump-flood target with the mask,
+ * 3. runs log2(width) jump-flood passes so every texel knows its nearest mask texel,
+ * 4. composites the pixels within the outline width over the scene target.
+ *
+ * Geometry is never drawn more than once and the width is in pixels, independent of the mesh
+ * normals and of the actor's distance.
+ *
+ * Typical usage:
+ * @code
+ * Outlines.BeginMark();
+ * actor.DrawConfig(shader, outlineShader, false);
+ * Outlines.EndMark();
+ * ...
+ * Outlines.Apply(sceneTarget);
+ * @endcode
+ */
+class JOutlineRenderer {
+public:
+    /// Stencil value written on outlined pixels.
+    static constexpr int StencilRef = 1;
+
+    JOutlineRenderer(int width, int height);
+    ~JOutlineRenderer();
+
+    JOutlineRenderer(const JOutlineRenderer&) = delete;
+    JOutlineRenderer& operator=(const JOutlineRenderer&) = delete;
+
+    /** @brief Tag the pixels of the following draws in the stencil buffer. */
+    void BeginMark();
+
+    /** @brief Stop tagging and restore the default stencil state. */
+    void EndMark();
+
+    /**
+     * @brief Build and draw the outlines of everything marked since the last Apply().
+     * @param sceneTarget Target the marked actors were drawn into. Left bound on return.
+     *
+     * Does nothing when no actor was marked.
+     */
+    void Apply(JFramebufferTarget& sceneTarget);
+
+    /** @brief Resize the internal targets to the scene size. */
+    void Resize(int newWidth, int newHeight);
+
+    /// Outline width in pixels of the scene target.
+    inline void SetWidth(float pixels) { Width = pixels; }
+    inline float GetWidth() const { return Width; }
+
+    inline void SetColor(const glm::vec3& color) { Color = color; }
+    inline const glm::vec3& GetColor() const { return Color; }
+
+    /// Number of jump-flood passes run by the last Apply(), 0 if it was skipped.
+    inline int GetFloodPassCount() const { return FloodPasses; }
+
+private:
+    int ScreenWidth;
+    int ScreenHeight;
+
+    float Width = 3.f;
+    glm::vec3 Color = glm::vec3(0.f);
+
+    int MarkedDraws = 0; ///< Draws tagged since the last Apply()
+    int FloodPasses = 0;
+
+    std::unique_ptr<JFramebufferTarget> MaskTarget;      ///< Full resolution, R8 mask + depth-stencil copy
+    std::unique_ptr<JFramebufferTarget> FloodTargets[2]; ///< Reduced resolution ping-pong of seed coordinates
+
+    std::unique_ptr<JPostProcessor> MaskPass;
+    std::unique_ptr<JPostProcessor> SeedPass;
+    std::unique_ptr<JPostProcessor> FloodPass;
+    std::unique_ptr<JPostProcessor> CompositePass;
+
+    void CreateTargets();
+};
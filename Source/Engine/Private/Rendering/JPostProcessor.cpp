@@ -4,6 +4,34 @@
 
 #include <glad/gl.h>
 #include <iostream>
+#include "JRenderStats.h"
+
+namespace
+{
+    /// Built-in effects bound by fill rate that hold up at half resolution with an edge-aware upsample.
+    const char* const kReducedResolutionEffects[] = {
+        "PostProcess/RadialBlur", "PostProcess/WavyDistortion", "PostProcess/EdgeDetection"
+    };
+
+    /// Built-in effects written to be fused (see the PP_FUSED guard in their shaders).
+    const struct { const char* Path; EPostEffectKind Kind; } kFusableEffects[] = {
+        { "PostProcess/Grayscale",     EPostEffectKind::PointWise },
+        { "PostProcess/ColorInverter", EPostEffectKind::PointWise },
+        { "PostProcess/Posterize",     EPostEffectKind::PointWise },
+        { "PostProcess/GrainNoise",    EPostEffectKind::PointWise },
+        { "PostProcess/CRTScanline",   EPostEffectKind::PointWise },
+        { "PostProcess/Chroma",        EPostEffectKind::Sampling  },
+    };
+
+    EPostEffectKind GetDefaultKind(const std::string& fragmentPath)
+    {
+        if (fragmentPath == "PostProcessNoEffect") return EPostEffectKind::Passthrough;
+        for (const auto& effect : kFusableEffects) {
+            if (fragmentPath == effect.Path) return effect.Kind;
+        }
+        return EPostEffectKind::Pass;
+    }
+}
 
 // ----------------- JScreenQuad Implementation -----------------
 JPostProcessor::JScreenQuad::JScreenQuad() {
@@ -46,19 +74,37 @@ JPostProcessor::JScreenQuad::~JScreenQuad() {
 void JPostProcessor::JScreenQuad::Draw() const {
     glBindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
+    JRenderStats::CountDraw(2);
     glBindVertexArray(0);
 }
 
 // ----------------- JPostProcessor Implementation -----------------
 JPostProcessor::JPostProcessor(const std::string& vertexPath, const std::string& fragmentPath)
-    : ScreenQuad(), PostShader(vertexPath, fragmentPath)
+    : JPostProcessor(vertexPath, fragmentPath, GetDefaultKind(fragmentPath))
+{
+}
+
+JPostProcessor::JPostProcessor(const std::string& vertexPath, const std::string& fragmentPath, EPostEffectKind kind)
+    : JPostProcessor(std::make_unique<JShader>(vertexPath, fragmentPath))
+{
+    FragmentPath = fragmentPath;
+    Kind = kind;
+    for (const char* effect : kReducedResolutionEffects) {
+        if (fragmentPath == effect) Resolution = EPostResolution::Half;
+    }
+}
+
+JPostProcessor::JPostProcessor(std::unique_ptr<JShader> shader)
+    : ScreenQuad(), PostShader(std::move(shader))
 {
     // Ensure the shader has the expected sampler uniform (optional sanity check).
     // You can optionally set a default texture unit here:
-    PostShader.Use();
-    PostShader.SetInt("screenTexture", 0);
+    PostShader->Use();
+    PostShader->SetInt("screenTexture", 0);
 }
 
+JPostProcessor::~JPostProcessor() = default;
+
 void JPostProcessor::Apply(unsigned int inputTexture, int screenWidth, int screenHeight) {
     // Render a fullscreen quad that samples from inputTexture using PostShader.
     // The caller is responsible for binding an output framebuffer (if any).
@@ -68,12 +114,13 @@ void JPostProcessor::Apply(unsigned int inputTexture, int screenWidth, int scree
     // Disable depth test for screen-space quad rendering
     glDisable(GL_DEPTH_TEST);
 
-    PostShader.Use();
+    PostShader->Use();
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, inputTexture);
+    JRenderStats::CountTextureBind();
     // The constructor already set the uniform to 0, but set again in case users changed it.
-    PostShader.SetInt("screenTexture", 0);
+    PostShader->SetInt("screenTexture", 0);
 
     ScreenQuad.Draw();
 
@@ -82,6 +129,18 @@ void JPostProcessor::Apply(unsigned int inputTexture, int screenWidth, int scree
     glEnable(GL_DEPTH_TEST);
 }
 
+void JPostProcessor::AddPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output) {
+    graph.AddPass(GetFunctionName(), [this, input, output](const FRGContext& ctx) {
+        const FRGTextureDesc& desc = ctx.GetDesc(output);
+        Apply(ctx.GetTexture(input), desc.Width, desc.Height);
+    }).Read(input).Write(output);
+}
+
 JShader& JPostProcessor::GetShader() {
-    return PostShader;
+    return *PostShader;
+}
+
+std::string JPostProcessor::GetFunctionName() const {
+    const size_t slash = FragmentPath.find_last_of('/');
+    return slash == std::string::npos ? FragmentPath : FragmentPath.substr(slash + 1);
 }
@@ -2,25 +2,73 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include "JRenderGraph.h"
 #include "JShader.h"
 
+/// How an effect can be merged with its neighbours by PostProcessManager.
+enum class EPostEffectKind : uint8_t
+{
+    Pass,        ///< Arbitrary shader, always its own fullscreen pass
+    Passthrough, ///< Copies its input, dropped from chains
+    PointWise,   ///< vec3 Name(vec3 color, vec2 uv): depends on the pixel's own color only
+    Sampling,    ///< vec3 Name(vec2 uv): reads its input through PP_Input(uv), at most one per fused pass
+    MultiPass    ///< Declares its own render graph passes in AddPasses() (e.g. JBlurProcessor)
+};
+
+/// Resolution an effect runs at, relative to PostProcessManager's targets (value is the divisor).
+enum class EPostResolution : uint8_t
+{
+    Full = 1,
+    Half = 2,   ///< A quarter of the pixels
+    Quarter = 4 ///< A sixteenth of the pixels
+};
+
 /**
  * @class JPostProcessor
  * @brief Runs a single post-processing effect (shader) on a fullscreen quad.
  *
  * Each post-processor draws a fullscreen quad with its shader, taking a
  * texture input (usually the output of a render target or a previous pass).
+ *
+ * Fusable effects (EPostEffectKind::PointWise and Sampling) implement their effect as a
+ * function named after the shader file (e.g. "PostProcess/Posterize" -> Posterize()) and
+ * guard their declarations and main() with #ifndef PP_FUSED, so the same file compiles on
+ * its own and can be pasted into a generated uber-shader (see PostProcessManager).
+ * Uniform names of fusable effects must be unique across effects, and must be set through the
+ * JShader setters so a fused pass notices the change. The built-in fusable effects (Grayscale,
+ * ColorInverter, Posterize, GrainNoise, CRTScanline, Chroma) get their kind from their path.
+ *
+ * Effects that don't need every pixel can run at a reduced resolution (SetResolution()),
+ * PostProcessManager brings them back up with an edge-aware upsample. The effects known to
+ * be expensive and smooth (RadialBlur, WavyDistortion, EdgeDetection) default to Half.
  */
 class JPostProcessor {
 public:
     /**
      * @brief Construct a post-processor with a given shader program.
      * @param vertexPath Path to vertex shader source.
-     * @param fragmentPath Path to fragment shader source.
+     * @param fragmentPath Path to fragment shader source, built-in effects get their kind from it.
      */
     JPostProcessor(const std::string& vertexPath = "PostProcess", const std::string& fragmentPath
         = "PostProcessNoEffect");
 
+    /**
+     * @brief Construct an effect with an explicit kind, overriding the one derived from its path.
+     * @param vertexPath Path to vertex shader source.
+     * @param fragmentPath Path to fragment shader source, its file name is the effect's function name.
+     * @param kind How the effect reads its input.
+     */
+    JPostProcessor(const std::string& vertexPath, const std::string& fragmentPath, EPostEffectKind kind);
+
+    /**
+     * @brief Wrap an already built shader, e.g. a generated uber-shader.
+     * @param shader Program reading its input from the "screenTexture" sampler.
+     */
+    explicit JPostProcessor(std::unique_ptr<JShader> shader);
+    virtual ~JPostProcessor();
+
     /**
      * @brief Apply the post-processing effect to the given texture.
      * @param inputTexture The OpenGL texture ID to process.
@@ -31,9 +79,38 @@ public:
      */
     void Apply(unsigned int inputTexture, int screenWidth, int screenHeight);
 
+    /**
+     * @brief Declare the render graph passes that take input to output.
+     * @param graph Graph being built this frame.
+     * @param input Texture to process.
+     * @param output Texture to write, its size is the effect's output size.
+     *
+     * The default is a single pass running Apply(). EPostEffectKind::MultiPass effects
+     * override it to run intermediate passes on their own transient textures.
+     */
+    virtual void AddPasses(JRenderGraph& graph, FRGTexture input, FRGTexture output);
+
     /** @return Reference to the shader for setting uniforms. */
     JShader& GetShader();
 
+    /** @brief Resolution to run at, set before the effect is added to a PostProcessManager. */
+    inline void SetResolution(EPostResolution resolution) { Resolution = resolution; }
+    inline EPostResolution GetResolution() const { return Resolution; }
+
+    inline EPostEffectKind GetKind() const { return Kind; }
+
+    /**
+     * @return Whether the effect currently leaves its input unchanged, PostProcessManager then drops it.
+     *
+     * EPostEffectKind::Passthrough effects always are. Parameterized effects override it (e.g. a blur
+     * of radius 0); the manager recompiles its chain when the answer changes.
+     */
+    virtual bool IsPassthrough() const { return Kind == EPostEffectKind::Passthrough; }
+    inline const std::string& GetFragmentPath() const { return FragmentPath; }
+
+    /// Name of the effect function of fusable effects (file name of the fragment shader).
+    std::string GetFunctionName() const;
+
 private:
     class JScreenQuad {
     public:
@@ -46,5 +123,8 @@ private:
     };
 
     JScreenQuad ScreenQuad;
-    JShader PostShader;
+    std::unique_ptr<JShader> PostShader;
+    std::string FragmentPath;
+    EPostEffectKind Kind = EPostEffectKind::Pass;
+    EPostResolution Resolution = EPostResolution::Full;
 };
@@ -0,0 +1,311 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JRenderGraph.h"
+
+#include "JGpuProfiler.h"
+
+#include <algorithm>
+#include <iostream>
+
+size_t FRGTextureDesc::GetSizeBytes() const
+{
+    return ToTargetDesc().GetSizeBytes();
+}
+
+// --------------------- FRGContext ---------------------
+GLuint FRGContext::GetTexture(FRGTexture texture) const
+{
+    for (const auto& resolved : Graph.Passes[Pass].ResolvedReads)
+    {
+        if (resolved.first == texture)
+        {
+            texture = resolved.second;
+            break;
+        }
+    }
+
+    const JRenderGraph::FTexture& entry = Graph.Textures[texture];
+    if (entry.Kind == JRenderGraph::ETextureKind::ImportedTexture) return entry.ExternalTexture;
+    return entry.Target ? entry.Target->GetTexture() : 0;
+}
+
+JFramebufferTarget* FRGContext::GetTarget(FRGTexture texture) const
+{
+    return Graph.Textures[texture].Target;
+}
+
+const FRGTextureDesc& FRGContext::GetDesc(FRGTexture texture) const
+{
+    return Graph.Textures[texture].Desc;
+}
+
+void FRGContext::BindTarget(FRGTexture texture) const
+{
+    const JRenderGraph::FTexture& entry = Graph.Textures[texture];
+    if (entry.Target)
+    {
+        entry.Target->Bind();
+        return;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, entry.Desc.Width, entry.Desc.Height);
+}
+
+// --------------------- FRGPassBuilder ---------------------
+FRGPassBuilder& FRGPassBuilder::Read(FRGTexture texture)
+{
+    Graph.Passes[Pass].Reads.push_back(texture);
+    return *this;
+}
+
+FRGPassBuilder& FRGPassBuilder::Write(FRGTexture texture)
+{
+    if (Graph.Textures[texture].Kind == JRenderGraph::ETextureKind::ImportedTexture)
+    {
+        std::cerr << "[JRenderGraph] Pass '" << Graph.Passes[Pass].Name << "' writes read-only texture '"
+                  << Graph.Textures[texture].Name << "'\n";
+        return *this;
+    }
+    Graph.Passes[Pass].Writes.push_back(texture);
+    return *this;
+}
+
+FRGPassBuilder& FRGPassBuilder::SetSideEffects()
+{
+    Graph.Passes[Pass].bSideEffects = true;
+    return *this;
+}
+
+// --------------------- JRenderGraph ---------------------
+JRenderGraph::JRenderGraph(JRenderTargetPool* pool)
+    : Pool(pool)
+{
+    if (!Pool)
+    {
+        OwnedPool = std::make_unique<JRenderTargetPool>();
+        Pool = OwnedPool.get();
+    }
+}
+
+JRenderGraph::~JRenderGraph() = default;
+
+void JRenderGraph::Reset()
+{
+    Textures.clear();
+    Passes.clear();
+    Steps.clear();
+    bCompiled = false;
+}
+
+FRGTexture JRenderGraph::CreateTexture(const std::string& name, const FRGTextureDesc& desc)
+{
+    FTexture texture;
+    texture.Name = name;
+    texture.Desc = desc;
+    Textures.push_back(std::move(texture));
+    return static_cast<FRGTexture>(Textures.size() - 1);
+}
+
+FRGTexture JRenderGraph::ImportTarget(const std::string& name, JFramebufferTarget& target)
+{
+    FTexture texture;
+    texture.Name = name;
+    texture.Desc = { target.GetWidth(), target.GetHeight(), target.GetFormat(), target.GetSamples() };
+    texture.Kind = ETextureKind::ImportedTarget;
+    texture.Target = &target;
+    Textures.push_back(std::move(texture));
+    return static_cast<FRGTexture>(Textures.size() - 1);
+}
+
+FRGTexture JRenderGraph::ImportTexture(const std::string& name, GLuint glTexture, const FRGTextureDesc& desc)
+{
+    FTexture texture;
+    texture.Name = name;
+    texture.Desc = desc;
+    texture.Desc.Samples = 1; // no framebuffer to resolve from, see ImportTarget()
+    texture.Kind = ETextureKind::ImportedTexture;
+    texture.ExternalTexture = glTexture;
+    Textures.push_back(std::move(texture));
+    return static_cast<FRGTexture>(Textures.size() - 1);
+}
+
+FRGTexture JRenderGraph::ImportBackbuffer(int width, int height)
+{
+    FTexture texture;
+    texture.Name = "Backbuffer";
+    texture.Desc = { width, height, EColorFormat::RGBA8, 1 };
+    texture.Kind = ETextureKind::Backbuffer;
+    Textures.push_back(std::move(texture));
+    return static_cast<FRGTexture>(Textures.size() - 1);
+}
+
+FRGPassBuilder JRenderGraph::AddPass(const std::string& name, FExecute execute)
+{
+    FPass pass;
+    pass.Name = name;
+    pass.Execute = std::move(execute);
+    Passes.push_back(std::move(pass));
+    return FRGPassBuilder(*this, static_cast<uint32_t>(Passes.size() - 1));
+}
+
+void JRenderGraph::Compile()
+{
+    if (OwnedPool) OwnedPool->BeginFrame();
+    Stats = FRenderGraphStats();
+    Stats.Passes = static_cast<int>(Passes.size());
+
+    CullPasses();
+    ScheduleSteps();
+    AllocateTargets();
+    Stats.PooledBytes = Pool->GetStats().Bytes;
+
+    bCompiled = true;
+}
+
+void JRenderGraph::Execute()
+{
+    if (!bCompiled) Compile();
+
+    for (const FStep& step : Steps)
+    {
+        if (step.Pass < 0)
+        {
+            const JGpuScope scope(Profiler, "MSAA Resolve");
+            Textures[step.Source].Target->ResolveTo(*Textures[step.Destination].Target);
+            continue;
+        }
+
+        const FPass& pass = Passes[step.Pass];
+        const JGpuScope scope(Profiler, pass.Name.c_str());
+        const FRGContext context(*this, static_cast<uint32_t>(step.Pass));
+        if (!pass.Writes.empty())
+            context.BindTarget(pass.Writes.front());
+        pass.Execute(context);
+    }
+}
+
+// --------------------- Compilation ---------------------
+void JRenderGraph::CullPasses()
+{
+    std::vector<bool> needed(Textures.size(), false);
+
+    for (size_t i = Passes.size(); i-- > 0;)
+    {
+        FPass& pass = Passes[i];
+        pass.bLive = pass.bSideEffects;
+        for (FRGTexture write : pass.Writes)
+            pass.bLive = pass.bLive || IsImported(write) || needed[write];
+
+        if (!pass.bLive)
+        {
+            ++Stats.CulledPasses;
+            continue;
+        }
+        for (FRGTexture read : pass.Reads)
+            needed[read] = true;
+    }
+}
+
+void JRenderGraph::ScheduleSteps()
+{
+    Steps.clear();
+
+    // Resolved copy of each multi-sampled texture, valid until the texture is written again
+    std::vector<FRGTexture> resolvedCopy(Textures.size(), InvalidRGTexture);
+
+    for (size_t i = 0; i < Passes.size(); ++i)
+    {
+        if (!Passes[i].bLive) continue;
+
+        Passes[i].ResolvedReads.clear();
+        for (size_t r = 0; r < Passes[i].Reads.size(); ++r)
+        {
+            const FRGTexture read = Passes[i].Reads[r];
+            if (Textures[read].Desc.Samples <= 1) continue;
+
+            if (resolvedCopy[read] == InvalidRGTexture)
+            {
+                FRGTextureDesc desc = Textures[read].Desc;
+                desc.Samples = 1;
+                const FRGTexture copy = CreateTexture(Textures[read].Name + " (Resolved)", desc);
+                resolvedCopy.resize(Textures.size(), InvalidRGTexture);
+                resolvedCopy[read] = copy;
+
+                FStep resolve;
+                resolve.Source = read;
+                resolve.Destination = copy;
+                Steps.push_back(resolve);
+                ++Stats.Resolves;
+            }
+            Passes[i].ResolvedReads.emplace_back(read, resolvedCopy[read]);
+        }
+
+        FStep step;
+        step.Pass = static_cast<int>(i);
+        Steps.push_back(step);
+
+        for (FRGTexture write : Passes[i].Writes)
+            resolvedCopy[write] = InvalidRGTexture;
+    }
+}
+
+void JRenderGraph::AllocateTargets()
+{
+    auto touch = [this](FRGTexture texture, int step)
+    {
+        FTexture& entry = Textures[texture];
+        if (entry.FirstStep < 0) entry.FirstStep = step;
+        entry.LastStep = step;
+    };
+
+    for (size_t s = 0; s < Steps.size(); ++s)
+    {
+        const FStep& step = Steps[s];
+        const int index = static_cast<int>(s);
+        if (step.Pass < 0)
+        {
+            touch(step.Source, index);
+            touch(step.Destination, index);
+            continue;
+        }
+        for (FRGTexture read : Passes[step.Pass].Reads) touch(read, index);
+        for (const auto& resolved : Passes[step.Pass].ResolvedReads) touch(resolved.second, index);
+        for (FRGTexture write : Passes[step.Pass].Writes) touch(write, index);
+    }
+
+    // Lifetimes starting and ending at each step
+    std::vector<std::vector<FRGTexture>> starts(Steps.size());
+    std::vector<std::vector<FRGTexture>> ends(Steps.size());
+    for (size_t t = 0; t < Textures.size(); ++t)
+    {
+        const FTexture& entry = Textures[t];
+        if (entry.Kind != ETextureKind::Transient || entry.FirstStep < 0) continue;
+
+        starts[entry.FirstStep].push_back(static_cast<FRGTexture>(t));
+        ends[entry.LastStep].push_back(static_cast<FRGTexture>(t));
+        ++Stats.TransientTextures;
+        Stats.TransientBytes += entry.Desc.GetSizeBytes();
+    }
+
+    // Acquire before releasing, a pass never reads and writes the same memory
+    std::vector<const JFramebufferTarget*> physical;
+    for (size_t s = 0; s < Steps.size(); ++s)
+    {
+        for (FRGTexture texture : starts[s])
+        {
+            JFramebufferTarget* target = Pool->Acquire(Textures[texture].Desc.ToTargetDesc());
+            Textures[texture].Target = target;
+            if (std::find(physical.begin(), physical.end(), target) == physical.end())
+                physical.push_back(target);
+        }
+        for (FRGTexture texture : ends[s])
+            Pool->Release(Textures[texture].Target);
+    }
+    Stats.PhysicalTargets = static_cast<int>(physical.size());
+}
+
+bool JRenderGraph::IsImported(FRGTexture texture) const
+{
+    return Textures[texture].Kind != ETextureKind::Transient;
+}
@@ -0,0 +1,235 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "JFramebufferTarget.h"
+#include "JRenderTargetPool.h"
+
+class JGpuProfiler;
+class JRenderGraph;
+
+/// Handle of a texture declared in a JRenderGraph, valid until the next Reset().
+using FRGTexture = uint32_t;
+constexpr FRGTexture InvalidRGTexture = ~static_cast<FRGTexture>(0);
+
+/// Size and format of a graph texture. Transient textures with equal descriptions can share memory.
+struct FRGTextureDesc
+{
+    int Width = 0;
+    int Height = 0;
+    EColorFormat Format = EColorFormat::RGB8;
+    int Samples = 1;
+
+    bool operator==(const FRGTextureDesc& other) const
+    {
+        return Width == other.Width && Height == other.Height && Format == other.Format && Samples == other.Samples;
+    }
+    bool operator!=(const FRGTextureDesc& other) const { return !(*this == other); }
+
+    /// Approximate GPU memory of a target with this description, depth-stencil included.
+    size_t GetSizeBytes() const;
+
+    /// Pool description of the target backing a texture with this description.
+    FRenderTargetDesc ToTargetDesc() const { return { Width, Height, { Format }, Samples }; }
+};
+
+/// Counters of the last JRenderGraph::Compile().
+struct FRenderGraphStats
+{
+    int Passes = 0;            ///< Passes declared
+    int CulledPasses = 0;      ///< Passes whose results nobody reads
+    int Resolves = 0;          ///< MSAA resolves inserted before multi-sampled reads
+    int TransientTextures = 0; ///< Transient textures used this frame, resolve targets included
+    int PhysicalTargets = 0;   ///< Pooled targets they were aliased onto
+    size_t TransientBytes = 0; ///< Memory the transient textures would take without aliasing
+    size_t PooledBytes = 0;    ///< Memory of every target held by the pool, other users' included
+};
+
+/// Resolves graph textures to GL objects while a pass executes.
+class FRGContext {
+public:
+    /// Color texture of a graph texture, the resolved copy when the pass reads a multi-sampled one.
+    GLuint GetTexture(FRGTexture texture) const;
+
+    /// Framebuffer target behind a graph texture, null for the backbuffer and imported textures.
+    JFramebufferTarget* GetTarget(FRGTexture texture) const;
+
+    const FRGTextureDesc& GetDesc(FRGTexture texture) const;
+
+    /// Bind a written texture's framebuffer (0 for the backbuffer) and set the viewport to its size.
+    void BindTarget(FRGTexture texture) const;
+
+private:
+    friend class JRenderGraph;
+    FRGContext(const JRenderGraph& graph, uint32_t pass) : Graph(graph), Pass(pass) {}
+
+    const JRenderGraph& Graph;
+    uint32_t Pass;
+};
+
+/// Declares what a pass reads and writes, returned by JRenderGraph::AddPass().
+class FRGPassBuilder {
+public:
+    FRGPassBuilder& Read(FRGTexture texture);
+    FRGPassBuilder& Write(FRGTexture texture);
+
+    /// Keep the pass even if nothing reads its output (e.g. it has effects outside the graph).
+    FRGPassBuilder& SetSideEffects();
+
+private:
+    friend class JRenderGraph;
+    FRGPassBuilder(JRenderGraph& graph, uint32_t pass) : Graph(graph), Pass(pass) {}
+
+    JRenderGraph& Graph;
+    uint32_t Pass;
+};
+
+/**
+ * @class JRenderGraph
+ * @brief Frame graph of render passes with transient render targets aliased onto pooled memory.
+ *
+ * Every frame the graph is rebuilt: Reset(), declare textures and passes, Compile(), Execute().
+ * Passes declare the textures they read and write, and the graph takes care of the targets:
+ * - Passes whose writes nobody reads are culled, unless they write an imported texture, the
+ *   backbuffer, or were marked with SetSideEffects().
+ * - Reading a multi-sampled texture inserts a resolve into a single-sample transient before
+ *   the reading pass, once per write, so passes never deal with MSAA.
+ * - Transient textures only exist between their first and last use. Targets are taken from a
+ *   JRenderTargetPool when a lifetime starts and handed back when it ends, so textures whose
+ *   lifetimes don't overlap share the same target. A ping-pong chain of any length needs two.
+ * - The pool survives Reset(), so a stable graph allocates nothing after its first frame.
+ *   Targets unused for JRenderTargetPool::RetainFrames frames (e.g. after a resize) are released.
+ *   The pool can be shared with other users (see JRenderer::GetTargetPool()), whoever owns it
+ *   advances its frames; a graph without one owns a private pool and advances it in Compile().
+ *
+ * Passes run in declaration order. Before a pass executes, the graph binds the framebuffer of
+ * its first written texture; the pass clears it itself if needed. With a JGpuProfiler set, each
+ * pass and each inserted resolve ("MSAA Resolve") is timed under its name.
+ *
+ * Typical usage:
+ * @code
+ * Graph.Reset();
+ * FRGTexture scene = Graph.ImportTarget("Scene", sceneTarget);
+ * FRGTexture blurred = Graph.CreateTexture("Blurred", { width, height, EColorFormat::RGB8 });
+ * Graph.AddPass("Blur", [=](const FRGContext& ctx) { Blur.Apply(ctx.GetTexture(scene), width, height); })
+ *     .Read(scene).Write(blurred);
+ * Graph.AddPass("Present", [=](const FRGContext& ctx) { Copy.Apply(ctx.GetTexture(blurred), width, height); })
+ *     .Read(blurred).Write(Graph.ImportBackbuffer(width, height));
+ * Graph.Compile();
+ * Graph.Execute();
+ * @endcode
+ */
+class JRenderGraph {
+public:
+    using FExecute = std::function<void(const FRGContext&)>;
+
+    /**
+     * @param pool Pool to take transient targets from, must outlive the graph. Null creates a
+     *        private pool.
+     */
+    explicit JRenderGraph(JRenderTargetPool* pool = nullptr);
+    ~JRenderGraph();
+
+    JRenderGraph(const JRenderGraph&) = delete;
+    JRenderGraph& operator=(const JRenderGraph&) = delete;
+
+    /** @brief Forget last frame's passes and textures, pooled targets are kept. */
+    void Reset();
+
+    /** @brief Declare a transient texture, backed by pooled memory during its lifetime only. */
+    FRGTexture CreateTexture(const std::string& name, const FRGTextureDesc& desc);
+
+    /** @brief Use a target owned outside the graph. Writing it keeps the writer alive. */
+    FRGTexture ImportTarget(const std::string& name, JFramebufferTarget& target);
+
+    /** @brief Use a single-sample texture owned outside the graph, read-only. */
+    FRGTexture ImportTexture(const std::string& name, GLuint texture, const FRGTextureDesc& desc);
+
+    /** @brief The default framebuffer. */
+    FRGTexture ImportBackbuffer(int width, int height);
+
+    /**
+     * @brief Add a pass. Declare its reads and writes on the returned builder.
+     * @param name Debug name.
+     * @param execute Called by Execute() with the pass' GL objects, if the pass survives culling.
+     */
+    FRGPassBuilder AddPass(const std::string& name, FExecute execute);
+
+    /** @brief Cull passes, insert resolves and assign pooled targets to transient textures. */
+    void Compile();
+
+    /** @brief Run the compiled passes in order. */
+    void Execute();
+
+    /// Description of a declared texture, e.g. to size intermediate textures after it.
+    inline const FRGTextureDesc& GetDesc(FRGTexture texture) const { return Textures[texture].Desc; }
+
+    inline const FRenderGraphStats& GetStats() const { return Stats; }
+
+    /** @brief Time every executed pass on profiler, null to stop. Must outlive the graph. */
+    inline void SetProfiler(JGpuProfiler* profiler) { Profiler = profiler; }
+
+private:
+    friend class FRGContext;
+    friend class FRGPassBuilder;
+
+    enum class ETextureKind : uint8_t { Transient, ImportedTarget, ImportedTexture, Backbuffer };
+
+    struct FTexture
+    {
+        std::string Name;
+        FRGTextureDesc Desc;
+        ETextureKind Kind = ETextureKind::Transient;
+        JFramebufferTarget* Target = nullptr; ///< Imported or assigned pooled target
+        GLuint ExternalTexture = 0;           ///< ImportedTexture only
+        int FirstStep = -1;                   ///< Lifetime in execution steps, transient only
+        int LastStep = -1;
+    };
+
+    struct FPass
+    {
+        std::string Name;
+        FExecute Execute;
+        std::vector<FRGTexture> Reads;
+        std::vector<FRGTexture> Writes;
+        std::vector<std::pair<FRGTexture, FRGTexture>> ResolvedReads; ///< Multi-sampled read -> resolved copy
+        bool bSideEffects = false;
+        bool bLive = false;
+    };
+
+    /// One entry of the compiled schedule: a pass, or a resolve of Source into Destination.
+    struct FStep
+    {
+        int Pass = -1;
+        FRGTexture Source = InvalidRGTexture;
+        FRGTexture Destination = InvalidRGTexture;
+    };
+
+    std::vector<FTexture> Textures;
+    std::vector<FPass> Passes;
+    std::vector<FStep> Steps;
+    std::unique_ptr<JRenderTargetPool> OwnedPool;
+    JRenderTargetPool* Pool;
+    JGpuProfiler* Profiler = nullptr;
+    bool bCompiled = false;
+
+    FRenderGraphStats Stats;
+
+    /// Mark passes that contribute to an output, walking back from the side-effect passes.
+    void CullPasses();
+
+    /// Build the execution order, inserting a resolve before each first multi-sampled read after a write.
+    void ScheduleSteps();
+
+    /// Assign pooled targets to transient textures along their lifetimes.
+    void AllocateTargets();
+
+    bool IsImported(FRGTexture texture) const;
+};
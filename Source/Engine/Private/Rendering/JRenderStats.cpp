@@ -0,0 +1,233 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JRenderStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace
+{
+    int64_t GetSteadyNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void WriteCsvString(std::ostream& out, const std::string& text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            if (c == '"') out << '"';
+            out << c;
+        }
+        out << '"';
+    }
+
+    void WriteCsvCounters(std::ostream& out, const FRenderCounters& counters)
+    {
+        out << ',' << counters.DrawCalls << ',' << counters.Instances << ',' << counters.Triangles
+            << ',' << counters.ProgramBinds << ',' << counters.UniformSets << ',' << counters.TextureBinds
+            << ',' << counters.FramebufferBinds << ',' << counters.UploadBytes << '\n';
+    }
+}
+
+FRenderCounters& FRenderCounters::operator+=(const FRenderCounters& other)
+{
+    DrawCalls += other.DrawCalls;
+    Instances += other.Instances;
+    Triangles += other.Triangles;
+    ProgramBinds += other.ProgramBinds;
+    UniformSets += other.UniformSets;
+    TextureBinds += other.TextureBinds;
+    FramebufferBinds += other.FramebufferBinds;
+    UploadBytes += other.UploadBytes;
+    return *this;
+}
+
+FRenderCounters FRenderCounters::operator-(const FRenderCounters& other) const
+{
+    FRenderCounters result;
+    result.DrawCalls = DrawCalls - other.DrawCalls;
+    result.Instances = Instances - other.Instances;
+    result.Triangles = Triangles - other.Triangles;
+    result.ProgramBinds = ProgramBinds - other.ProgramBinds;
+    result.UniformSets = UniformSets - other.UniformSets;
+    result.TextureBinds = TextureBinds - other.TextureBinds;
+    result.FramebufferBinds = FramebufferBinds - other.FramebufferBinds;
+    result.UploadBytes = UploadBytes - other.UploadBytes;
+    return result;
+}
+
+FRenderCounters JRenderStats::Current;
+
+JRenderStats& JRenderStats::Get()
+{
+    static JRenderStats instance;
+    return instance;
+}
+
+JRenderStats::JRenderStats()
+{
+    History.reserve(HistorySize);
+}
+
+// --------------------- Frames ---------------------
+void JRenderStats::BeginFrame()
+{
+    while (!OpenPasses.empty())
+        EndPass();
+
+    const int64_t now = GetSteadyNanoseconds();
+    LastFrame.Counters = Current;
+    LastFrame.FrameMs = FrameBeginNanoseconds ? static_cast<float>(now - FrameBeginNanoseconds) * 1e-6f : 0.f;
+    FrameBeginNanoseconds = now;
+
+    if (History.size() < HistorySize)
+    {
+        History.push_back(LastFrame);
+    }
+    else
+    {
+        History[HistoryHead] = LastFrame;
+        HistoryHead = (HistoryHead + 1) % HistorySize;
+    }
+
+    for (size_t i = 0; i < Passes.size(); ++i)
+    {
+        FRenderPassStats& pass = Passes[i];
+        pass.bRanLastFrame = PassSeen[i];
+        pass.Last = PassSeen[i] ? PassFrame[i] : FRenderCounters();
+        pass.PeakDrawCalls = std::max(pass.PeakDrawCalls, pass.Last.DrawCalls);
+    }
+
+    if (CsvFile.is_open()) WriteCsvFrame();
+
+    Current = FRenderCounters();
+    std::fill(PassFrame.begin(), PassFrame.end(), FRenderCounters());
+    std::fill(PassSeen.begin(), PassSeen.end(), false);
+    ++FrameIndex;
+}
+
+void JRenderStats::BeginPass(const char* name)
+{
+    FOpenPass open;
+    open.Stats = FindOrAddPass(name);
+    open.Begin = Current;
+    OpenPasses.push_back(open);
+}
+
+void JRenderStats::EndPass()
+{
+    if (OpenPasses.empty()) return;
+    const FOpenPass open = OpenPasses.back();
+    OpenPasses.pop_back();
+
+    PassFrame[open.Stats] += Current - open.Begin;
+    PassSeen[open.Stats] = true;
+}
+
+std::vector<FRenderFrameStats> JRenderStats::GetHistory() const
+{
+    std::vector<FRenderFrameStats> ordered;
+    ordered.reserve(History.size());
+    for (size_t i = 0; i < History.size(); ++i)
+        ordered.push_back(History[(HistoryHead + i) % History.size()]);
+    return ordered;
+}
+
+FRenderFrameStats JRenderStats::GetAverage() const
+{
+    FRenderFrameStats average;
+    if (History.empty()) return average;
+
+    double frameMs = 0.0;
+    for (const FRenderFrameStats& frame : History)
+    {
+        average.Counters += frame.Counters;
+        frameMs += frame.FrameMs;
+    }
+
+    const uint64_t count = History.size();
+    FRenderCounters& sum = average.Counters;
+    sum.DrawCalls /= count;
+    sum.Instances /= count;
+    sum.Triangles /= count;
+    sum.ProgramBinds /= count;
+    sum.UniformSets /= count;
+    sum.TextureBinds /= count;
+    sum.FramebufferBinds /= count;
+    sum.UploadBytes /= count;
+    average.FrameMs = static_cast<float>(frameMs / static_cast<double>(count));
+    return average;
+}
+
+int JRenderStats::FindOrAddPass(const char* name)
+{
+    for (size_t i = 0; i < Passes.size(); ++i)
+    {
+        if (std::strcmp(Passes[i].Name.c_str(), name) == 0) return static_cast<int>(i);
+    }
+
+    FRenderPassStats pass;
+    pass.Name = name;
+    pass.Depth = static_cast<int>(OpenPasses.size());
+    Passes.push_back(std::move(pass));
+    PassFrame.emplace_back();
+    PassSeen.push_back(false);
+    return static_cast<int>(Passes.size() - 1);
+}
+
+// --------------------- CSV ---------------------
+bool JRenderStats::StartCsv(const std::string& path, int frames)
+{
+    StopCsv();
+
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+    CsvFile.open(path, std::ios::trunc);
+    if (!CsvFile)
+    {
+        std::cerr << "[JRenderStats] Could not open '" << path << "' for writing." << std::endl;
+        return false;
+    }
+
+    CsvPath = path;
+    CsvFramesLeft = frames > 0 ? frames : -1;
+    CsvFile << "Frame,Pass,Depth,FrameMs,DrawCalls,Instances,Triangles,ProgramBinds,UniformSets,"
+               "TextureBinds,FramebufferBinds,UploadBytes\n";
+    return true;
+}
+
+void JRenderStats::StopCsv()
+{
+    if (!CsvFile.is_open()) return;
+
+    CsvFile.close();
+    std::cout << "[JRenderStats] Wrote " << CsvPath << std::endl;
+}
+
+void JRenderStats::WriteCsvFrame()
+{
+    // The frame total has depth -1, passes follow in order of first appearance
+    CsvFile << FrameIndex << ",Frame,-1," << LastFrame.FrameMs;
+    WriteCsvCounters(CsvFile, LastFrame.Counters);
+
+    for (const FRenderPassStats& pass : Passes)
+    {
+        if (!pass.bRanLastFrame) continue;
+
+        CsvFile << FrameIndex << ',';
+        WriteCsvString(CsvFile, pass.Name);
+        CsvFile << ',' << pass.Depth << ',';
+        WriteCsvCounters(CsvFile, pass.Last);
+    }
+
+    if (CsvFramesLeft > 0 && --CsvFramesLeft == 0)
+        StopCsv();
+}
@@ -0,0 +1,201 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Set to 0 to compile every counter out
+#ifndef J_ENABLE_RENDER_STATS
+#define J_ENABLE_RENDER_STATS 1
+#endif
+
+/// GL work issued by the engine, see JRenderStats.
+struct FRenderCounters
+{
+    uint64_t DrawCalls = 0;
+    uint64_t Instances = 0;        ///< Instances drawn, 1 per non-instanced draw
+    uint64_t Triangles = 0;        ///< Across every instance
+    uint64_t ProgramBinds = 0;
+    uint64_t UniformSets = 0;
+    uint64_t TextureBinds = 0;
+    uint64_t FramebufferBinds = 0; ///< Read, draw and both targets count one each
+    uint64_t UploadBytes = 0;      ///< Buffer and texture data sent from the CPU
+
+    FRenderCounters& operator+=(const FRenderCounters& other);
+    FRenderCounters operator-(const FRenderCounters& other) const;
+};
+
+/// Counters of one named pass.
+struct FRenderPassStats
+{
+    std::string Name;
+    int Depth = 0;            ///< Nesting level of the pass' first occurrence
+    FRenderCounters Last;     ///< Latest frame, every occurrence of the name summed
+    uint64_t PeakDrawCalls = 0;
+    bool bRanLastFrame = false;
+};
+
+/// Totals of one frame.
+struct FRenderFrameStats
+{
+    FRenderCounters Counters;
+    float FrameMs = 0.f;      ///< Wall time between the BeginFrame() calls around the frame
+};
+
+/**
+ * @class JRenderStats
+ * @brief Counts draw calls, binds, uniform sets and uploads where the GL calls are made.
+ *
+ * The wrappers issuing GL calls (JMesh::Draw, JShader::Use and Set*, JTexture::Bind,
+ * JFramebufferTarget::Bind...) bump the counters of the frame being recorded with the inline
+ * Count*() helpers, an increment each. GL is only driven from the main thread, so the counters
+ * are plain integers and must not be touched from jobs.
+ *
+ * Passes come from JGpuProfiler, which forwards BeginPass() and EndPass() here: a pass gets the
+ * difference of the counters between its ends, nested passes are included in their parent.
+ * Work outside any pass (shadows, editor) only shows in the frame totals.
+ *
+ * BeginFrame() closes the frame: its totals go to a ring of HistorySize frames, each pass
+ * keeps its latest frame, and a running CSV dump gets one row for the frame and one per pass.
+ *
+ * Typical usage:
+ * @code
+ * // ... at the GL call site
+ * JRenderStats::CountDraw(range.IndexCount / 3, instanceCount);
+ * // ... once per frame
+ * JRenderStats::Get().BeginFrame();
+ * // ... for a benchmark run
+ * JRenderStats::Get().StartCsv("Captures/RenderStats.csv", 600);
+ * @endcode
+ */
+class JRenderStats {
+public:
+    /// Frames kept in the history ring.
+    static constexpr int HistorySize = 240;
+
+    static JRenderStats& Get();
+
+    // --------------------- Counting ---------------------
+    static inline void CountDraw(uint64_t triangles, uint64_t instances = 1)
+    {
+#if J_ENABLE_RENDER_STATS
+        ++Current.DrawCalls;
+        Current.Instances += instances;
+        Current.Triangles += triangles * instances;
+#endif
+    }
+
+    /// One multi-draw call, triangles and instances already summed over its commands.
+    static inline void CountMultiDraw(uint64_t triangles, uint64_t instances)
+    {
+#if J_ENABLE_RENDER_STATS
+        ++Current.DrawCalls;
+        Current.Instances += instances;
+        Current.Triangles += triangles;
+#endif
+    }
+
+    static inline void CountProgramBind()
+    {
+#if J_ENABLE_RENDER_STATS
+        ++Current.ProgramBinds;
+#endif
+    }
+
+    static inline void CountUniformSet()
+    {
+#if J_ENABLE_RENDER_STATS
+        ++Current.UniformSets;
+#endif
+    }
+
+    static inline void CountTextureBind()
+    {
+#if J_ENABLE_RENDER_STATS
+        ++Current.TextureBinds;
+#endif
+    }
+
+    static inline void CountFramebufferBind(uint64_t binds = 1)
+    {
+#if J_ENABLE_RENDER_STATS
+        Current.FramebufferBinds += binds;
+#endif
+    }
+
+    static inline void CountUpload(uint64_t bytes)
+    {
+#if J_ENABLE_RENDER_STATS
+        Current.UploadBytes += bytes;
+#endif
+    }
+
+    // --------------------- Frames and passes ---------------------
+    /** @brief Close the frame being recorded and start the next one. */
+    void BeginFrame();
+
+    /** @brief Start a pass, nested in the open one if any. name is copied only when first seen. */
+    void BeginPass(const char* name);
+
+    /** @brief End the innermost open pass. */
+    void EndPass();
+
+    /// Counters of the frame being recorded so far.
+    inline const FRenderCounters& GetCurrent() const { return Current; }
+
+    /// Totals of the last closed frame.
+    inline const FRenderFrameStats& GetLastFrame() const { return LastFrame; }
+
+    /// Every pass seen so far, in order of first appearance.
+    inline const std::vector<FRenderPassStats>& GetPasses() const { return Passes; }
+
+    /// Last frames, oldest first. At most HistorySize.
+    std::vector<FRenderFrameStats> GetHistory() const;
+
+    /// Mean of the frames in the history.
+    FRenderFrameStats GetAverage() const;
+
+    // --------------------- CSV ---------------------
+    /**
+     * @brief Append every following frame to a CSV file, one row for the frame then one per pass.
+     * @param path Output file, parent directories are created.
+     * @param frames Frames to write before closing the file, 0 to write until StopCsv().
+     * @return False if the file couldn't be opened.
+     */
+    bool StartCsv(const std::string& path, int frames = 0);
+    void StopCsv();
+    inline bool IsWritingCsv() const { return CsvFile.is_open(); }
+    inline const std::string& GetCsvPath() const { return CsvPath; }
+
+private:
+    struct FOpenPass
+    {
+        int Stats = 0;          ///< Index into Passes
+        FRenderCounters Begin;  ///< Current when the pass began
+    };
+
+    JRenderStats();
+
+    static FRenderCounters Current;
+
+    FRenderFrameStats LastFrame;
+    std::vector<FRenderFrameStats> History;
+    int HistoryHead = 0;
+    int64_t FrameBeginNanoseconds = 0;
+    uint64_t FrameIndex = 0;
+
+    std::vector<FOpenPass> OpenPasses;
+    std::vector<FRenderPassStats> Passes;
+    std::vector<FRenderCounters> PassFrame; ///< Per pass, summed over the frame being recorded
+    std::vector<bool> PassSeen;
+
+    std::ofstream CsvFile;
+    std::string CsvPath;
+    int CsvFramesLeft = -1; ///< -1 while writing without a limit
+
+    int FindOrAddPass(const char* name);
+    void WriteCsvFrame();
+};
@@ -0,0 +1,93 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JRenderTargetPool.h"
+
+#include <algorithm>
+
+namespace
+{
+    size_t GetBytesPerPixel(EColorFormat format)
+    {
+        switch (format)
+        {
+            case EColorFormat::RGBA8:   return 4;
+            case EColorFormat::RGBA16F: return 8;
+            case EColorFormat::R16F:    return 2;
+            case EColorFormat::RG16F:   return 4;
+            case EColorFormat::R8:      return 1;
+            case EColorFormat::RGB8:
+            default:                    return 4; // padded to 4 bytes by most drivers
+        }
+    }
+
+    /// Every JFramebufferTarget carries a DEPTH24_STENCIL8 renderbuffer.
+    constexpr size_t kDepthStencilBytes = 4;
+}
+
+size_t FRenderTargetDesc::GetSizeBytes() const
+{
+    size_t bytesPerPixel = kDepthStencilBytes;
+    for (EColorFormat format : Formats)
+        bytesPerPixel += GetBytesPerPixel(format);
+    return static_cast<size_t>(Width) * Height * std::max(Samples, 1) * bytesPerPixel;
+}
+
+JRenderTargetPool::JRenderTargetPool() = default;
+JRenderTargetPool::~JRenderTargetPool() = default;
+
+JFramebufferTarget* JRenderTargetPool::Acquire(const FRenderTargetDesc& desc)
+{
+    for (const auto& pooled : Targets)
+    {
+        if (pooled->bInUse || pooled->Desc != desc) continue;
+        pooled->bInUse = true;
+        pooled->LastUsedFrame = Frame;
+        ++Stats.Reuses;
+        return pooled->Target.get();
+    }
+
+    auto pooled = std::make_unique<FPooledTarget>();
+    pooled->Desc = desc;
+    pooled->Target = std::make_unique<JFramebufferTarget>(desc.Width, desc.Height, desc.Formats, desc.Samples);
+    pooled->bInUse = true;
+    pooled->LastUsedFrame = Frame;
+    Targets.push_back(std::move(pooled));
+    ++Stats.Allocations;
+    return Targets.back()->Target.get();
+}
+
+void JRenderTargetPool::Release(const JFramebufferTarget* target)
+{
+    if (!target) return;
+    for (const auto& pooled : Targets)
+    {
+        if (pooled->Target.get() != target) continue;
+        pooled->bInUse = false;
+        pooled->LastUsedFrame = Frame;
+        return;
+    }
+}
+
+void JRenderTargetPool::BeginFrame()
+{
+    ++Frame;
+    const size_t count = Targets.size();
+    Targets.erase(std::remove_if(Targets.begin(), Targets.end(), [this](const std::unique_ptr<FPooledTarget>& pooled)
+    {
+        return !pooled->bInUse && Frame - pooled->LastUsedFrame > RetainFrames;
+    }), Targets.end());
+    Stats.Destroyed += count - Targets.size();
+}
+
+const FRenderTargetPoolStats& JRenderTargetPool::GetStats() const
+{
+    Stats.Targets = static_cast<int>(Targets.size());
+    Stats.TargetsInUse = 0;
+    Stats.Bytes = 0;
+    for (const auto& pooled : Targets)
+    {
+        Stats.TargetsInUse += pooled->bInUse ? 1 : 0;
+        Stats.Bytes += pooled->Desc.GetSizeBytes();
+    }
+    return Stats;
+}
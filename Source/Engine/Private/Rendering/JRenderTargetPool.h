@@ -0,0 +1,101 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "JFramebufferTarget.h"
+
+/// Size and formats of a pooled target. Targets are only shared between equal descriptions.
+struct FRenderTargetDesc
+{
+    int Width = 0;
+    int Height = 0;
+    std::vector<EColorFormat> Formats{ EColorFormat::RGB8 }; ///< One per color attachment
+    int Samples = 1;
+
+    bool operator==(const FRenderTargetDesc& other) const
+    {
+        return Width == other.Width && Height == other.Height && Samples == other.Samples && Formats == other.Formats;
+    }
+    bool operator!=(const FRenderTargetDesc& other) const { return !(*this == other); }
+
+    /// Approximate GPU memory of a target with this description, depth-stencil included.
+    size_t GetSizeBytes() const;
+};
+
+/// Counters of a JRenderTargetPool.
+struct FRenderTargetPoolStats
+{
+    int Targets = 0;          ///< Targets alive, in use or not
+    int TargetsInUse = 0;
+    size_t Bytes = 0;         ///< Memory of every target alive
+    uint64_t Allocations = 0; ///< Targets created since the pool was created
+    uint64_t Reuses = 0;      ///< Acquires served by an existing target
+    uint64_t Destroyed = 0;   ///< Targets released after going unused
+};
+
+/**
+ * @class JRenderTargetPool
+ * @brief Owns framebuffer targets and hands them out by description, reusing freed ones.
+ *
+ * Acquire() returns a free target of the same size, formats and sample count if the pool has
+ * one, and only creates a new one otherwise. Release() hands a target back: it becomes free at
+ * once, so the next Acquire() of the same description in the same frame gets it (this is how
+ * JRenderGraph aliases transient textures), but its memory is only destroyed by BeginFrame()
+ * after it stayed free for RetainFrames frames.
+ *
+ * Resizing is therefore a release of the old size and an acquire of the new one. Going back to
+ * a recent size (dynamic resolution steps, a window dragged back and forth) reuses the targets
+ * still held, and a stream of sizes never allocates more than it can reuse before the old ones
+ * expire.
+ *
+ * Typical usage:
+ * @code
+ * JFramebufferTarget* target = Pool.Acquire({ width, height, { EColorFormat::RGB8 }, 4 });
+ * // ... on resize
+ * Pool.Release(target);
+ * target = Pool.Acquire({ newWidth, newHeight, { EColorFormat::RGB8 }, 4 });
+ * // ... once per frame
+ * Pool.BeginFrame();
+ * @endcode
+ */
+class JRenderTargetPool {
+public:
+    /// Frames a free target is kept before its memory is released.
+    static constexpr int RetainFrames = 8;
+
+    JRenderTargetPool();
+    ~JRenderTargetPool();
+
+    JRenderTargetPool(const JRenderTargetPool&) = delete;
+    JRenderTargetPool& operator=(const JRenderTargetPool&) = delete;
+
+    /** @brief A free target matching desc, created if none is. Owned by the pool. */
+    JFramebufferTarget* Acquire(const FRenderTargetDesc& desc);
+
+    /** @brief Hand a target back. Null and foreign targets are ignored. */
+    void Release(const JFramebufferTarget* target);
+
+    /** @brief Start a new frame, destroying targets that stayed free for RetainFrames frames. */
+    void BeginFrame();
+
+    /// Counters, Targets and Bytes are current.
+    const FRenderTargetPoolStats& GetStats() const;
+
+private:
+    struct FPooledTarget
+    {
+        FRenderTargetDesc Desc;
+        std::unique_ptr<JFramebufferTarget> Target;
+        bool bInUse = false;
+        uint64_t LastUsedFrame = 0;
+    };
+
+    std::vector<std::unique_ptr<FPooledTarget>> Targets;
+    uint64_t Frame = 0;
+
+    mutable FRenderTargetPoolStats Stats;
+};
@@ -3,41 +3,168 @@
 #include "Rendering/JRenderer.h"
 
 #include <glad/gl.h>
+#include "JDynamicResolution.h"
 #include "JFramebufferTarget.h"
+#include "JGpuProfiler.h"
+#include "JOcclusionQueries.h"
+#include "JOutlineRenderer.h"
+#include "JPostProcessor.h"
+#include "JRenderTargetPool.h"
 
 JRenderer::JRenderer(int screenWidth, int screenHeight, int samples)
-    : ScreenWidth(screenWidth), ScreenHeight(screenHeight), Samples(samples)
+    : ScreenWidth(screenWidth), ScreenHeight(screenHeight), Samples(samples),
+      RenderWidth(screenWidth), RenderHeight(screenHeight), PendingWidth(screenWidth), PendingHeight(screenHeight)
 {
-    SceneTarget = std::make_unique<JFramebufferTarget>(screenWidth, screenHeight, samples);
-    ResolveTarget = std::make_unique<JFramebufferTarget>(screenWidth, screenHeight, 1); // always single-sample
+    TargetPool = std::make_unique<JRenderTargetPool>();
+    SceneTarget = TargetPool->Acquire({ screenWidth, screenHeight, { EColorFormat::RGB8 }, samples });
+    OcclusionQueries = std::make_unique<JOcclusionQueries>();
+    DynamicResolution = std::make_unique<JDynamicResolution>();
+    GpuProfiler = std::make_unique<JGpuProfiler>();
+
+    // Single-sample: transparency is accumulated at 1x and composited over every scene sample
+    TransparencyTarget = TargetPool->Acquire({ screenWidth, screenHeight,
+        { EColorFormat::RGBA16F, EColorFormat::R16F }, 1 });
+    CompositePass = std::make_unique<JPostProcessor>("PostProcess", "OITComposite");
+    CompositePass->GetShader().Use();
+    CompositePass->GetShader().SetInt("weightTexture", 1);
+
+    Outlines = std::make_unique<JOutlineRenderer>(screenWidth, screenHeight);
 }
 
+JRenderer::~JRenderer() = default;
+
 void JRenderer::BeginScene() {
+    TargetPool->BeginFrame();
+    GpuProfiler->BeginFrame();
+
+    // Apply the screen size once resizing has settled
+    const bool bResizePending = PendingWidth != ScreenWidth || PendingHeight != ScreenHeight;
+    const std::chrono::duration<double> sinceResize = std::chrono::steady_clock::now() - ResizeRequestTime;
+    if (bResizePending && sinceResize.count() >= ResizeDebounceSeconds) {
+        ScreenWidth = PendingWidth;
+        ScreenHeight = PendingHeight;
+    }
+
+    // Scale picked from the scene passes of a few frames ago
+    DynamicResolution->BeginFrame();
+    int renderWidth = 0, renderHeight = 0;
+    DynamicResolution->GetRenderSize(ScreenWidth, ScreenHeight, renderWidth, renderHeight);
+    if (renderWidth != RenderWidth || renderHeight != RenderHeight) {
+        RenderWidth = renderWidth;
+        RenderHeight = renderHeight;
+        ResizeTargets();
+    }
+
+    GpuProfiler->BeginPass("Scene");
     SceneTarget->Bind();
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-    glViewport(0, 0, ScreenWidth, ScreenHeight);
+    glViewport(0, 0, RenderWidth, RenderHeight);
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Results of last frame's queries, never waits on the GPU
+    OcclusionQueries->BeginFrame();
 }
 
 void JRenderer::EndScene() {
+    OcclusionQueries->EndFrame();
+
+    // Outlines go on top of everything drawn into the scene, before multisampling is resolved
+    if (OutlineMode == EOutlineMode::JumpFlood) {
+        const JGpuScope scope(GpuProfiler.get(), "Outlines");
+        Outlines->Apply(*SceneTarget);
+    }
+
     SceneTarget->Unbind(ScreenWidth, ScreenHeight);
+    GpuProfiler->EndPass();
+    DynamicResolution->EndFrame();
 
-    // Resolve multi-sampled scene to single-sample texture
-    if (SceneTarget->GetSamples() > 1)
-        SceneTarget->ResolveTo(*ResolveTarget);
+    // Resolved lazily, see ResolveSceneTexture()
+    bResolved = false;
+}
+
+void JRenderer::BeginTransparency() {
+    if (TransparencyMode != ETransparencyMode::WeightedBlended) return;
+    GpuProfiler->BeginPass("Transparency");
+
+    // Transparent surfaces are still hidden by opaque ones
+    SceneTarget->BlitDepthTo(*TransparencyTarget);
+    TransparencyTarget->Bind();
+
+    const float clearAccumulation[] = { 0.f, 0.f, 0.f, 1.f }; // alpha holds revealage, starts fully revealed
+    const float clearWeight[] = { 0.f, 0.f, 0.f, 0.f };
+    glClearBufferfv(GL_COLOR, 0, clearAccumulation);
+    glClearBufferfv(GL_COLOR, 1, clearWeight);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+
+    // GL 3.3 has no per-attachment blending: color and weight add up, alpha multiplies by (1 - a)
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void JRenderer::EndTransparency() {
+    if (TransparencyMode != ETransparencyMode::WeightedBlended) return;
+
+    glDepthMask(GL_TRUE);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    SceneTarget->Bind();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, TransparencyTarget->GetTexture(1));
+    glActiveTexture(GL_TEXTURE0);
+
+    CompositePass->Apply(TransparencyTarget->GetTexture(0), RenderWidth, RenderHeight);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    GpuProfiler->EndPass();
 }
 
 void JRenderer::Resize(int newWidth, int newHeight) {
-    ScreenWidth = newWidth;
-    ScreenHeight = newHeight;
-    SceneTarget->Resize(newWidth, newHeight);
-    ResolveTarget->Resize(newWidth, newHeight);
+    // Minimized windows report 0x0, keep the last real size
+    if (newWidth <= 0 || newHeight <= 0) return;
+
+    PendingWidth = newWidth;
+    PendingHeight = newHeight;
+    ResizeRequestTime = std::chrono::steady_clock::now();
+}
+
+void JRenderer::ResizeTargets() {
+    ReacquireTarget(SceneTarget);
+    if (ResolveTarget) ReacquireTarget(ResolveTarget);
+    ReacquireTarget(TransparencyTarget);
+    Outlines->Resize(RenderWidth, RenderHeight);
+}
+
+void JRenderer::ReacquireTarget(JFramebufferTarget*& target) {
+    FRenderTargetDesc desc;
+    desc.Width = RenderWidth;
+    desc.Height = RenderHeight;
+    desc.Formats.clear();
+    for (size_t i = 0; i < target->GetColorAttachmentCount(); ++i)
+        desc.Formats.push_back(target->GetFormat(i));
+    desc.Samples = target->GetSamples();
+
+    TargetPool->Release(target);
+    target = TargetPool->Acquire(desc);
 }
 
-unsigned int JRenderer::GetSceneTargetTexture() const {
-    // If multi-sampled, return resolved texture; otherwise, return scene texture
-    return SceneTarget->GetSamples() > 1 ? ResolveTarget->GetTexture() : SceneTarget->GetTexture();
+unsigned int JRenderer::ResolveSceneTexture() {
+    if (SceneTarget->GetSamples() <= 1)
+        return SceneTarget->GetTexture();
+
+    // Resolve multi-sampled scene to single-sample texture, once per frame
+    if (!ResolveTarget)
+        ResolveTarget = TargetPool->Acquire({ RenderWidth, RenderHeight, { SceneTarget->GetFormat() }, 1 });
+    if (!bResolved) {
+        const JGpuScope scope(GpuProfiler.get(), "MSAA Resolve");
+        SceneTarget->ResolveTo(*ResolveTarget);
+        bResolved = true;
+    }
+    return ResolveTarget->GetTexture();
 }
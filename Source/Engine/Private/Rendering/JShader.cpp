@@ -1,22 +1,37 @@
 // Copyright (c) 2024. JesseTheCatLover. All Rights Reserved.
 
 #include "JShader.h"
+#include "JRenderStats.h"
 
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-JShader::JShader(const string &VertexPath, const string &FragmentPath, const char *GeometryPath)
+namespace
+{
+    /// GLSL wants #version first, variant defines go right after it.
+    string InsertDefines(string Source, const string &Defines)
+    {
+        if (Defines.empty()) return Source;
+        const size_t Version = Source.find("#version");
+        const size_t LineEnd = Version == string::npos ? string::npos : Source.find('\n', Version);
+        Source.insert(LineEnd == string::npos ? 0 : LineEnd + 1, Defines);
+        return Source;
+    }
+}
+
+JShader::JShader(const string &VertexPath, const string &FragmentPath, const char *GeometryPath,
+                 const string &Defines)
 {
     m_Program = glCreateProgram();
 
     // Vertex
-    string VertexCode = LoadShaderSource(VertexPath + ".vert");
+    string VertexCode = InsertDefines(LoadShaderSource(VertexPath + ".vert"), Defines);
     GLuint VertexShader = CompileShader(VertexCode, GL_VERTEX_SHADER);
     glAttachShader(m_Program, VertexShader);
 
     // Fragment
-    string FragmentCode = LoadShaderSource(FragmentPath + ".frag");
+    string FragmentCode = InsertDefines(LoadShaderSource(FragmentPath + ".frag"), Defines);
     GLuint FragmentShader = CompileShader(FragmentCode, GL_FRAGMENT_SHADER);
     glAttachShader(m_Program, FragmentShader);
 
@@ -24,20 +39,13 @@ JShader::JShader(const string &VertexPath, const string &FragmentPath, const cha
     GLuint GeometryShader = 0;
     if (GeometryPath)
     {
-        string GeometryCode = LoadShaderSource(string(GeometryPath) + ".geom");
+        string GeometryCode = InsertDefines(LoadShaderSource(string(GeometryPath) + ".geom"), Defines);
         GeometryShader = CompileShader(GeometryCode, GL_GEOMETRY_SHADER);
         glAttachShader(m_Program, GeometryShader);
     }
 
     // Link once
-    glLinkProgram(m_Program);
-    GLint success;
-    GLchar infoLog[512];
-    glGetProgramiv(m_Program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(m_Program, 512, NULL, infoLog);
-        cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
-    }
+    LinkProgram();
 
     // Cleanup
     glDeleteShader(VertexShader);
@@ -45,70 +53,111 @@ JShader::JShader(const string &VertexPath, const string &FragmentPath, const cha
     if (GeometryShader) glDeleteShader(GeometryShader);
 }
 
+unique_ptr<JShader> JShader::CreateFromSource(const string &VertexSource, const string &FragmentSource)
+{
+    unique_ptr<JShader> Shader(new JShader());
+    Shader->m_Program = glCreateProgram();
+
+    GLuint VertexShader = Shader->CompileShader(VertexSource, GL_VERTEX_SHADER);
+    GLuint FragmentShader = Shader->CompileShader(FragmentSource, GL_FRAGMENT_SHADER);
+    glAttachShader(Shader->m_Program, VertexShader);
+    glAttachShader(Shader->m_Program, FragmentShader);
+    Shader->LinkProgram();
+
+    glDeleteShader(VertexShader);
+    glDeleteShader(FragmentShader);
+    return Shader;
+}
+
 
 void JShader::Use()
 {
     glUseProgram(m_Program);
+    JRenderStats::CountProgramBind();
 }
 
 void JShader::SetBool(const string& name, bool value) const
 {
     glUniform1i(glGetUniformLocation(m_Program, name.c_str()), (int)value);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetInt(const string& name, int value) const
 {
     glUniform1i(glGetUniformLocation(m_Program, name.c_str()), value);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetFloat(const string& name, float value) const
 {
     glUniform1f(glGetUniformLocation(m_Program, name.c_str()), value);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetVec2(const string &name, glm::vec2 value) const
 {
     glUniform2fv(glGetUniformLocation(m_Program, name.c_str()), 1, &value[0]);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetVec2(const string &name, float x, float y) const
 {
     glUniform2f(glGetUniformLocation(m_Program, name.c_str()), x, y);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetVec3(const string &name, glm::vec3 value) const
 {
     glUniform3fv(glGetUniformLocation(m_Program, name.c_str()), 1, &value[0]);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetVec3(const string &name, float x, float y, float z) const
 {
     glUniform3f(glGetUniformLocation(m_Program, name.c_str()), x, y, z);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetVec4(const string &name, glm::vec4 value) const
 {
     glUniform4fv(glGetUniformLocation(m_Program, name.c_str()), 1, &value[0]);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetVec4(const string &name, float x, float y, float z, float w) const
 {
     glUniform4f(glGetUniformLocation(m_Program, name.c_str()), x, y, z, w);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetMat2(const string &name, const glm::mat2 &mat) const
 {
     glUniformMatrix2fv(glGetUniformLocation(m_Program, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetMat3(const string &name, const glm::mat3 &mat) const
 {
     glUniformMatrix3fv(glGetUniformLocation(m_Program, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::SetMat4(const string &name, const glm::mat4 &mat) const
 {
     glUniformMatrix4fv(glGetUniformLocation(m_Program, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    JRenderStats::CountUniformSet();
+    ++m_Revision;
 }
 
 void JShader::LinkUniformBlock(const std::string &blockName, GLuint bindingPoint) const
@@ -161,6 +210,18 @@ GLuint JShader::CompileShader(const string& source, GLenum type)
     return shader;
 }
 
+void JShader::LinkProgram()
+{
+    glLinkProgram(m_Program);
+    GLint success;
+    GLchar infoLog[512];
+    glGetProgramiv(m_Program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(m_Program, 512, NULL, infoLog);
+        cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
+    }
+}
+
 JShader::~JShader() {
     glDeleteProgram(m_Program);
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <glad/gl.h>
 #include <GLFW/glfw3.h>
@@ -12,7 +14,16 @@ using namespace std;
 class JShader
 {
 public:
-    JShader(const string &VertexPath, const string &FragmentPath, const char *GeometryPath = nullptr);
+    /// Defines (e.g. "#define OIT_OUTPUT\n") are inserted after each stage's #version line, to build variants of one file.
+    JShader(const string &VertexPath, const string &FragmentPath, const char *GeometryPath = nullptr,
+            const string &Defines = "");
+
+    /// Build a program from in-memory sources, e.g. generated shaders.
+    static unique_ptr<JShader> CreateFromSource(const string &VertexSource, const string &FragmentSource);
+
+    /// Read a shader file relative to Assets/Shaders.
+    static string LoadShaderSource(const string &path);
+
     void Use();
     void SetBool(const string &name, bool value) const;
     void SetInt(const string &name, int value) const;
@@ -30,11 +41,17 @@ public:
     void LinkUniformBlock(const std::string& blockName, GLuint bindingPoint) const;
 
     GLuint GetProgram() const { return m_Program; }
+
+    /// Bumped by every Set*() call, lets mirrors of the uniforms skip programs that didn't change.
+    uint64_t GetRevision() const { return m_Revision; }
+
     ~JShader();
 
 private:
     GLuint m_Program;
+    mutable uint64_t m_Revision = 0;
 
-    static string LoadShaderSource(const string &path);
+    JShader() = default;
     GLuint CompileShader(const string &source, GLenum type);
+    void LinkProgram();
 };
@@ -1,6 +1,7 @@
 // Copyright (c) 2025 JesseTheCatLover. All Rights Reserved.
 
 #include "JSkybox.h"
+#include "JRenderStats.h"
 #include <glm/gtc/type_ptr.hpp>
 
 // Cube vertices for a skybox
@@ -86,6 +87,7 @@ void JSkybox::Draw(const glm::mat4& view, const glm::mat4& projection)
     shader.SetInt("skybox", 0);
 
     glDrawArrays(GL_TRIANGLES, 0, 36);
+    JRenderStats::CountDraw(12);
     glBindVertexArray(0);
 
     glDepthFunc(GL_LESS); // reset
@@ -0,0 +1,335 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JSoftwareOcclusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Core/JCpuProfiler.h"
+#include "Core/JJobSystem.h"
+#include "JModel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define JOCCLUSION_SSE 1
+#else
+    #define JOCCLUSION_SSE 0
+#endif
+
+namespace
+{
+    /// Vertices closer than this (clip-space w) are not rasterized. Dropping occluder triangles is always safe.
+    constexpr float kNearW = 1e-3f;
+
+    /// Depth slack for tests, absorbs interpolation error on surfaces that are both occluder and occludee.
+    constexpr float kDepthBias = 1e-4f;
+
+    /// HiZ level is raised until a tested rectangle spans at most this many texels per axis.
+    constexpr int kMaxTestTexels = 4;
+}
+
+JSoftwareOcclusion::JSoftwareOcclusion(int width, int height)
+{
+    SetResolution(width, height);
+}
+
+void JSoftwareOcclusion::SetResolution(int width, int height)
+{
+    TilesX = std::max(1, (width + TileWidth - 1) / TileWidth);
+    TilesY = std::max(1, (height + TileHeight - 1) / TileHeight);
+    Width = TilesX * TileWidth;
+    Height = TilesY * TileHeight;
+
+    TileBins.assign(TilesX * TilesY, {});
+
+    HiZ.clear();
+    HiZSizes.clear();
+    int levelWidth = Width, levelHeight = Height;
+    while (true)
+    {
+        HiZ.emplace_back(static_cast<size_t>(levelWidth) * levelHeight, 1.f);
+        HiZSizes.emplace_back(levelWidth, levelHeight);
+        if (levelWidth == 1 && levelHeight == 1) break;
+        // Round up so an odd last row or column still has a texel above it, the pyramid stays conservative
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+}
+
+void JSoftwareOcclusion::BeginFrame(const glm::mat4& viewProjection)
+{
+    ViewProjection = viewProjection;
+    Stats = FOcclusionStats();
+    Occluders.clear();
+    std::fill(HiZ[0].begin(), HiZ[0].end(), 1.f);
+}
+
+void JSoftwareOcclusion::AddOccluder(const JModel& model, const glm::mat4& transform)
+{
+    ++Stats.Occluders;
+    for (const auto& mesh : model.Meshes)
+    {
+        Occluders.push_back({ &mesh, transform });
+        Stats.OccluderTriangles += static_cast<int>(mesh.Indices.size() / 3);
+    }
+}
+
+void JSoftwareOcclusion::Rasterize(JJobSystem* jobs)
+{
+    J_PROFILE_SCOPE("Occluder Rasterization");
+    // Transform and set up triangles, one independent output list per occluder mesh
+    if (MeshTriangles.size() < Occluders.size())
+        MeshTriangles.resize(Occluders.size());
+
+    auto setup = [this](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            SetupTriangles(Occluders[i], MeshTriangles[i]);
+    };
+    if (jobs) jobs->ParallelFor(Occluders.size(), 1, setup);
+    else setup(0, Occluders.size());
+
+    // Bin by tile. Cheap compared to rasterization, so it stays on this thread
+    for (auto& bin : TileBins)
+        bin.clear();
+
+    for (size_t i = 0; i < Occluders.size(); ++i)
+    {
+        for (const FRasterTriangle& triangle : MeshTriangles[i])
+        {
+            const int tileMinX = triangle.MinX / TileWidth, tileMaxX = triangle.MaxX / TileWidth;
+            const int tileMinY = triangle.MinY / TileHeight, tileMaxY = triangle.MaxY / TileHeight;
+            for (int ty = tileMinY; ty <= tileMaxY; ++ty)
+                for (int tx = tileMinX; tx <= tileMaxX; ++tx)
+                    TileBins[ty * TilesX + tx].push_back(&triangle);
+        }
+        Stats.RasterizedTriangles += static_cast<int>(MeshTriangles[i].size());
+    }
+
+    // Tiles own disjoint pixels, so they rasterize in parallel without synchronization
+    auto raster = [this](size_t begin, size_t end)
+    {
+        for (size_t tile = begin; tile < end; ++tile)
+            RasterizeTile(static_cast<int>(tile));
+    };
+    if (jobs) jobs->ParallelFor(TileBins.size(), 1, raster);
+    else raster(0, TileBins.size());
+
+    BuildHiZ();
+}
+
+bool JSoftwareOcclusion::TestAABB(const FAABB& worldBounds) const
+{
+    if (!worldBounds.IsValid()) return true;
+
+    // Project the eight corners; anything reaching behind the near plane is treated as visible
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec4 position((corner & 1) ? worldBounds.Max.x : worldBounds.Min.x,
+                                 (corner & 2) ? worldBounds.Max.y : worldBounds.Min.y,
+                                 (corner & 4) ? worldBounds.Max.z : worldBounds.Min.z, 1.f);
+        const glm::vec4 clip = ViewProjection * position;
+        if (clip.w <= kNearW) return true;
+
+        const float invW = 1.f / clip.w;
+        const float x = (clip.x * invW * 0.5f + 0.5f) * Width;
+        const float y = (clip.y * invW * 0.5f + 0.5f) * Height;
+        const float z = clip.z * invW * 0.5f + 0.5f;
+        minX = std::min(minX, x); maxX = std::max(maxX, x);
+        minY = std::min(minY, y); maxY = std::max(maxY, y);
+        minZ = std::min(minZ, z);
+    }
+
+    if (maxX < 0.f || maxY < 0.f || minX >= Width || minY >= Height) return true; // Frustum culling's job
+    if (minZ <= 0.f) return true;
+
+    int x0 = std::max(0, static_cast<int>(minX));
+    int y0 = std::max(0, static_cast<int>(minY));
+    int x1 = std::min(Width - 1, static_cast<int>(maxX));
+    int y1 = std::min(Height - 1, static_cast<int>(maxY));
+
+    // Climb the HiZ until the rectangle covers only a handful of texels
+    size_t level = 0;
+    while (level + 1 < HiZ.size() && std::max(x1 - x0, y1 - y0) >= kMaxTestTexels)
+    {
+        ++level;
+        x0 >>= 1; y0 >>= 1; x1 >>= 1; y1 >>= 1;
+    }
+
+    const glm::ivec2 size = HiZSizes[level];
+    const std::vector<float>& depth = HiZ[level];
+    x1 = std::min(x1, size.x - 1);
+    y1 = std::min(y1, size.y - 1);
+    if (x0 > x1 || y0 > y1) return true; // No texel to test against, never call that occluded
+
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+            if (depth[y * size.x + x] + kDepthBias >= minZ) return true;
+
+    return false;
+}
+
+// --------------------- Internal Helpers ---------------------
+void JSoftwareOcclusion::SetupTriangles(const FOccluder& occluder, std::vector<FRasterTriangle>& outTriangles) const
+{
+    outTriangles.clear();
+
+    const JMesh& mesh = *occluder.Mesh;
+    const glm::mat4 transform = ViewProjection * occluder.Transform;
+
+    // Screen-space position per vertex, w <= 0 marks vertices that can't be projected
+    thread_local std::vector<glm::vec4> projected;
+    projected.resize(mesh.Vertices.size());
+    for (size_t i = 0; i < mesh.Vertices.size(); ++i)
+    {
+        const glm::vec4 clip = transform * glm::vec4(mesh.Vertices[i].Position, 1.f);
+        if (clip.w <= kNearW)
+        {
+            projected[i] = glm::vec4(0.f, 0.f, 0.f, -1.f);
+            continue;
+        }
+        const float invW = 1.f / clip.w;
+        projected[i] = glm::vec4((clip.x * invW * 0.5f + 0.5f) * Width,
+                                 (clip.y * invW * 0.5f + 0.5f) * Height,
+                                 clip.z * invW * 0.5f + 0.5f, 1.f);
+    }
+
+    for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+    {
+        glm::vec4 v[3] = { projected[mesh.Indices[i]], projected[mesh.Indices[i + 1]], projected[mesh.Indices[i + 2]] };
+        if (v[0].w < 0.f || v[1].w < 0.f || v[2].w < 0.f) continue;
+
+        // Occluders are drawn two-sided: a back face is still real geometry at a real depth
+        float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+        if (area < 0.f)
+        {
+            std::swap(v[1], v[2]);
+            area = -area;
+        }
+        if (area < 1e-6f) continue;
+
+        const float minX = std::min({ v[0].x, v[1].x, v[2].x });
+        const float maxX = std::max({ v[0].x, v[1].x, v[2].x });
+        const float minY = std::min({ v[0].y, v[1].y, v[2].y });
+        const float maxY = std::max({ v[0].y, v[1].y, v[2].y });
+        if (maxX < 0.f || maxY < 0.f || minX >= Width || minY >= Height) continue;
+        if (std::max({ v[0].z, v[1].z, v[2].z }) < 0.f) continue; // In front of the near plane
+
+        FRasterTriangle triangle;
+        for (int k = 0; k < 3; ++k)
+        {
+            triangle.X[k] = v[k].x;
+            triangle.Y[k] = v[k].y;
+            triangle.Z[k] = v[k].z;
+        }
+        triangle.MinX = std::max(0, static_cast<int>(minX));
+        triangle.MinY = std::max(0, static_cast<int>(minY));
+        triangle.MaxX = std::min(Width - 1, static_cast<int>(maxX));
+        triangle.MaxY = std::min(Height - 1, static_cast<int>(maxY));
+        outTriangles.push_back(triangle);
+    }
+}
+
+void JSoftwareOcclusion::RasterizeTile(int tileIndex)
+{
+    const int tileX0 = (tileIndex % TilesX) * TileWidth;
+    const int tileY0 = (tileIndex / TilesX) * TileHeight;
+    float* depth = HiZ[0].data();
+
+    for (const FRasterTriangle* triangle : TileBins[tileIndex])
+    {
+        const float* X = triangle->X;
+        const float* Y = triangle->Y;
+        const float* Z = triangle->Z;
+
+        // Edge functions E_i(x, y) = A_i * x + B_i * y + C_i, positive inside (counter-clockwise)
+        float A[3], B[3], C[3];
+        for (int e = 0; e < 3; ++e)
+        {
+            const int a = (e + 1) % 3, b = (e + 2) % 3;
+            A[e] = Y[a] - Y[b];
+            B[e] = X[b] - X[a];
+            C[e] = X[a] * Y[b] - X[b] * Y[a];
+        }
+
+        // Depth plane from the barycentrics; E_0 / area weights vertex 0, etc.
+        const float invArea = 1.f / (C[0] + C[1] + C[2]);
+        const float dzdx = (A[0] * Z[0] + A[1] * Z[1] + A[2] * Z[2]) * invArea;
+        const float dzdy = (B[0] * Z[0] + B[1] * Z[1] + B[2] * Z[2]) * invArea;
+        const float z0 = (C[0] * Z[0] + C[1] * Z[1] + C[2] * Z[2]) * invArea;
+
+        const int minX = std::max(triangle->MinX, tileX0);
+        const int maxX = std::min(triangle->MaxX, tileX0 + TileWidth - 1);
+        const int minY = std::max(triangle->MinY, tileY0);
+        const int maxY = std::min(triangle->MaxY, tileY0 + TileHeight - 1);
+        if (minX > maxX || minY > maxY) continue;
+
+#if JOCCLUSION_SSE
+        // Process 4 horizontally adjacent pixels per step; start aligned so stores stay inside the tile
+        const int startX = minX & ~3;
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            const float py = y + 0.5f;
+            float* row = depth + static_cast<size_t>(y) * Width;
+
+            for (int x = startX; x <= maxX; x += 4)
+            {
+                const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+                const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[0]), px), _mm_set1_ps(B[0] * py + C[0]));
+                const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[1]), px), _mm_set1_ps(B[1] * py + C[1]));
+                const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[2]), px), _mm_set1_ps(B[2] * py + C[2]));
+                const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(e0, zero), _mm_cmpgt_ps(e1, zero)),
+                                                 _mm_cmpgt_ps(e2, zero));
+                if (_mm_movemask_ps(inside) == 0) continue;
+
+                const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(dzdx), px), _mm_set1_ps(dzdy * py + z0));
+                const __m128 old = _mm_loadu_ps(row + x);
+                const __m128 nearer = _mm_min_ps(old, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+            }
+        }
+#else
+        for (int y = minY; y <= maxY; ++y)
+        {
+            const float py = y + 0.5f;
+            float* row = depth + static_cast<size_t>(y) * Width;
+            for (int x = minX; x <= maxX; ++x)
+            {
+                const float px = x + 0.5f;
+                if (A[0] * px + B[0] * py + C[0] <= 0.f ||
+                    A[1] * px + B[1] * py + C[1] <= 0.f ||
+                    A[2] * px + B[2] * py + C[2] <= 0.f) continue;
+
+                row[x] = std::min(row[x], dzdx * px + dzdy * py + z0);
+            }
+        }
+#endif
+    }
+}
+
+void JSoftwareOcclusion::BuildHiZ()
+{
+    for (size_t level = 1; level < HiZ.size(); ++level)
+    {
+        const glm::ivec2 source = HiZSizes[level - 1];
+        const glm::ivec2 target = HiZSizes[level];
+        const std::vector<float>& src = HiZ[level - 1];
+        std::vector<float>& dst = HiZ[level];
+
+        // Each texel takes the max of its 2x2 sources; on odd sizes the last one only has the 1 or 2 left
+        for (int y = 0; y < target.y; ++y)
+        {
+            const int sy0 = std::min(y * 2, source.y - 1), sy1 = std::min(y * 2 + 1, source.y - 1);
+            for (int x = 0; x < target.x; ++x)
+            {
+                const int sx0 = std::min(x * 2, source.x - 1), sx1 = std::min(x * 2 + 1, source.x - 1);
+                dst[y * target.x + x] = std::max(std::max(src[sy0 * source.x + sx0], src[sy0 * source.x + sx1]),
+                                                 std::max(src[sy1 * source.x + sx0], src[sy1 * source.x + sx1]));
+            }
+        }
+    }
+}
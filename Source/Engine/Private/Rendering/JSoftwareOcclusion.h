@@ -0,0 +1,118 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+#include "../Core/Math/FAABB.h"
+
+class JJobSystem;
+class JMesh;
+class JModel;
+
+/// Per-frame counters of JSoftwareOcclusion.
+struct FOcclusionStats
+{
+    int Occluders = 0;           ///< Occluder models submitted
+    int OccluderTriangles = 0;   ///< Triangles submitted
+    int RasterizedTriangles = 0; ///< Triangles that survived clipping and were binned
+};
+
+/**
+ * @class JSoftwareOcclusion
+ * @brief CPU depth rasterizer for occluders, with a hierarchical depth buffer for occlusion tests.
+ *
+ * Actors flagged as occluders (JActor::Config.bIsOccluder) are rasterized, preferably through a
+ * simplified JActor::OccluderModel, into a small depth-only buffer. The buffer is then reduced
+ * into a max-depth mip chain (HiZ) against which screen-space bounds are tested conservatively:
+ * a box is occluded only if every HiZ texel it covers is nearer than the box's nearest point.
+ *
+ * The frame is split into fixed tiles. Triangles are transformed and set up in parallel per
+ * occluder mesh, binned into the tiles they touch, and each tile is then rasterized independently
+ * on the JJobSystem with SSE edge functions (4 pixels per step), so no two threads ever write the
+ * same pixel. Nothing touches GL, the whole pass runs on machines without a GPU.
+ *
+ * Typical usage:
+ * @code
+ * Occlusion.BeginFrame(projection * view);
+ * for (auto& actor : visibleActors)
+ *     if (actor.Config.bIsOccluder) Occlusion.AddOccluder(*actor.Model, actor.GetModelMatrix());
+ * Occlusion.Rasterize(jobs);
+ * FrustumCuller.CullOccluded(Occlusion, jobs); // or TestAABB() on individual bounds
+ * @endcode
+ */
+class JSoftwareOcclusion {
+public:
+    static constexpr int TileWidth = 32;
+    static constexpr int TileHeight = 32;
+
+    /**
+     * @param width Depth buffer width, rounded up to a multiple of TileWidth.
+     * @param height Depth buffer height, rounded up to a multiple of TileHeight.
+     */
+    JSoftwareOcclusion(int width = 256, int height = 128);
+
+    void SetResolution(int width, int height);
+
+    /** @brief Start a new frame: clears occluders and depth. */
+    void BeginFrame(const glm::mat4& viewProjection);
+
+    /**
+     * @brief Queue a model as occluder for this frame.
+     * @param model Occluder geometry, its CPU-side vertices and indices are rasterized.
+     * @param transform Model matrix.
+     */
+    void AddOccluder(const JModel& model, const glm::mat4& transform);
+
+    /** @brief Rasterize all queued occluders and build the HiZ. Must be called before TestAABB(). */
+    void Rasterize(JJobSystem* jobs = nullptr);
+
+    /**
+     * @brief Conservative visibility test of world-space bounds. Thread-safe after Rasterize().
+     * @return false if the box is entirely hidden behind occluders.
+     */
+    bool TestAABB(const FAABB& worldBounds) const;
+
+    inline int GetWidth() const { return Width; }
+    inline int GetHeight() const { return Height; }
+
+    /// Occluder depth, row-major from the bottom row, [0, 1] with 1 = far plane / empty.
+    inline const std::vector<float>& GetDepthBuffer() const { return HiZ[0]; }
+
+    /// Occluder counters of the current frame. Occludee rejection is reported in FCullingStats.
+    inline const FOcclusionStats& GetStats() const { return Stats; }
+
+private:
+    struct FOccluder
+    {
+        const JMesh* Mesh;
+        glm::mat4 Transform;
+    };
+
+    /// Screen-space triangle ready for rasterization.
+    struct FRasterTriangle
+    {
+        float X[3], Y[3], Z[3];
+        int MinX, MinY, MaxX, MaxY; ///< Pixel bounds, clamped to the screen
+    };
+
+    int Width = 0;
+    int Height = 0;
+    int TilesX = 0;
+    int TilesY = 0;
+
+    glm::mat4 ViewProjection = glm::mat4(1.f);
+    FOcclusionStats Stats;
+
+    std::vector<FOccluder> Occluders;
+    std::vector<std::vector<FRasterTriangle>> MeshTriangles; ///< Set-up triangles, one list per occluder mesh
+    std::vector<std::vector<const FRasterTriangle*>> TileBins;
+
+    std::vector<std::vector<float>> HiZ; ///< Level 0 is the depth buffer, each level is the 2x2 max of the previous
+    std::vector<glm::ivec2> HiZSizes;
+
+    void SetupTriangles(const FOccluder& occluder, std::vector<FRasterTriangle>& outTriangles) const;
+    void RasterizeTile(int tileIndex);
+    void BuildHiZ();
+};
@@ -1,6 +1,7 @@
 // Copyright (c) 2025 JesseTheCatLover. All Rights Reserved.
 
 #include "JTexture.h"
+#include "JRenderStats.h"
 #include <iostream>
 #include <vector>
 #include <stb/stb_image.h>
@@ -33,6 +34,7 @@ void JTexture::Bind(GLenum unit) const
     } else if (type == TextureType::CubeMap) {
         glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
     }
+    JRenderStats::CountTextureBind();
 }
 
 void JTexture::Load2D(const std::string& fileName)
@@ -84,6 +86,7 @@ void JTexture::LoadCubeMap(const std::string& directory)
             GLint format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format,
                          width, height, 0, format, GL_UNSIGNED_BYTE, faceData);
+            JRenderStats::CountUpload(static_cast<uint64_t>(width) * height * nrChannels);
             stbi_image_free(faceData);
         } else {
             std::cerr << "ERROR::CUBEMAP::FAILED_TO_LOAD_FACE: "
@@ -102,6 +105,7 @@ void JTexture::LoadCubeMap(const std::string& directory)
 void JTexture::GenerateTexture(const GLint &colorFormat) {
     glTexImage2D(GL_TEXTURE_2D, 0, colorFormat, width, height, 0, colorFormat,
                  GL_UNSIGNED_BYTE, data);
+    JRenderStats::CountUpload(static_cast<uint64_t>(width) * height * nrChannels);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
@@ -0,0 +1,158 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JTransparentSorter.h"
+
+#include <cstring>
+#include "JModel.h"
+#include "Scene/JActor.h"
+
+namespace
+{
+    /// Insertion sort budget per item before switching to the radix sort.
+    constexpr size_t kShiftsPerItem = 4;
+
+    /// Below this many items a fresh insertion sort beats the radix sort's fixed passes.
+    constexpr size_t kSmallListSize = 32;
+
+    inline uint64_t MakeId(uint32_t actorIndex, int32_t meshIndex)
+    {
+        return (static_cast<uint64_t>(actorIndex) << 32) | static_cast<uint32_t>(meshIndex + 1);
+    }
+
+    /// Map a non-negative float to a uint32 with the same order, inverted so larger distances come first.
+    inline uint32_t DescendingKey(float key)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return ~bits;
+    }
+}
+
+void JTransparentSorter::Begin(const glm::vec3& cameraPosition)
+{
+    CameraPosition = cameraPosition;
+    PreviousIds.swap(Ids);
+    Ids.clear();
+    Items.clear();
+}
+
+void JTransparentSorter::Add(uint32_t actorIndex, const JActor& actor, const uint8_t* meshVisibility)
+{
+    const bool bPerMesh = actor.Model && !actor.Config.bDrawOutline &&
+        (Mode == ETransparentSortMode::PerMesh ||
+         (Mode == ETransparentSortMode::Auto && actor.Model->Meshes.size() >= PerMeshThreshold));
+
+    if (!bPerMesh)
+    {
+        const glm::vec3 delta = actor.GetWorldBounds().GetCenter() - CameraPosition;
+        Items.push_back({ glm::dot(delta, delta), actorIndex, -1 });
+        Ids.push_back(MakeId(actorIndex, -1));
+        return;
+    }
+
+    const glm::mat4 transform = actor.GetModelMatrix();
+    const auto& meshes = actor.Model->Meshes;
+    for (size_t m = 0; m < meshes.size(); ++m)
+    {
+        if (meshVisibility && !meshVisibility[m]) continue;
+
+        const glm::vec3 center = glm::vec3(transform * glm::vec4(meshes[m].Bounds.GetCenter(), 1.f));
+        const glm::vec3 delta = center - CameraPosition;
+        Items.push_back({ glm::dot(delta, delta), actorIndex, static_cast<int32_t>(m) });
+        Ids.push_back(MakeId(actorIndex, static_cast<int32_t>(m)));
+    }
+}
+
+void JTransparentSorter::Sort()
+{
+    bUsedRadix = false;
+    LastShifts = 0;
+
+    const size_t count = Items.size();
+    const bool bCoherent = Ids == PreviousIds && Order.size() == count;
+
+    if (!bCoherent)
+    {
+        // New item set: last frame's order means nothing, start from submission order
+        Order.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            Order[i] = static_cast<uint32_t>(i);
+
+        if (count > kSmallListSize)
+        {
+            RadixSort();
+            return;
+        }
+    }
+
+    if (!InsertionSort(count * kShiftsPerItem + kSmallListSize))
+        RadixSort();
+}
+
+// --------------------- Internal Helpers ---------------------
+bool JTransparentSorter::InsertionSort(size_t maxShifts)
+{
+    size_t shifts = 0;
+    for (size_t i = 1; i < Order.size(); ++i)
+    {
+        const uint32_t item = Order[i];
+        const float key = Items[item].Key;
+
+        size_t j = i;
+        while (j > 0 && Items[Order[j - 1]].Key < key)
+        {
+            Order[j] = Order[j - 1];
+            --j;
+            if (++shifts > maxShifts)
+            {
+                Order[j] = item; // Leave Order a valid permutation for the radix sort
+                LastShifts = shifts;
+                return false;
+            }
+        }
+        Order[j] = item;
+    }
+
+    LastShifts = shifts;
+    return true;
+}
+
+void JTransparentSorter::RadixSort()
+{
+    bUsedRadix = true;
+
+    const size_t count = Order.size();
+    RadixKeys.resize(count);
+    RadixKeysTemp.resize(count);
+    RadixOrderTemp.resize(count);
+
+    for (size_t i = 0; i < count; ++i)
+        RadixKeys[i] = DescendingKey(Items[Order[i]].Key);
+
+    // Four stable 8-bit passes, least significant byte first
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        uint32_t histogram[257] = {};
+        for (size_t i = 0; i < count; ++i)
+            ++histogram[((RadixKeys[i] >> shift) & 0xFF) + 1];
+
+        // Skip passes where every key has the same byte
+        bool bTrivial = false;
+        for (int b = 1; b <= 256; ++b)
+            if (histogram[b] == count) bTrivial = true;
+        if (bTrivial) continue;
+
+        for (int b = 1; b <= 256; ++b)
+            histogram[b] += histogram[b - 1];
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t destination = histogram[(RadixKeys[i] >> shift) & 0xFF]++;
+            RadixKeysTemp[destination] = RadixKeys[i];
+            RadixOrderTemp[destination] = Order[i];
+        }
+
+        RadixKeys.swap(RadixKeysTemp);
+        Order.swap(RadixOrderTemp);
+    }
+}
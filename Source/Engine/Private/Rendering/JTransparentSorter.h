@@ -0,0 +1,101 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class JActor;
+
+/// Granularity of transparent sorting.
+enum class ETransparentSortMode : uint8_t
+{
+    PerActor, ///< One key per actor, distance to its world bounds center
+    PerMesh,  ///< One key per mesh, so meshes of large models interleave correctly
+    Auto      ///< Per mesh for models with at least PerMeshThreshold meshes, per actor otherwise
+};
+
+/// One transparent draw: an actor, or a single mesh of it.
+struct FTransparentItem
+{
+    float Key;           ///< Squared distance to the camera, sorted far to near
+    uint32_t ActorIndex; ///< Caller's actor index as passed to Add()
+    int32_t MeshIndex;   ///< Mesh of the actor's model, -1 for the whole actor
+};
+
+/**
+ * @class JTransparentSorter
+ * @brief Persistent back-to-front draw list for transparent geometry.
+ *
+ * The list stores small (key, index) items instead of actor copies, and keeps its storage
+ * between frames, so after warm-up sorting performs no heap allocation at all.
+ *
+ * Sorting exploits frame-to-frame coherence: when the same items are submitted as last frame,
+ * last frame's order is kept and repaired with an insertion sort, which is linear when the
+ * camera moved only a little. If the item set changed or the insertion sort has to shift too
+ * many items, it falls back to an LSD radix sort on the float keys.
+ *
+ * Typical usage:
+ * @code
+ * Sorter.Begin(cameraPosition);
+ * for (uint32_t i = 0; i < actors.size(); ++i)
+ *     if (actors[i].Config.bIsTransparent) Sorter.Add(i, actors[i]);
+ * Sorter.Sort();
+ * for (size_t i = 0; i < Sorter.GetCount(); ++i) Draw(Sorter.GetSorted(i));
+ * @endcode
+ */
+class JTransparentSorter {
+public:
+    /// Minimum mesh count for per-mesh sorting in Auto mode.
+    static constexpr size_t PerMeshThreshold = 4;
+
+    /** @brief Start a new frame's list. */
+    void Begin(const glm::vec3& cameraPosition);
+
+    /**
+     * @brief Queue a transparent actor.
+     * @param actorIndex Index the caller uses to find the actor again when drawing.
+     * @param actor The actor. Outlined actors are always sorted as a whole, the outline needs all meshes.
+     * @param meshVisibility Optional, one byte per mesh (see JFrustumCuller); hidden meshes are not queued
+     *        when sorting per mesh.
+     */
+    void Add(uint32_t actorIndex, const JActor& actor, const uint8_t* meshVisibility = nullptr);
+
+    /** @brief Sort the queued items back to front. */
+    void Sort();
+
+    inline size_t GetCount() const { return Order.size(); }
+
+    /// i-th item in back-to-front order.
+    inline const FTransparentItem& GetSorted(size_t i) const { return Items[Order[i]]; }
+
+    inline void SetMode(ETransparentSortMode mode) { Mode = mode; }
+    inline ETransparentSortMode GetMode() const { return Mode; }
+
+    /// True if the last Sort() had to fall back to the radix sort.
+    inline bool UsedRadixSort() const { return bUsedRadix; }
+
+    /// Number of element shifts done by the last insertion sort.
+    inline size_t GetLastShiftCount() const { return LastShifts; }
+
+private:
+    ETransparentSortMode Mode = ETransparentSortMode::Auto;
+    glm::vec3 CameraPosition = glm::vec3(0.f);
+
+    std::vector<FTransparentItem> Items; ///< This frame's items in submission order
+    std::vector<uint64_t> Ids;           ///< (actor, mesh) identity per item, to detect set changes
+    std::vector<uint64_t> PreviousIds;
+    std::vector<uint32_t> Order;         ///< Indices into Items, sorted; reused from last frame when coherent
+
+    // Radix sort scratch
+    std::vector<uint32_t> RadixKeys, RadixKeysTemp;
+    std::vector<uint32_t> RadixOrderTemp;
+
+    bool bUsedRadix = false;
+    size_t LastShifts = 0;
+
+    /// Insertion sort of Order. Gives up (returns false) after maxShifts shifts.
+    bool InsertionSort(size_t maxShifts);
+    void RadixSort();
+};
@@ -5,6 +5,13 @@
 #include "Rendering/JModel.h"
 #include "Rendering/JShader.h"
 #include "glm/ext/matrix_transform.hpp"
+#include <atomic>
+
+uint64_t JActor::NextInstanceID()
+{
+    static std::atomic<uint64_t> next{ 1 };
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
 
 glm::mat4 JActor::GetModelMatrix() const
 {
@@ -17,6 +24,16 @@ glm::mat4 JActor::GetModelMatrix() const
     return model;
 }
 
+FAABB JActor::GetWorldBounds() const
+{
+    if (Model && Model->Bounds.IsValid())
+        return Model->Bounds.Transform(GetModelMatrix());
+
+    FAABB bounds;
+    bounds.Expand(Position);
+    return bounds;
+}
+
 void JActor::Draw(JShader &shader) const
 {
     shader.Use();
@@ -24,9 +41,10 @@ void JActor::Draw(JShader &shader) const
     Model->Draw(shader);
 }
 
-void JActor::DrawConfig(JShader& shader, JShader &outlineShader) const
+void JActor::DrawConfig(JShader& shader, JShader &outlineShader, bool bGeometryOutline) const
 {
-    if (Config.bDrawOutline)
+    const bool bOutline = Config.bDrawOutline && bGeometryOutline;
+    if (bOutline)
     {
         glEnable(GL_DEPTH_TEST);
         glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE); // set stencil to 1 where fragments are drawn
@@ -41,7 +59,7 @@ void JActor::DrawConfig(JShader& shader, JShader &outlineShader) const
     Draw(shader);
     glDisable(GL_CULL_FACE);
 
-    if (Config.bDrawOutline)
+    if (bOutline)
     {
         glEnable(GL_CULL_FACE);
         glCullFace(GL_FRONT); // render only backfaces
@@ -61,4 +79,18 @@ void JActor::DrawConfig(JShader& shader, JShader &outlineShader) const
         glStencilFunc(GL_ALWAYS, 0, 0xFF);
         glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
     }
-}
\ No newline at end of file
+}
+
+void JActor::DrawMesh(JShader& shader, size_t meshIndex) const
+{
+    if (Config.bBackCulling)
+    {
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+    }
+    shader.Use();
+    shader.SetMat4("u_Model", GetModelMatrix());
+    Model->Meshes[meshIndex].Draw(shader);
+    glBindVertexArray(0);
+    glDisable(GL_CULL_FACE);
+}
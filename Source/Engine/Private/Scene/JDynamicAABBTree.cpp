@@ -0,0 +1,306 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#include "JDynamicAABBTree.h"
+
+#include <cassert>
+
+namespace
+{
+    /// Fixed fattening added on every side of a proxy, in world units.
+    constexpr float kAABBMargin = 0.1f;
+
+    /// Relative fattening, so large objects don't reinsert on every small move.
+    constexpr float kAABBRelativeMargin = 0.05f;
+}
+
+JDynamicAABBTree::JDynamicAABBTree()
+{
+    Nodes.reserve(64);
+}
+
+int32_t JDynamicAABBTree::CreateProxy(const FAABB& aabb, void* userData)
+{
+    const int32_t proxyId = AllocateNode();
+
+    const glm::vec3 margin = glm::vec3(kAABBMargin) + aabb.GetExtent() * kAABBRelativeMargin;
+    FNode& node = Nodes[proxyId];
+    node.Box.Min = aabb.Min - margin;
+    node.Box.Max = aabb.Max + margin;
+    node.UserData = userData;
+    node.Height = 0;
+
+    InsertLeaf(proxyId);
+    ++ProxyCount;
+    return proxyId;
+}
+
+void JDynamicAABBTree::DestroyProxy(int32_t proxyId)
+{
+    assert(proxyId >= 0 && proxyId < static_cast<int32_t>(Nodes.size()) && Nodes[proxyId].IsLeaf());
+
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --ProxyCount;
+}
+
+bool JDynamicAABBTree::MoveProxy(int32_t proxyId, const FAABB& aabb)
+{
+    assert(proxyId >= 0 && proxyId < static_cast<int32_t>(Nodes.size()) && Nodes[proxyId].IsLeaf());
+
+    const FAABB& fat = Nodes[proxyId].Box;
+    const bool bContained = fat.Min.x <= aabb.Min.x && fat.Min.y <= aabb.Min.y && fat.Min.z <= aabb.Min.z &&
+                            aabb.Max.x <= fat.Max.x && aabb.Max.y <= fat.Max.y && aabb.Max.z <= fat.Max.z;
+    if (bContained) return false;
+
+    RemoveLeaf(proxyId);
+
+    const glm::vec3 margin = glm::vec3(kAABBMargin) + aabb.GetExtent() * kAABBRelativeMargin;
+    Nodes[proxyId].Box.Min = aabb.Min - margin;
+    Nodes[proxyId].Box.Max = aabb.Max + margin;
+
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void JDynamicAABBTree::Clear()
+{
+    Nodes.clear();
+    Root = NullNode;
+    FreeList = NullNode;
+    ProxyCount = 0;
+}
+
+float JDynamicAABBTree::GetAreaRatio() const
+{
+    if (Root == NullNode) return 0.f;
+
+    const float rootArea = SurfaceArea(Nodes[Root].Box);
+    if (rootArea <= 0.f) return 0.f;
+
+    float totalArea = 0.f;
+    for (const FNode& node : Nodes)
+        if (node.Height > 0) totalArea += SurfaceArea(node.Box);
+
+    return totalArea / rootArea;
+}
+
+// --------------------- Node Pool ---------------------
+int32_t JDynamicAABBTree::AllocateNode()
+{
+    if (FreeList == NullNode)
+    {
+        Nodes.emplace_back();
+        return static_cast<int32_t>(Nodes.size()) - 1;
+    }
+
+    const int32_t nodeId = FreeList;
+    FreeList = Nodes[nodeId].Parent;
+    Nodes[nodeId] = FNode();
+    return nodeId;
+}
+
+void JDynamicAABBTree::FreeNode(int32_t nodeId)
+{
+    Nodes[nodeId] = FNode();
+    Nodes[nodeId].Parent = FreeList;
+    FreeList = nodeId;
+}
+
+// --------------------- Tree Maintenance ---------------------
+void JDynamicAABBTree::InsertLeaf(int32_t leaf)
+{
+    if (Root == NullNode)
+    {
+        Root = leaf;
+        Nodes[Root].Parent = NullNode;
+        return;
+    }
+
+    // Descend towards the cheapest sibling. Creating a parent over a node costs the combined area,
+    // and every ancestor grows by the increase of its own area (surface area heuristic)
+    const FAABB leafBox = Nodes[leaf].Box;
+    int32_t index = Root;
+    while (!Nodes[index].IsLeaf())
+    {
+        const FNode& node = Nodes[index];
+        const float area = SurfaceArea(node.Box);
+        const float combinedArea = SurfaceArea(Combine(node.Box, leafBox));
+
+        // Cost of pairing the leaf with this node right here
+        const float cost = 2.f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down
+        const float inheritanceCost = 2.f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child)
+        {
+            const FAABB combined = Combine(leafBox, Nodes[child].Box);
+            if (Nodes[child].IsLeaf())
+                return SurfaceArea(combined) + inheritanceCost;
+            return SurfaceArea(combined) - SurfaceArea(Nodes[child].Box) + inheritanceCost;
+        };
+
+        const float cost1 = descendCost(node.Child1);
+        const float cost2 = descendCost(node.Child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.Child1 : node.Child2;
+    }
+
+    // Create a new parent for the sibling and the leaf
+    const int32_t sibling = index;
+    const int32_t oldParent = Nodes[sibling].Parent;
+    const int32_t newParent = AllocateNode();
+
+    Nodes[newParent].Parent = oldParent;
+    Nodes[newParent].Box = Combine(leafBox, Nodes[sibling].Box);
+    Nodes[newParent].Height = Nodes[sibling].Height + 1;
+    Nodes[newParent].Child1 = sibling;
+    Nodes[newParent].Child2 = leaf;
+    Nodes[sibling].Parent = newParent;
+    Nodes[leaf].Parent = newParent;
+
+    if (oldParent != NullNode)
+    {
+        if (Nodes[oldParent].Child1 == sibling) Nodes[oldParent].Child1 = newParent;
+        else Nodes[oldParent].Child2 = newParent;
+    }
+    else
+    {
+        Root = newParent;
+    }
+
+    // Walk back up refitting boxes and rotating unbalanced nodes
+    index = Nodes[leaf].Parent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        FNode& node = Nodes[index];
+        node.Height = 1 + std::max(Nodes[node.Child1].Height, Nodes[node.Child2].Height);
+        node.Box = Combine(Nodes[node.Child1].Box, Nodes[node.Child2].Box);
+
+        index = node.Parent;
+    }
+}
+
+void JDynamicAABBTree::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == Root)
+    {
+        Root = NullNode;
+        return;
+    }
+
+    const int32_t parent = Nodes[leaf].Parent;
+    const int32_t grandParent = Nodes[parent].Parent;
+    const int32_t sibling = Nodes[parent].Child1 == leaf ? Nodes[parent].Child2 : Nodes[parent].Child1;
+
+    if (grandParent == NullNode)
+    {
+        Root = sibling;
+        Nodes[sibling].Parent = NullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // Replace the parent by the sibling, then refit the ancestors
+    if (Nodes[grandParent].Child1 == parent) Nodes[grandParent].Child1 = sibling;
+    else Nodes[grandParent].Child2 = sibling;
+    Nodes[sibling].Parent = grandParent;
+    FreeNode(parent);
+
+    int32_t index = grandParent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        FNode& node = Nodes[index];
+        node.Box = Combine(Nodes[node.Child1].Box, Nodes[node.Child2].Box);
+        node.Height = 1 + std::max(Nodes[node.Child1].Height, Nodes[node.Child2].Height);
+
+        index = node.Parent;
+    }
+}
+
+int32_t JDynamicAABBTree::Balance(int32_t iA)
+{
+    FNode& A = Nodes[iA];
+    if (A.IsLeaf() || A.Height < 2) return iA;
+
+    const int32_t iB = A.Child1;
+    const int32_t iC = A.Child2;
+    FNode& B = Nodes[iB];
+    FNode& C = Nodes[iC];
+
+    const int32_t balance = C.Height - B.Height;
+
+    // Rotate the taller child up. With X the taller child of A and Y its other sibling, X takes A's
+    // place and A keeps X's shorter child, so the heavier grandchild moves one level closer to the root
+    auto rotateUp = [this, iA](int32_t iX, int32_t iY)
+    {
+        FNode& A = Nodes[iA];
+        FNode& X = Nodes[iX];
+        const int32_t iF = X.Child1;
+        const int32_t iG = X.Child2;
+        FNode& F = Nodes[iF];
+        FNode& G = Nodes[iG];
+
+        // Swap A and X
+        X.Child1 = iA;
+        X.Parent = A.Parent;
+        A.Parent = iX;
+
+        if (X.Parent != NullNode)
+        {
+            if (Nodes[X.Parent].Child1 == iA) Nodes[X.Parent].Child1 = iX;
+            else Nodes[X.Parent].Child2 = iX;
+        }
+        else
+        {
+            Root = iX;
+        }
+
+        // X's taller child stays under X, the shorter one replaces X under A
+        const bool bFTaller = F.Height > G.Height;
+        const int32_t iTall = bFTaller ? iF : iG;
+        const int32_t iShort = bFTaller ? iG : iF;
+
+        X.Child2 = iTall;
+        if (A.Child1 == iX) A.Child1 = iShort;
+        else A.Child2 = iShort;
+        Nodes[iShort].Parent = iA;
+
+        A.Box = Combine(Nodes[iY].Box, Nodes[iShort].Box);
+        A.Height = 1 + std::max(Nodes[iY].Height, Nodes[iShort].Height);
+        X.Box = Combine(A.Box, Nodes[iTall].Box);
+        X.Height = 1 + std::max(A.Height, Nodes[iTall].Height);
+        return iX;
+    };
+
+    if (balance > 1) return rotateUp(iC, iB);
+    if (balance < -1) return rotateUp(iB, iC);
+    return iA;
+}
+
+// --------------------- Internal Helpers ---------------------
+FAABB JDynamicAABBTree::Combine(const FAABB& a, const FAABB& b)
+{
+    FAABB result;
+    result.Min = glm::min(a.Min, b.Min);
+    result.Max = glm::max(a.Max, b.Max);
+    return result;
+}
+
+float JDynamicAABBTree::SurfaceArea(const FAABB& box)
+{
+    const glm::vec3 size = box.Max - box.Min;
+    return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool JDynamicAABBTree::Overlaps(const FAABB& a, const FAABB& b)
+{
+    return a.Min.x <= b.Max.x && b.Min.x <= a.Max.x &&
+           a.Min.y <= b.Max.y && b.Min.y <= a.Max.y &&
+           a.Min.z <= b.Max.z && b.Min.z <= a.Max.z;
+}
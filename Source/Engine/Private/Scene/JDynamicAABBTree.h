@@ -0,0 +1,285 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <utility>
+#include <vector>
+#include "../Core/Math/FAABB.h"
+#include "../Core/Math/FFrustum.h"
+
+/**
+ * @class JDynamicAABBTree
+ * @brief Incrementally maintained bounding volume hierarchy over moving boxes.
+ *
+ * Each object is a leaf (a "proxy") holding a fat AABB: its tight bounds grown by a small
+ * margin. Objects that move inside their fat box do not touch the tree at all; only when
+ * they leave it is the leaf removed and reinserted.
+ *
+ * Insertion walks down from the root choosing, at every node, the child whose surface
+ * area grows the least (surface area heuristic), and the path back up is rebalanced with
+ * AVL-style tree rotations so the height stays logarithmic whatever the insertion order.
+ *
+ * Queries visit only the subtrees whose boxes overlap the query volume. Callbacks receive
+ * the proxy id and return false to stop the query early (ray casts return a new max distance
+ * instead, see RayCast()).
+ *
+ * Example usage:
+ * @code
+ * int32_t proxy = tree.CreateProxy(actor.GetWorldBounds(), &actor);
+ * tree.MoveProxy(proxy, actor.GetWorldBounds());
+ * tree.QueryFrustum(frustum, [&](int32_t id) { visible.push_back(tree.GetUserData(id)); return true; });
+ * @endcode
+ */
+class JDynamicAABBTree {
+public:
+    static constexpr int32_t NullNode = -1;
+
+    JDynamicAABBTree();
+
+    /**
+     * @brief Insert a new object.
+     * @param aabb Tight world-space bounds.
+     * @param userData Opaque pointer returned by GetUserData().
+     * @return Proxy id, stable until DestroyProxy().
+     */
+    int32_t CreateProxy(const FAABB& aabb, void* userData);
+
+    /// Remove an object from the tree. The id may be reused by later proxies.
+    void DestroyProxy(int32_t proxyId);
+
+    /**
+     * @brief Update an object's bounds.
+     * @return true if the object left its fat AABB and was reinserted.
+     */
+    bool MoveProxy(int32_t proxyId, const FAABB& aabb);
+
+    /// Drop every proxy.
+    void Clear();
+
+    inline void* GetUserData(int32_t proxyId) const { return Nodes[proxyId].UserData; }
+    inline const FAABB& GetFatAABB(int32_t proxyId) const { return Nodes[proxyId].Box; }
+
+    /// Height of the tree, 0 for a single leaf.
+    inline int32_t GetHeight() const { return Root == NullNode ? 0 : Nodes[Root].Height; }
+    inline int32_t GetProxyCount() const { return ProxyCount; }
+
+    /// Sum of internal node areas over root area. Lower means a tighter tree.
+    float GetAreaRatio() const;
+
+    /// Calls callback(proxyId) for every fat AABB that intersects the frustum.
+    template<typename TCallback>
+    void QueryFrustum(const FFrustum& frustum, TCallback&& callback) const;
+
+    /// Calls callback(proxyId) for every fat AABB that overlaps the box.
+    template<typename TCallback>
+    void QueryBox(const FAABB& box, TCallback&& callback) const;
+
+    /// Calls callback(proxyId) for every fat AABB that overlaps the sphere.
+    template<typename TCallback>
+    void QuerySphere(const glm::vec3& center, float radius, TCallback&& callback) const;
+
+    /**
+     * @brief Walk the leaves whose fat AABB the ray crosses, nearest subtrees first.
+     * @param origin Ray origin.
+     * @param direction Normalized ray direction.
+     * @param maxDistance Length of the ray.
+     * @param callback Called as callback(proxyId, maxDistance) and returns the new max distance:
+     *        the hit distance to clip the ray, 0 to stop, or the input value to ignore the proxy.
+     */
+    template<typename TCallback>
+    void RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TCallback&& callback) const;
+
+    /**
+     * @brief Slab test of a ray against a box.
+     * @param inverse 1 / direction per axis, precomputed by the caller.
+     * @return Distance at which the ray enters the box (0 if it starts inside), -1 if it misses it
+     *         within maxDistance.
+     */
+    static inline float RayEntryDistance(const FAABB& box, const glm::vec3& origin, const glm::vec3& direction,
+                                         const glm::vec3& inverse, float maxDistance)
+    {
+        float enter = 0.f, exit = maxDistance;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            // Parallel to the slabs: 0 * inf is NaN when the origin lies on one, test the origin instead
+            if (direction[axis] == 0.f)
+            {
+                if (origin[axis] < box.Min[axis] || origin[axis] > box.Max[axis]) return -1.f;
+                continue;
+            }
+
+            float t0 = (box.Min[axis] - origin[axis]) * inverse[axis];
+            float t1 = (box.Max[axis] - origin[axis]) * inverse[axis];
+            if (t0 > t1) std::swap(t0, t1);
+            enter = std::max(enter, t0);
+            exit = std::min(exit, t1);
+        }
+        return enter <= exit ? enter : -1.f;
+    }
+
+private:
+    struct FNode
+    {
+        FAABB Box;
+        void* UserData = nullptr;
+        int32_t Parent = NullNode; ///< Next free node while on the free list
+        int32_t Child1 = NullNode;
+        int32_t Child2 = NullNode;
+        int32_t Height = -1;       ///< 0 for leaves, -1 for free nodes
+
+        inline bool IsLeaf() const { return Child1 == NullNode; }
+    };
+
+    std::vector<FNode> Nodes;
+    int32_t Root = NullNode;
+    int32_t FreeList = NullNode;
+    int32_t ProxyCount = 0;
+
+    /// Traversal stack reused by queries, so queries are not reentrant and run on one thread at a time.
+    mutable std::vector<int32_t> Stack;
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t nodeId);
+
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+
+    /// Rotate the subtree at nodeId if its children's heights differ by more than one. Returns the new subtree root.
+    int32_t Balance(int32_t nodeId);
+
+    static FAABB Combine(const FAABB& a, const FAABB& b);
+    static float SurfaceArea(const FAABB& box);
+    static bool Overlaps(const FAABB& a, const FAABB& b);
+};
+
+// --------------------- Query Templates ---------------------
+template<typename TCallback>
+void JDynamicAABBTree::QueryFrustum(const FFrustum& frustum, TCallback&& callback) const
+{
+    if (Root == NullNode) return;
+
+    Stack.clear();
+    Stack.push_back(Root);
+    while (!Stack.empty())
+    {
+        const int32_t nodeId = Stack.back();
+        Stack.pop_back();
+        const FNode& node = Nodes[nodeId];
+
+        if (!frustum.Intersects(node.Box)) continue;
+
+        if (node.IsLeaf())
+        {
+            if (!callback(nodeId)) return;
+        }
+        else
+        {
+            Stack.push_back(node.Child1);
+            Stack.push_back(node.Child2);
+        }
+    }
+}
+
+template<typename TCallback>
+void JDynamicAABBTree::QueryBox(const FAABB& box, TCallback&& callback) const
+{
+    if (Root == NullNode) return;
+
+    Stack.clear();
+    Stack.push_back(Root);
+    while (!Stack.empty())
+    {
+        const int32_t nodeId = Stack.back();
+        Stack.pop_back();
+        const FNode& node = Nodes[nodeId];
+
+        if (!Overlaps(node.Box, box)) continue;
+
+        if (node.IsLeaf())
+        {
+            if (!callback(nodeId)) return;
+        }
+        else
+        {
+            Stack.push_back(node.Child1);
+            Stack.push_back(node.Child2);
+        }
+    }
+}
+
+template<typename TCallback>
+void JDynamicAABBTree::QuerySphere(const glm::vec3& center, float radius, TCallback&& callback) const
+{
+    if (Root == NullNode) return;
+
+    const float radiusSq = radius * radius;
+
+    Stack.clear();
+    Stack.push_back(Root);
+    while (!Stack.empty())
+    {
+        const int32_t nodeId = Stack.back();
+        Stack.pop_back();
+        const FNode& node = Nodes[nodeId];
+
+        // Squared distance from the center to the closest point of the box
+        const glm::vec3 closest = glm::max(node.Box.Min, glm::min(center, node.Box.Max));
+        const glm::vec3 delta = closest - center;
+        if (glm::dot(delta, delta) > radiusSq) continue;
+
+        if (node.IsLeaf())
+        {
+            if (!callback(nodeId)) return;
+        }
+        else
+        {
+            Stack.push_back(node.Child1);
+            Stack.push_back(node.Child2);
+        }
+    }
+}
+
+template<typename TCallback>
+void JDynamicAABBTree::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                               TCallback&& callback) const
+{
+    if (Root == NullNode) return;
+
+    const glm::vec3 inverse(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+    auto entryDistance = [&](const FAABB& box, float limit)
+    {
+        return RayEntryDistance(box, origin, direction, inverse, limit);
+    };
+
+    Stack.clear();
+    Stack.push_back(Root);
+    while (!Stack.empty())
+    {
+        const int32_t nodeId = Stack.back();
+        Stack.pop_back();
+        const FNode& node = Nodes[nodeId];
+
+        if (entryDistance(node.Box, maxDistance) < 0.f) continue;
+
+        if (node.IsLeaf())
+        {
+            maxDistance = callback(nodeId, maxDistance);
+            if (maxDistance <= 0.f) return;
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited first and clips the ray sooner
+        const float d1 = entryDistance(Nodes[node.Child1].Box, maxDistance);
+        const float d2 = entryDistance(Nodes[node.Child2].Box, maxDistance);
+        if (d1 >= 0.f && d2 >= 0.f)
+        {
+            Stack.push_back(d1 < d2 ? node.Child2 : node.Child1);
+            Stack.push_back(d1 < d2 ? node.Child1 : node.Child2);
+        }
+        else if (d1 >= 0.f) Stack.push_back(node.Child1);
+        else if (d2 >= 0.f) Stack.push_back(node.Child2);
+    }
+}
@@ -2,14 +2,17 @@
 
 #include "Scene/JScene.h"
 #include "Scene/JActor.h"
+#include "Scene/JDynamicAABBTree.h"
 
 using json = nlohmann::json;
 
 JScene::JScene(const std::string &name):
-m_Name(name), m_NextActorID(1)
+m_Name(name), m_NextActorID(1), m_SpatialTree(std::make_unique<JDynamicAABBTree>())
 {
 }
 
+JScene::~JScene() = default;
+
 void JScene::SetName(const std::string &name)
 {
     m_Name = name;
@@ -46,6 +49,9 @@ bool JScene::RemoveActor(unsigned int id)
     JActor* actorPtr = it->second;
     size_t idx = actorPtr->m_VectorIndex;
 
+    if (actorPtr->m_ProxyID != JDynamicAABBTree::NullNode)
+        m_SpatialTree->DestroyProxy(actorPtr->m_ProxyID);
+
     // Swap with last element and pop back
     if(idx != m_Actors.size() - 1)
     {
@@ -103,6 +109,7 @@ void JScene::Deserialize(const nlohmann::json &data)
 
     m_Actors.clear();
     m_ActorsByID.clear();
+    m_SpatialTree->Clear();
 
     if (data.contains("actors")) // Loading it
     {
@@ -127,6 +134,63 @@ void JScene::Deserialize(const nlohmann::json &data)
 void JScene::AddActorToList(std::unique_ptr<JActor> actor)
 {
     actor->m_VectorIndex = m_Actors.size(); // track index
+    actor->m_ProxyID = m_SpatialTree->CreateProxy(actor->GetWorldBounds(), actor.get());
     m_ActorsByID[actor->ID] = actor.get();
     m_Actors.push_back(std::move(actor));
 }
+
+void JScene::UpdateActorBounds(JActor* actor)
+{
+    if (!actor || actor->m_ProxyID == JDynamicAABBTree::NullNode) return;
+    m_SpatialTree->MoveProxy(actor->m_ProxyID, actor->GetWorldBounds());
+}
+
+// -------------------- Spatial Queries --------------------
+void JScene::QueryActorsInFrustum(const FFrustum& frustum, std::vector<JActor*>& outActors) const
+{
+    m_SpatialTree->QueryFrustum(frustum, [&](int32_t proxyId)
+    {
+        outActors.push_back(static_cast<JActor*>(m_SpatialTree->GetUserData(proxyId)));
+        return true;
+    });
+}
+
+void JScene::QueryActorsInBox(const FAABB& box, std::vector<JActor*>& outActors) const
+{
+    m_SpatialTree->QueryBox(box, [&](int32_t proxyId)
+    {
+        outActors.push_back(static_cast<JActor*>(m_SpatialTree->GetUserData(proxyId)));
+        return true;
+    });
+}
+
+void JScene::QueryActorsInSphere(const glm::vec3& center, float radius, std::vector<JActor*>& outActors) const
+{
+    m_SpatialTree->QuerySphere(center, radius, [&](int32_t proxyId)
+    {
+        outActors.push_back(static_cast<JActor*>(m_SpatialTree->GetUserData(proxyId)));
+        return true;
+    });
+}
+
+JActor* JScene::RayCastActors(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                              float* outDistance) const
+{
+    JActor* closest = nullptr;
+    const glm::vec3 inverse(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+
+    m_SpatialTree->RayCast(origin, direction, maxDistance, [&](int32_t proxyId, float limit)
+    {
+        // The tree only tested the fat box, refine against the actor's actual bounds
+        auto* actor = static_cast<JActor*>(m_SpatialTree->GetUserData(proxyId));
+        const float enter = JDynamicAABBTree::RayEntryDistance(actor->GetWorldBounds(), origin, direction,
+                                                                inverse, limit);
+        if (enter < 0.f) return limit;
+
+        closest = actor;
+        if (outDistance) *outDistance = enter;
+        return enter; // clip the ray so only nearer actors are considered from now on
+    });
+
+    return closest;
+}
@@ -15,3 +15,6 @@ inline PostProcessManager* GetPostProcessManager()
 {
     return (GEngine) ? GEngine->GetService<PostProcessManager>() : nullptr;
 }
+
+// Defined with the globals, JJobSystem is private to the engine
+JJobSystem* GetJobSystem();
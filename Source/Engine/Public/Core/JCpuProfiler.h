@@ -0,0 +1,180 @@
+//  Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Set to 0 to compile every zone out
+#ifndef J_ENABLE_PROFILER
+#define J_ENABLE_PROFILER 1
+#endif
+
+/// One finished zone. Times are in JCpuProfiler ticks, see JCpuProfiler::ToMicroseconds().
+struct FCpuZoneEvent
+{
+    const char* Name = nullptr; ///< Static string given to the zone
+    uint64_t Begin = 0;
+    uint64_t End = 0;
+    uint32_t Thread = 0;        ///< Index into JCpuProfiler::GetThreadNames()
+    uint32_t Depth = 0;         ///< Zones open on the thread when this one began
+};
+
+/**
+ * @class JCpuProfiler
+ * @brief Records scoped CPU zones from every thread, for a timeline and Chrome trace captures.
+ *
+ * Zones are declared with J_PROFILE_SCOPE("Name") or J_PROFILE_FUNCTION(). While recording is
+ * off (the default), a zone costs one relaxed atomic load; while it is on, a timestamp (rdtsc
+ * where available, steady_clock elsewhere) at each end and one event written to a ring owned by
+ * the calling thread. Rings are single-producer single-consumer and lock-free: the thread
+ * appends, BeginFrame() on the main thread drains. A full ring drops events and counts them.
+ *
+ * BeginFrame() keeps the events drained in the previous frame for the timeline
+ * (GetFrameEvents()). RequestCapture() records the next frames and writes them as a Chrome trace
+ * (chrome://tracing, ui.perfetto.dev), turning recording on for the duration if needed.
+ *
+ * Zone names must outlive the profiler: use string literals. A thread's ring (RingCapacity
+ * events) is allocated by its first recorded zone and kept until exit.
+ *
+ * Typical usage:
+ * @code
+ * void SceneManager::Update(float deltaTime)
+ * {
+ *     J_PROFILE_SCOPE("SceneManager::Update");
+ *     // ...
+ * }
+ * // ... once per frame, on the main thread
+ * JCpuProfiler::Get().BeginFrame();
+ * // ... on demand
+ * JCpuProfiler::Get().RequestCapture("Captures/Trace.json", 120);
+ * @endcode
+ */
+class JCpuProfiler {
+public:
+    /// Events a thread can hold between two BeginFrame().
+    static constexpr size_t RingCapacity = 16384;
+
+    /// Most frames a single capture may hold.
+    static constexpr int MaxCaptureFrames = 1000;
+
+    static JCpuProfiler& Get();
+
+    /// True while zones are recorded. Inline, it is all a disabled zone executes.
+    static inline bool IsRecording() { return bRecording.load(std::memory_order_relaxed); }
+
+    /// Current time in ticks.
+    static uint64_t Now();
+
+    /// Called by zones when recording, enters a zone on this thread and returns its begin time.
+    static uint64_t BeginZone();
+
+    /// Called by zones that began while recording.
+    static void EndZone(const char* name, uint64_t begin);
+
+    /** @brief Drain every thread's ring into this frame's events and advance a running capture. */
+    void BeginFrame();
+
+    /** @brief Start or stop recording zones. A pending capture keeps recording on until it is written. */
+    void SetEnabled(bool bEnable);
+    inline bool IsEnabled() const { return bEnabled; }
+
+    /**
+     * @brief Record the next frames and write them as Chrome trace JSON.
+     * @param path Output file, parent directories are created.
+     * @param frames Frames to capture, clamped to [1, MaxCaptureFrames].
+     */
+    void RequestCapture(const std::string& path, int frames);
+    inline bool IsCapturing() const { return CaptureFramesLeft > 0; }
+
+    /** @brief Name the calling thread in the timeline and traces. Cheap, the ring waits for the first zone. */
+    void SetThreadName(const std::string& name);
+
+    /// Events that ended during the previous frame, sorted by thread then begin time.
+    inline const std::vector<FCpuZoneEvent>& GetFrameEvents() const { return FrameEvents; }
+    inline uint64_t GetFrameBegin() const { return FrameBegin; }
+    inline uint64_t GetFrameEnd() const { return FrameEnd; }
+
+    /// Names of the threads that recorded at least one zone, by FCpuZoneEvent::Thread.
+    std::vector<std::string> GetThreadNames() const;
+
+    /// Events lost to full rings since the profiler started.
+    uint64_t GetDroppedEvents() const;
+
+    /// Ticks to microseconds, calibrated against steady_clock.
+    double ToMicroseconds(uint64_t ticks) const;
+
+    /// Path of the last trace written, empty before the first one.
+    inline const std::string& GetLastCapturePath() const { return LastCapturePath; }
+
+private:
+    struct FThreadRing;
+
+    JCpuProfiler();
+    ~JCpuProfiler();
+
+    static std::atomic<bool> bRecording;
+    static thread_local FThreadRing* ThreadRing; ///< Ring of the calling thread, created on its first zone
+
+    bool bEnabled = false;
+    mutable std::mutex RingsMutex; ///< Guards Rings against threads registering
+    std::vector<std::unique_ptr<FThreadRing>> Rings;
+
+    std::vector<FCpuZoneEvent> FrameEvents;
+    uint64_t FrameBegin = 0;
+    uint64_t FrameEnd = 0;
+
+    std::string CapturePath;
+    std::string LastCapturePath;
+    int CaptureFramesLeft = 0;
+    std::vector<FCpuZoneEvent> CaptureEvents;
+
+    // Tick rate, measured between construction and the latest BeginFrame()
+    uint64_t CalibrationTicks = 0;
+    int64_t CalibrationNanoseconds = 0;
+    double MicrosecondsPerTick = 0.001;
+
+    FThreadRing& GetThreadRing();
+    void UpdateRecording();
+    void UpdateCalibration();
+    void WriteCapture();
+};
+
+/**
+ * @class JCpuZone
+ * @brief Records its scope as a zone of JCpuProfiler while recording is on.
+ */
+class JCpuZone {
+public:
+    explicit JCpuZone(const char* name) : Name(name)
+    {
+        if (JCpuProfiler::IsRecording()) Begin = JCpuProfiler::BeginZone();
+    }
+    ~JCpuZone()
+    {
+        if (Begin) JCpuProfiler::EndZone(Name, Begin);
+    }
+
+    JCpuZone(const JCpuZone&) = delete;
+    JCpuZone& operator=(const JCpuZone&) = delete;
+
+private:
+    const char* Name;
+    uint64_t Begin = 0; ///< 0 if the zone began while recording was off
+};
+
+#define J_PROFILE_CONCAT_INNER(a, b) a##b
+#define J_PROFILE_CONCAT(a, b) J_PROFILE_CONCAT_INNER(a, b)
+
+#if J_ENABLE_PROFILER
+#define J_PROFILE_SCOPE(name) const JCpuZone J_PROFILE_CONCAT(ProfileZone, __LINE__)(name)
+#define J_PROFILE_FUNCTION() J_PROFILE_SCOPE(__func__)
+#else
+#define J_PROFILE_SCOPE(name) ((void)0)
+#define J_PROFILE_FUNCTION() ((void)0)
+#endif
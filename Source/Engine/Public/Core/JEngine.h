@@ -6,6 +6,7 @@
 
 class SceneManager;
 class PostProcessManager;
+class JJobSystem;
 class EditorContext;
 
 class JEngine
@@ -44,7 +45,7 @@ public:
     void OnKeyboardAction(GLFWwindow* window, int key, int scancode, int action, int mods);
 
 private:
-    JEngine() {}
+    JEngine(); // Points GEngine at the instance, so the globals work whichever loop drives the engine
     ~JEngine() = default;
 
     EngineState m_State;
@@ -2,21 +2,34 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <memory>
 
+class JColorLUT;
 class JFramebufferTarget;
+class JGpuProfiler;
+class JJobSystem;
 class JPostProcessor;
+class JRenderGraph;
+class JRenderTargetPool;
+struct FColorOp;
+struct FRenderGraphStats;
+struct FRGTextureDesc;
+enum class EPostResolution : uint8_t;
 
 /**
  * @class PostProcessManager
- * @brief Manages a chain of post-processing effects using internal ping-pong targets.
+ * @brief Manages a chain of post-processing effects on top of a JRenderGraph.
  *
  * PostProcessManager allows you to register multiple post-process effects (shaders)
- * and applies them sequentially to a rendered scene. It handles all framebuffer
- * management internally using a ping-pong technique: two offscreen render targets
- * alternate as the destination of each pass, and the output of one pass becomes
- * the input of the next.
+ * and applies them sequentially to a rendered scene. Every frame the chain is declared
+ * as render graph passes, each writing a transient texture read by the next one. The
+ * graph aliases those textures onto pooled targets, so a chain of any length runs in two
+ * ping-pong sized targets, and the memory goes back to the pool for other graph users.
+ * Passing the (multi-sampled) scene target itself lets the graph resolve it into pooled
+ * memory as well.
  *
  * Example usage:
  * @code
@@ -30,11 +43,44 @@ class JPostProcessor;
  * renderer.EndScene();
  *
  * // Apply post-processing
- * ppm.ApplyChain(renderer.GetSceneTargetTexture(), screenWidth, screenHeight);
+ * ppm.ApplyChain(renderer.GetSceneTarget(), screenWidth, screenHeight);
  * @endcode
  *
+ * Before the first ApplyChain() after the chain changed, the chain is compiled into passes:
+ * passthrough effects (JPostProcessor::IsPassthrough(), e.g. a blur of radius 0) are dropped,
+ * the chain recompiling whenever one of them toggles, and runs of fusable effects (EPostEffectKind::PointWise,
+ * plus at most one EPostEffectKind::Sampling effect per run) are merged into one generated
+ * fragment shader that applies them back to back in registers. Only plain
+ * EPostEffectKind::Pass effects (blurs, kernels, distortions) break a run, so the number of
+ * fullscreen reads and writes grows with those effects rather than with the chain length.
+ * The last pass writes straight to the default framebuffer.
+ *
+ * Consecutive color-only effects with a CPU mirror in JColorLUT (Grayscale, ColorInverter,
+ * Posterize) are replaced by a single ColorLUT stage first: the chain is baked into a 3D LUT
+ * whenever one of their parameters changes, and applied with one lookup per pixel.
+ *
+ * EPostEffectKind::MultiPass effects (e.g. JBlurProcessor) declare their own graph passes
+ * between the chain's input and output textures, with any intermediate levels they need.
+ *
+ * Effects with a reduced resolution (JPostProcessor::SetResolution()) render into targets of
+ * that size. Consecutive passes at the same reduced resolution form a segment: its input is
+ * box-filtered down once on entry, and a joint bilateral upsample guided by the input at both
+ * resolutions brings the result back to full resolution on exit, so edges of the scene
+ * stay sharp. Runs are only fused between effects of the same resolution.
+ *
+ * The chain runs at the size of its input. When that is smaller than the screen (dynamic
+ * resolution, see JDynamicResolution), the last pass writes a transient texture and a
+ * Catmull-Rom upscale brings it to the default framebuffer.
+ *
+ * With a JGpuProfiler set (SetGpuProfiler()), every graph pass is timed: chain passes under the
+ * names of their effects ("Chroma + CRTScanline" for a fused one), plus the scene resolve,
+ * downsamples, upsamples and the upscale.
+ *
+ * Uniform values set on a fused effect's own shader (JPostProcessor::GetShader()) are
+ * mirrored into the generated shader before every pass.
+ *
  * Features:
- * - Automatic ping-pong framebuffer handling for chaining effects.
+ * - Automatic ping-pong framebuffer handling for chaining effects, through the render graph.
  * - Easy addition of new post-processing passes.
  * - Resizable internal targets to match dynamic screen resolutions.
  * - Safe fallback: if no processors are registered, it draws the input texture directly.
@@ -45,10 +91,13 @@ public:
      * @brief Construct a new PostProcessManager.
      * @param width Initial width of internal render targets in pixels.
      * @param height Initial height of internal render targets in pixels.
+     * @param targetPool Pool for the intermediate targets, typically JRenderer::GetTargetPool() so
+     *        that targets freed by a resize are shared. Must outlive the manager. Null uses a private one.
      *
-     * Initializes internal ping-pong render targets.
+     * Intermediate targets are allocated by the render graph on first use.
      */
-    PostProcessManager(int width, int height);
+    PostProcessManager(int width, int height, JRenderTargetPool* targetPool = nullptr);
+    ~PostProcessManager();
 
     /**
      * @brief Add a post-processing effect to the chain.
@@ -60,31 +109,119 @@ public:
 
     /**
      * @brief Apply all registered post-processing effects.
-     * @param inputTexture Texture ID of the source image (usually the scene render).
+     * @param inputTexture Texture ID of the source image (usually the scene render), of the size given to Resize().
      * @param screenWidth Current screen width in pixels.
      * @param screenHeight Current screen height in pixels.
+     * @param jobs Optional job system, used to re-bake color LUTs in parallel.
      *
      * Each processor is applied in order. Internally, ping-pong render targets
      * are used to avoid overwriting input textures. After the last pass, the
      * result is drawn to the default framebuffer.
      */
-    void ApplyChain(unsigned int inputTexture, int screenWidth, int screenHeight);
+    void ApplyChain(unsigned int inputTexture, int screenWidth, int screenHeight, JJobSystem* jobs = nullptr);
 
     /**
-     * @brief Resize internal ping-pong render targets.
+     * @brief Apply the chain to a render target, resolving it first if it is multi-sampled.
+     * @param inputTarget Source target (usually JRenderer::GetSceneTarget()).
+     * @param screenWidth Current screen width in pixels.
+     * @param screenHeight Current screen height in pixels.
+     * @param jobs Optional job system, used to re-bake color LUTs in parallel.
+     */
+    void ApplyChain(JFramebufferTarget& inputTarget, int screenWidth, int screenHeight, JJobSystem* jobs = nullptr);
+
+    /**
+     * @brief Resize the intermediate render targets.
      * @param newWidth New width in pixels.
      * @param newHeight New height in pixels.
      *
      * Call this when the screen resolution changes to ensure correct
-     * post-processing behavior.
+     * post-processing behavior. Targets of the old size return to the graph's pool
+     * and are released once unused for a few frames.
      */
     void Resize(int newWidth, int newHeight);
 
+    /// Chain passes per frame, a multi-pass effect counting as one.
+    inline int GetPassCount() const { return static_cast<int>(Passes.size()); }
+
+    /// Registered effects, including the dropped passthrough ones.
+    inline int GetEffectCount() const { return static_cast<int>(Processors.size()); }
+
+    /// Pass, resolve and memory counters of the last frame's graph.
+    const FRenderGraphStats& GetGraphStats() const;
+
+    /// Time the graph's passes on profiler (typically JRenderer::GetGpuProfiler()), null to stop.
+    void SetGpuProfiler(JGpuProfiler* profiler);
+
 private:
+    /// Copies one uniform of a fused effect's own program into the generated program.
+    struct FUniformLink
+    {
+        unsigned int SourceProgram = 0;
+        size_t Effect = 0;                     ///< Index of the source effect in FChainPass::Effects
+        int SourceLocation = -1;
+        int TargetLocation = -1;
+        unsigned int Type = 0;
+    };
+
+    /// Run of color-only effects baked into one LUT.
+    struct FColorLUTStage
+    {
+        std::unique_ptr<JPostProcessor> Processor; ///< PostProcess/ColorLUT
+        std::unique_ptr<JColorLUT> LUT;
+        std::vector<JPostProcessor*> Effects;      ///< Baked effects, in chain order
+        std::vector<FColorOp> Ops;                 ///< Scratch, current parameters of Effects
+    };
+
+    /// One fullscreen pass of the compiled chain.
+    struct FChainPass
+    {
+        JPostProcessor* Processor = nullptr;   ///< Registered processor, or Fused
+        std::unique_ptr<JPostProcessor> Fused; ///< Generated uber-shader of a fused run
+        std::string Name;                      ///< Effect names, the pass' name in the graph
+        std::vector<FUniformLink> Uniforms;    ///< Effect uniforms mirrored into Fused
+        std::vector<JPostProcessor*> Effects;  ///< Fused effects, in chain order
+        std::vector<uint64_t> Revisions;       ///< JShader::GetRevision() of each effect at the last mirror
+        FColorLUTStage* ColorStage = nullptr;  ///< LUT the pass reads, if any
+        EPostResolution Resolution{1};         ///< EPostResolution::Full
+    };
+
     std::vector<std::unique_ptr<JPostProcessor>> Processors; ///< Registered post-process effects.
+    std::vector<FChainPass> Passes;                          ///< Compiled chain.
+    std::vector<std::unique_ptr<FColorLUTStage>> ColorStages; ///< LUT stages of the compiled chain.
+    bool bChainDirty = true;                                 ///< Processors changed since the last compile.
+    std::vector<bool> DroppedProcessors;                     ///< IsPassthrough() of each processor at the last compile.
     int Width;  ///< Current width of internal render targets.
     int Height; ///< Current height of internal render targets.
+    int ChainWidth;  ///< Size of this frame's input, which the chain runs at
+    int ChainHeight;
+
+    std::unique_ptr<JRenderGraph> Graph; ///< Rebuilt every frame, owns the pooled intermediate targets.
+    std::unique_ptr<JPostProcessor> Passthrough; ///< Draws the input when the chain compiles to nothing.
+    std::unique_ptr<JPostProcessor> Downsampler; ///< Box-filters the input of reduced-resolution segments.
+    std::unique_ptr<JPostProcessor> Upsampler;   ///< Brings reduced-resolution segments back up.
+    std::unique_ptr<JPostProcessor> Upscaler;    ///< Scales a chain smaller than the screen up to it.
+
+    /// Declare the compiled chain from an imported input texture, then run the graph.
+    void RunGraph(uint32_t input, int screenWidth, int screenHeight, JJobSystem* jobs);
+
+    /// Description of an intermediate texture at 1/divisor of the chain's resolution.
+    FRGTextureDesc GetReducedDesc(int divisor) const;
+
+    /// Declare a box-filtered downsample of input to 1/divisor resolution, returns the new texture.
+    uint32_t AddDownsamplePass(uint32_t input, int divisor);
+
+    /// Declare the edge-aware upsample of a reduced-resolution result, guided by the segment's input.
+    void AddUpsamplePass(uint32_t input, uint32_t guideLow, uint32_t guideFull, uint32_t output);
+
+    /// Split the processors into passes, fusing runs of fusable effects.
+    void CompileChain();
+
+    /// Generate and build the uber-shader of a run of fusable effects.
+    static FChainPass FuseEffects(const std::vector<JPostProcessor*>& effects);
+
+    /// Push the uniform values of the effects set since the last call into a fused pass' program.
+    static void MirrorUniforms(FChainPass& pass);
 
-    std::unique_ptr<JFramebufferTarget> Ping; ///< Ping-pong render target A.
-    std::unique_ptr<JFramebufferTarget>  Pong; ///< Ping-pong render target B.
+    /// Re-bake a LUT stage if its effects' parameters changed, then bind it for a pass.
+    static void UpdateColorStage(FColorLUTStage& stage, JPostProcessor& pass, JJobSystem* jobs);
 };
\ No newline at end of file
@@ -129,6 +129,26 @@ public:
      */
     bool RemoveActor(unsigned int id);
 
+    /**
+     * @brief Notify the active scene that an actor's transform or model changed.
+     *
+     * Keeps the scene's spatial tree in sync. Call after writing Position, Rotation,
+     * Scale or Model directly; SetActorTransform() does it automatically.
+     *
+     * @param actor The actor that moved
+     */
+    void NotifyActorMoved(JActor* actor);
+
+    /**
+     * @brief Set an actor's transform and update the spatial tree.
+     * @param actor Actor to move
+     * @param position New world position
+     * @param rotation New rotation (Euler angles, degrees)
+     * @param scale New scale
+     * @return true if the actor belongs to the active scene, false otherwise
+     */
+    bool SetActorTransform(JActor* actor, const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale);
+
     /**
      * @brief Update all actors in the active scene.
      * @param deltaTime Time since last frame
@@ -188,6 +208,23 @@ public:
      */
     bool SaveSceneFile(const JScene* scene, const std::string& filename) const;
 
+    /**
+     * @brief Builds a scene from JSON already in memory and makes it the active scene.
+     *
+     * LoadSceneFile() without the file access, e.g. for scenes received over the network.
+     *
+     * @param data JSON in the scene file format.
+     * @return Pointer to the loaded scene.
+     */
+    JScene* LoadSceneJson(const nlohmann::json& data);
+
+    /**
+     * @brief Serializes a scene to JSON without writing it, reusing the scene's cache while it is clean.
+     * @param scene Scene to serialize.
+     * @return The scene in the scene file format, without metadata. Null JSON if scene is null.
+     */
+    nlohmann::json SerializeScene(const JScene* scene) const;
+
     /**
      * @brief Reads metadata from a scene file without fully loading the scene.
      *
@@ -239,4 +276,7 @@ public:
 
     /** Callback invoked whenever an actor is removed from the active scene. */
     std::function<void(unsigned int ID)> OnActorRemoved;
+
+    /** Callback invoked whenever an actor of the active scene is moved. */
+    std::function<void(JActor*)> OnActorMoved;
 };
\ No newline at end of file
@@ -1,9 +1,31 @@
 //  Copyright 2025 JesseTheCatLover. All Rights Reserved.
 
 #pragma once
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
+class JDynamicResolution;
 class JFramebufferTarget;
+class JGpuProfiler;
+class JRenderTargetPool;
+class JOcclusionQueries;
+class JOutlineRenderer;
+class JPostProcessor;
+
+/// How transparent geometry is composited.
+enum class ETransparencyMode : uint8_t
+{
+    Sorted,         ///< Drawn back to front straight into the scene target (see JTransparentSorter)
+    WeightedBlended ///< Order-independent: accumulated in any order, then composited in one pass
+};
+
+/// How actors with S_JActorRenderConfig::bDrawOutline get their outline.
+enum class EOutlineMode : uint8_t
+{
+    Geometry, ///< Inflated back faces drawn by JActor::DrawConfig (three geometry passes), the default
+    JumpFlood ///< Stencil-tagged once, outline built in screen space (see JOutlineRenderer)
+};
 
 /**
  * @class JRenderer
@@ -13,16 +35,46 @@ class JFramebufferTarget;
  * It handles multisampling, depth testing, and viewport setup.
  *
  * Post-processing effects should be applied separately using a PostProcessManager
- * or similar system by using the texture provided via GetSceneTargetTexture().
+ * or similar system by using the texture provided via ResolveSceneTexture().
  *
  * Usage pattern:
  * 1. Call BeginScene() before drawing your scene.
  * 2. Render all scene objects.
  * 3. Call EndScene() to finalize the framebuffer and resolve multisampling.
- * 4. Retrieve the final scene texture via GetSceneTargetTexture() for post-processing or presentation.
+ * 4. Retrieve the final scene texture via ResolveSceneTexture() for post-processing or presentation.
+ *
+ * Transparent geometry is drawn between BeginTransparency() and EndTransparency(). In
+ * ETransparencyMode::WeightedBlended the pass renders into an accumulation target (RGBA16F
+ * premultiplied color sum plus revealage in alpha) and a weight target (R16F), depth-tested
+ * against the opaque scene, and EndTransparency() composites the average over the scene target.
+ * Draw order does not matter there, so transparent actors can be batched like opaque ones.
+ *
+ * In EOutlineMode::JumpFlood, EndScene() draws the screen-space outlines of every actor marked
+ * through GetOutlineRenderer() before resolving.
+ *
+ * Once GetDynamicResolution() is enabled (it is off by default), the scene renders at an internal
+ * resolution scaled below the screen size when the scene pass goes over its GPU time budget. All
+ * scene targets follow the render size (GetRenderWidth() / GetRenderHeight()), PostProcessManager
+ * upscales to the screen.
+ *
+ * Scene targets come from a JRenderTargetPool (GetTargetPool()) that PostProcessManager's render
+ * graph can share. Resize() only records the new screen size: the targets follow once no other
+ * resize arrived for ResizeDebounceSeconds, so dragging a window allocates the final size only.
+ * Until then the scene renders at the previous size and PostProcessManager stretches it.
+ *
+ * GPU time is measured by a JGpuProfiler (GetGpuProfiler()) whose frames BeginScene() advances:
+ * the scene pass ("Scene", with "Transparency" and "Outlines" nested) and the resolve of
+ * ResolveSceneTexture() are timed here, PostProcessManager adds its passes when given the
+ * same profiler.
+ *
+ * The renderer also owns the GPU occlusion queries (see JOcclusionQueries): BeginScene() collects
+ * the results that arrived since the previous frame and EndScene() retires unused queries.
  */
 class JRenderer {
 public:
+    /// Quiet time after the last Resize() before the scene targets are reallocated.
+    static constexpr double ResizeDebounceSeconds = 0.15;
+
     /**
      * @brief Construct a new scene renderer.
      *
@@ -32,12 +84,14 @@ public:
      *        Use 1 for no multisampling.
      */
     JRenderer(int screenWidth, int screenHeight, int samples = 4);
+    ~JRenderer();
 
     /**
      * @brief Begin rendering a new frame/scene.
      *
-     * This binds the internal scene framebuffer, clears its color, depth, and stencil buffers,
-     * and sets the viewport to match the framebuffer size.
+     * This applies the dynamic resolution scale (resizing the scene targets if it changed),
+     * binds the internal scene framebuffer, clears its color, depth, and stencil buffers,
+     * and sets the viewport to the render size.
      * Call this before drawing any scene objects.
      */
     void BeginScene();
@@ -45,16 +99,41 @@ public:
     /**
      * @brief End scene rendering.
      *
-     * Unbinds the scene framebuffer and resolves the multi-sampled scene
-     * into a single-sample texture if multisampling is enabled.
+     * Unbinds the scene framebuffer. The multi-sampled scene is resolved on demand: by
+     * ResolveSceneTexture(), or by a JRenderGraph reading GetSceneTarget() into a pooled target.
      * Call this after all scene objects have been drawn.
      */
     void EndScene();
 
     /**
-     * @brief Resize the scene framebuffer and resolved target.
+     * @brief Start the transparent pass, after all opaque geometry.
+     *
+     * In WeightedBlended mode this copies the scene depth into the OIT target, clears the
+     * accumulation buffers and sets up additive blending with depth writes off.
+     * In Sorted mode nothing changes and the caller draws back to front into the scene.
+     */
+    void BeginTransparency();
+
+    /**
+     * @brief Finish the transparent pass. In WeightedBlended mode, composites the accumulated
+     *        transparency over the scene target and restores the default blend state.
+     */
+    void EndTransparency();
+
+    inline void SetTransparencyMode(ETransparencyMode mode) { TransparencyMode = mode; }
+    inline ETransparencyMode GetTransparencyMode() const { return TransparencyMode; }
+
+    inline void SetOutlineMode(EOutlineMode mode) { OutlineMode = mode; }
+    inline EOutlineMode GetOutlineMode() const { return OutlineMode; }
+
+    /** @brief Screen-space outline pass, used to mark outlined actors in JumpFlood mode. */
+    JOutlineRenderer& GetOutlineRenderer() { return *Outlines; }
+
+    /**
+     * @brief Request a new screen size, the scene targets follow at the current render scale.
      *
      * Must be called whenever the screen or window size changes to maintain correct resolution.
+     * Cheap: the targets are reallocated by a later BeginScene(), once resizing has settled.
      *
      * @param newWidth New framebuffer width in pixels.
      * @param newHeight New framebuffer height in pixels.
@@ -62,21 +141,70 @@ public:
     void Resize(int newWidth, int newHeight);
 
     /**
-     * @brief Get the final scene texture ID.
+     * @brief Resolve the scene of this frame and get its texture ID.
      *
      * This texture can be used for post-processing effects, UI overlays, or direct
-     * rendering to the screen.
+     * rendering to the screen. With multisampling the first call after EndScene() acquires a
+     * pooled target and resolves into it, later calls in the same frame reuse it.
      *
      * @return OpenGL texture ID of the resolved scene. If multisampling is enabled,
      *         the resolved single-sample texture is returned. Otherwise, the scene texture itself.
      */
-    unsigned int GetSceneTargetTexture() const;
+    unsigned int ResolveSceneTexture();
+
+    /**
+     * @brief The scene target itself, possibly multi-sampled.
+     *
+     * Import it into a JRenderGraph to let the graph resolve it into pooled memory, so the
+     * renderer never has to keep a full-resolution resolve target alive.
+     */
+    JFramebufferTarget& GetSceneTarget() { return *SceneTarget; }
+
+    /// Size the scene is rendered at, the screen size times the dynamic resolution scale.
+    inline int GetRenderWidth() const { return RenderWidth; }
+    inline int GetRenderHeight() const { return RenderHeight; }
+
+    /** @brief Pool the scene targets come from, advanced once per frame by BeginScene(). */
+    JRenderTargetPool& GetTargetPool() { return *TargetPool; }
+
+    /** @brief Controller of the render scale, timing the scene pass. */
+    JDynamicResolution& GetDynamicResolution() { return *DynamicResolution; }
+
+    /** @brief Timer of the scene and post-process passes, see PostProcessManager::SetGpuProfiler(). */
+    JGpuProfiler& GetGpuProfiler() { return *GpuProfiler; }
+
+    /** @brief Hardware occlusion queries of the scene pass. */
+    JOcclusionQueries& GetOcclusionQueries() { return *OcclusionQueries; }
 
 private:
     int ScreenWidth;  ///< Current width of the framebuffer in pixels
     int ScreenHeight; ///< Current height of the framebuffer in pixels
     int Samples;      ///< Number of samples per pixel for multisampling
+    int RenderWidth;  ///< Size of the scene targets, see JDynamicResolution
+    int RenderHeight;
+
+    int PendingWidth;  ///< Last size passed to Resize(), applied once settled
+    int PendingHeight;
+    std::chrono::steady_clock::time_point ResizeRequestTime;
+
+    std::unique_ptr<JRenderTargetPool> TargetPool;     ///< Owns every scene target below
+    JFramebufferTarget* SceneTarget = nullptr;         ///< Main render target (may be multi-sampled)
+    JFramebufferTarget* ResolveTarget = nullptr;       ///< Acquired by the first ResolveSceneTexture() with MSAA
+    bool bResolved = false;                            ///< ResolveTarget holds this frame's scene
+    std::unique_ptr<JOcclusionQueries> OcclusionQueries; ///< Bounding-box occlusion queries, read one frame late
+    std::unique_ptr<JDynamicResolution> DynamicResolution; ///< Times the scene pass, picks the render size
+    std::unique_ptr<JGpuProfiler> GpuProfiler;             ///< Per-pass GPU timings, frames advanced by BeginScene()
+
+    ETransparencyMode TransparencyMode = ETransparencyMode::Sorted;
+    JFramebufferTarget* TransparencyTarget = nullptr;       ///< OIT accumulation (0) and weight (1) targets
+    std::unique_ptr<JPostProcessor> CompositePass;          ///< Resolves the OIT targets over the scene
+
+    EOutlineMode OutlineMode = EOutlineMode::Geometry;
+    std::unique_ptr<JOutlineRenderer> Outlines;
+
+    /// Move every scene target to a pooled one of the render size.
+    void ResizeTargets();
 
-    std::unique_ptr<JFramebufferTarget> SceneTarget;   ///< Main render target (may be multi-sampled)
-    std::unique_ptr<JFramebufferTarget> ResolveTarget; ///< Single-sample resolved target for post-processing
+    /// Hand target back to the pool and take one of the render size with the same formats.
+    void ReacquireTarget(JFramebufferTarget*& target);
 };
@@ -6,3 +6,22 @@
 #include "../../Private/Rendering/JModel.h"
 #include "../../Private/Rendering/JPostProcessor.h"
 #include "../../Private/Rendering/JSkybox.h"
+#include "../../Private/Rendering/JInstanceBatcher.h"
+#include "../../Private/Rendering/JGeometryPool.h"
+#include "../../Private/Rendering/JGLCapabilities.h"
+#include "../../Private/Rendering/JDrawSubmitter.h"
+#include "../../Private/Rendering/JFrustumCuller.h"
+#include "../../Private/Rendering/JSoftwareOcclusion.h"
+#include "../../Private/Rendering/JOcclusionQueries.h"
+#include "../../Private/Rendering/JTransparentSorter.h"
+#include "../../Private/Rendering/JOutlineRenderer.h"
+#include "../../Private/Rendering/JClusteredLighting.h"
+#include "../../Private/Rendering/JCascadedShadows.h"
+#include "../../Private/Rendering/JColorLUT.h"
+#include "../../Private/Rendering/JRenderGraph.h"
+#include "../../Private/Rendering/JBlurProcessor.h"
+#include "../../Private/Rendering/JDynamicResolution.h"
+#include "../../Private/Rendering/JRenderTargetPool.h"
+#include "../../Private/Rendering/JFrameCapture.h"
+#include "../../Private/Rendering/JGpuProfiler.h"
+#include "../../Private/Rendering/JRenderStats.h"
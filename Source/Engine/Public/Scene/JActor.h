@@ -1,10 +1,12 @@
 // Copyright 2025 JesseTheCatLover. All Rights Reserved.
 
 #pragma once
+#include <cstdint>
 #include <string>
 
 #include "glm/fwd.hpp"
 #include "glm/vec3.hpp"
+#include "../../Private/Core/Math/FAABB.h"
 
 class JShader;
 class JModel;
@@ -14,7 +16,12 @@ public:
     std::string Name;
     unsigned int ID;
     size_t m_VectorIndex;
+    int32_t m_ProxyID = -1; // Leaf in the owning scene's spatial tree, -1 when not in a scene
+    // Process-unique, kept by the copies a growing actor vector makes, unlike the actor's address.
+    // Keys per-actor renderer caches (culling bounds, occlusion queries)
+    uint64_t m_InstanceID = NextInstanceID();
     JModel *Model;
+    JModel *OccluderModel = nullptr; // Simplified geometry for software occlusion, Model is used if null
     glm::vec3 Position;
     glm::vec3 Rotation;
     glm::vec3 Scale;
@@ -25,11 +32,14 @@ public:
         float OutlineThickness = 0.03f;  // how thick the outline should be
         bool bWireframe = false;         // optional: wireframe mode
         bool bBackCulling = false;       // whether to cull back faces
+        bool bIsOccluder = false;        // rasterized into the software occlusion buffer
+        bool bIsStatic = false;          // never moves, cached in the far shadow cascades
+        bool bCastShadows = true;        // drawn into the shadow cascades
     };
 
     S_JActorRenderConfig Config;
 
-    JActor() : ID(0), m_VectorIndex(0) {}
+    JActor() : ID(0), m_VectorIndex(0), Model(nullptr), Position(0.f), Rotation(0.f), Scale(1.f) {}
     virtual ~JActor() = default;
 
     JActor(JModel *model, std::string name,glm::vec3 position, glm::vec3 rotation, glm::vec3 scale)
@@ -40,7 +50,15 @@ public:
         : Model(model), Name(name), Scale(glm::vec3(1.f)) {}
 
     glm::mat4 GetModelMatrix() const;
+    // World-space bounds of the model, or a point at Position for actors without one
+    FAABB GetWorldBounds() const;
 
     void Draw(JShader& shader) const;
-    void DrawConfig(JShader& shader, JShader& outlineShader) const;
+    // bGeometryOutline = false skips the outline passes, for outlines drawn in screen space
+    void DrawConfig(JShader& shader, JShader& outlineShader, bool bGeometryOutline = true) const;
+    // Draw a single mesh of the model with the actor's culling config (no outline)
+    void DrawMesh(JShader& shader, size_t meshIndex) const;
+
+private:
+    static uint64_t NextInstanceID();
 };
@@ -0,0 +1,64 @@
+// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "JActor.h"
+#include "glm/geometric.hpp"
+
+enum class ELightType : uint8_t
+{
+    Point,
+    Spot
+};
+
+/**
+ * @class JLightActor
+ * @brief A dynamic point or spot light placed in the scene.
+ *
+ * Lights have no model. Their influence ends at Range (the attenuation window reaches zero
+ * there), which is what lets JClusteredLighting assign them to a bounded set of clusters.
+ * Spot cone angles are stored as cosines, like the shaders consume them.
+ */
+class JLightActor : public JActor {
+public:
+    ELightType Type = ELightType::Point;
+    glm::vec3 Color = glm::vec3(1.f);
+    float Intensity = 1.f;
+    float Range = 10.f;                            // distance where the light's contribution reaches zero
+    glm::vec3 Direction = glm::vec3(0.f, -1.f, 0.f); // spot lights only
+    float InnerCutOff = 0.976f;                    // cos(12.5 deg), full intensity inside
+    float OuterCutOff = 0.953f;                    // cos(17.5 deg), zero outside
+
+    JLightActor() : JActor(nullptr, "Light") {}
+    JLightActor(std::string name, glm::vec3 position, glm::vec3 color = glm::vec3(1.f), float range = 10.f)
+        : JActor(nullptr, std::move(name), position), Color(color), Range(range) {}
+
+    /// Bounding sphere of the lit volume (the whole sphere for points, the cone for spots).
+    inline void GetBoundingSphere(glm::vec3& outCenter, float& outRadius) const
+    {
+        if (Type == ELightType::Point)
+        {
+            outCenter = Position;
+            outRadius = Range;
+            return;
+        }
+
+        // Tightest sphere around a cone of length Range (wide cones: the cap circle, narrow: apex too)
+        const glm::vec3 direction = glm::normalize(Direction);
+        const float cosAngle = OuterCutOff;
+        if (cosAngle < 0.70710678f)
+        {
+            outCenter = Position + direction * (Range * cosAngle);
+            outRadius = Range * std::sqrt(std::max(0.f, 1.f - cosAngle * cosAngle));
+        }
+        else
+        {
+            const float radius = Range / (2.f * cosAngle);
+            outCenter = Position + direction * radius;
+            outRadius = radius;
+        }
+    }
+};
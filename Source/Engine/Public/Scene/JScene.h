@@ -5,9 +5,13 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <glm/vec3.hpp>
 #include <nlohmann/json.hpp>
 
 class JActor;
+class JDynamicAABBTree;
+struct FAABB;
+struct FFrustum;
 
 /**
  * @class JScene
@@ -20,6 +24,11 @@ class JActor;
  * Scenes also provide events for actor creation and removal, allowing
  * editor tools or gameplay systems to react dynamically.
  *
+ * Every actor is also a leaf of a dynamic AABB tree (JDynamicAABBTree) over its world
+ * bounds, so spatial queries (frustum, box, sphere, ray) only visit nearby actors instead
+ * of scanning the whole list. The tree is kept in sync on add/remove, and on moves
+ * reported through SceneManager::NotifyActorMoved() / SetActorTransform().
+ *
  * @note This class is read-only. To modify a scene, use SceneManager.h exclusively.
  */
 class JScene
@@ -31,6 +40,7 @@ private:
     std::vector<std::unique_ptr<JActor>> m_Actors; ///< Storage of all actors in the scene.
     unsigned int m_NextActorID; ///< Auto-incremented ID counter for uniquely identifying actors.
     std::unordered_map<unsigned int, JActor*> m_ActorsByID; ///< Fast lookup map from ID → actor.
+    std::unique_ptr<JDynamicAABBTree> m_SpatialTree; ///< BVH over actor world bounds.
 
     mutable nlohmann::json m_CachedJson; ///< Cached serialization of the scene.
     mutable bool m_bIsDirty = true; ///< track if cache needs rebuilding
@@ -64,6 +74,12 @@ private:
      */
     void AddActorToList(std::unique_ptr<JActor> actor);
 
+    /**
+     * @brief Refreshes an actor's leaf in the spatial tree after its transform or model changed.
+     * @param actor The moved actor (must belong to this scene).
+     */
+    void UpdateActorBounds(JActor* actor);
+
     /**
      * @brief Construct a new JScene with the given name.
      * @param name The name of the scene.
@@ -113,6 +129,7 @@ private:
     bool RemoveActor(unsigned int id);
 
 public:
+    ~JScene();
 
     /** @return The scene’s name. */
     inline const std::string& GetName() const { return m_Name;}
@@ -147,6 +164,46 @@ public:
         return static_cast<T *>(it->second); // assume you know the type
     }
 
+    // -------------------- Spatial Queries --------------------
+    // Queries test the tree's fat bounds, so results are conservative: actors may lie up to
+    // a small margin outside the query volume, but no overlapping actor is ever missed.
+
+    /**
+     * @brief Collects the actors whose bounds intersect a view frustum.
+     * @param frustum Frustum planes (e.g. FFrustum::FromMatrix(projection * view)).
+     * @param outActors Receives the matching actors (appended).
+     */
+    void QueryActorsInFrustum(const FFrustum& frustum, std::vector<JActor*>& outActors) const;
+
+    /**
+     * @brief Collects the actors whose bounds overlap a box.
+     * @param box World-space box.
+     * @param outActors Receives the matching actors (appended).
+     */
+    void QueryActorsInBox(const FAABB& box, std::vector<JActor*>& outActors) const;
+
+    /**
+     * @brief Collects the actors whose bounds overlap a sphere.
+     * @param center Sphere center in world space.
+     * @param radius Sphere radius.
+     * @param outActors Receives the matching actors (appended).
+     */
+    void QueryActorsInSphere(const glm::vec3& center, float radius, std::vector<JActor*>& outActors) const;
+
+    /**
+     * @brief Finds the nearest actor whose world bounds are hit by a ray.
+     * @param origin Ray origin.
+     * @param direction Normalized ray direction.
+     * @param maxDistance Length of the ray.
+     * @param outDistance Optional, receives the distance to the hit.
+     * @return The nearest hit actor, or nullptr if nothing was hit.
+     */
+    JActor* RayCastActors(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                          float* outDistance = nullptr) const;
+
+    /** @return The scene's spatial tree, for custom traversals. User data of each proxy is its JActor*. */
+    inline const JDynamicAABBTree& GetSpatialTree() const { return *m_SpatialTree; }
+
     /**
      * @brief Finds the first actor of type T in the scene.
      * @tparam T Must be derived from JActor.